@@ -24,6 +24,12 @@ namespace Config
         constexpr int CONNECTION_TIMEOUT_MS = 30000;  // 30 seconds
         constexpr int REQUEST_TIMEOUT_MS = 15000;     // 15 seconds
         constexpr int MAX_RETRIES = 3;
+
+        // Ask the server for length-prefixed binary frames on connect (HELLO)
+        constexpr bool USE_BINARY_FRAMING = true;
+        constexpr int MAX_FRAME_BYTES = 64 * 1024 * 1024; // Largest response frame accepted, also after inflating
+        // Ask for zstd on large binary responses, primed with the shared offer dictionary
+        constexpr bool USE_COMPRESSION = true;
     }
 
     // UI Configuration
@@ -46,6 +52,9 @@ namespace Config
         constexpr int DESTINATIONS_CACHE_HOURS = 24;
         constexpr int OFFERS_CACHE_MINUTES = 30;
         constexpr int MAX_CACHE_SIZE_MB = 50;
+        constexpr int IMAGE_MEMORY_CACHE_MB = 64;   // Scaled pixmaps kept for cards, least recently used go first
+        constexpr bool USE_THUMBNAIL_DISK_CACHE = true; // Pre-scaled copies, skips decoding the originals again
+        constexpr int OFFLINE_OFFERS_MAX_AGE_HOURS = 24; // Older offer files are not shown at startup
     }
 
     // Validation Configuration
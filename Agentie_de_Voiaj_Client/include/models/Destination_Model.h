@@ -57,6 +57,7 @@ signals:
 
 private slots:
     void on_destinations_received(const QJsonArray& destinations);
+    void on_destinations_catalog_received(qint64 version, const QJsonObject& catalog);
     void on_network_error(const QString& error_message);
 
 private:
@@ -68,4 +69,5 @@ private:
     QVector<Destination> m_destinations;
     std::unique_ptr<QTimer> m_refresh_timer;
     bool m_is_loading = false;
+    qint64 m_catalog_version = 0; // Server version of m_destinations, 0 when unknown
 };
\ No newline at end of file
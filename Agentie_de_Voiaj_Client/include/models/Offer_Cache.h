@@ -0,0 +1,56 @@
+#pragma once
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include "models/Offer_Model.h"
+
+// Offline copy of the offer list in one binary file, read through a memory map:
+//   header   magic | version | record size | saved at (ms) | count | string table offset | catalog version
+//   records  fixed width, numbers inline and (offset, length) refs into the string table
+//   strings  UTF-8, no separators
+// Opening only checks the header, rows are decoded one at a time when asked for.
+// All numbers are little-endian.
+class Offer_Cache
+{
+public:
+    explicit Offer_Cache(const QString& file_path = default_path());
+    ~Offer_Cache();
+
+    // Maps the file; false when it is missing, damaged, from another version or older than max_age_ms
+    bool open(qint64 max_age_ms);
+    void close(); // Drops the mapping, decoded rows stay valid
+    bool is_open() const { return m_data != nullptr; }
+
+    int record_count() const { return m_record_count; }
+    qint64 catalog_version() const { return m_catalog_version; } // Server's version of these rows, 0 when unknown
+    int record_id(int index) const; // Without touching the strings
+    Offer_Model::Offer read(int index) const;
+
+    // Replaces the file, closing the mapping first
+    bool write_all(const QVector<Offer_Model::Offer>& offers, qint64 catalog_version);
+    // The server confirmed the rows are current: saved-at and catalog version are rewritten in place
+    bool touch(qint64 catalog_version);
+    // In place: the seats are overwritten, a changed status is appended to the string table
+    bool update_record(int index, const Offer_Model::Offer& before, const Offer_Model::Offer& after);
+
+    const QString& file_path() const { return m_file_path; }
+    static QString default_path();
+
+    static constexpr quint32 MAGIC = 0x434F5641; // "AVOC"
+    static constexpr quint16 VERSION = 2;
+    static constexpr int HEADER_SIZE = 40;
+    static constexpr int RECORD_SIZE = 96;
+
+private:
+    const uchar* record(int index) const;
+    QString read_string(const uchar* ref) const;
+
+    QString m_file_path;
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    int m_record_count = 0;
+    qint64 m_string_table_offset = 0;
+    qint64 m_catalog_version = 0;
+};
@@ -5,8 +5,12 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QSettings>
+#include <QHash>
+#include <QTimer>
+#include <memory>
 
 class Api_Client;
+class Offer_Cache;
 
 class Offer_Model : public QAbstractListModel
 {
@@ -89,6 +93,8 @@ signals:
 
 private slots:
     void on_offers_received(const QJsonArray& offers);
+    void on_offers_catalog_received(qint64 version, const QJsonObject& catalog);
+    void on_offer_updates_received(const QJsonArray& updates);
     void on_booking_success(const QString& message);
     void on_booking_failed(const QString& error_message);
     void on_cancellation_success(const QString& message);
@@ -100,10 +106,23 @@ private:
     Offer offer_from_json(const QJsonObject& jsonObj) const;
     void set_loading(bool loading);
     void set_error(const QString& error);
+    void replace_offers(const QJsonArray& offers);
+    void apply_offer_changes(const QJsonArray& changed, const QJsonArray& removed);
     void load_cached_offers();
     void save_cached_offers();
+    void rebuild_row_index();
+    const Offer& decoded_row(int row) const;
+    void decode_all_rows() const;
 
-    QVector<Offer> m_offers;
+    // Rows restored from the cache file hold only their id until first read
+    mutable QVector<Offer> m_offers;
+    mutable QVector<bool> m_is_row_decoded;
+    mutable int m_undecoded_rows = 0;
+    std::unique_ptr<Offer_Cache> m_cache;
+    qint64 m_catalog_version = 0; // Server catalog version of m_offers, 0 for search results or none
+    QTimer* m_refresh_timer = nullptr;
+    QHash<int, int> m_row_by_id; // Offer id -> row, rebuilt whenever the rows are replaced
+    bool m_is_subscribed = false;
     bool m_is_loading = false;
     QString m_last_error;
     QSettings* m_settings = nullptr;
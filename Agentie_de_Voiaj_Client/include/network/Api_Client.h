@@ -5,9 +5,13 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QMutex>
+#include <QList>
+#include <QMap>
 #include <memory>
-#include <optional>
+
+class Payload_Decompressor;
 
 class Api_Client : public QObject
 {
@@ -25,7 +29,9 @@ public:
         Get_User_Reservations,
         Cancel_Reservation,
         Get_User_Info,
-        Update_User_Info
+        Update_User_Info,
+        Subscribe_Offers,
+        Resume_Session
     };
 
     struct Api_Response
@@ -41,6 +47,7 @@ public:
     static void shutdown();
 
     void set_server_url(const QString& host, int port);
+    // Session token from the login reply; every new connection sends it before queued requests
     void set_auth_token(const QString& token);
     void set_timeout(int timeout_ms);
 
@@ -52,9 +59,13 @@ public:
     void register_user(const QJsonObject& user_data);
     void logout();
 
-    void get_destinations();
-    void get_offers();
+    // known_version is the catalog version of the rows already held, 0 for none;
+    // the reply comes through the *_catalog_received signals
+    void get_destinations(qint64 known_version = 0);
+    void get_offers(qint64 known_version = 0);
     void search_offers(const QJsonObject& search_params);
+    // Seat changes arrive through offer_updates_received, renewed on every reconnect
+    void subscribe_offer_updates();
 
     void get_user_info();
     void update_user_info(const QJsonObject& user_data);
@@ -76,9 +87,15 @@ signals:
     void register_success();
     void register_failed(const QString& error_message);
     void logged_out();
+    void session_resumed(const QJsonObject& user_data);
+    void session_expired(); // The server forgot the token, a new login is needed
 
     void destinations_received(const QJsonArray& destinations);
-    void offers_received(const QJsonArray& offers);
+    void offers_received(const QJsonArray& offers); // SEARCH_OFFERS, and GET_OFFERS from servers without versions
+    // {"not_modified":true}, {"changed":[..],"removed":[ids]} (offers only) or the full list under "offers"/"destinations"
+    void destinations_catalog_received(qint64 version, const QJsonObject& catalog);
+    void offers_catalog_received(qint64 version, const QJsonObject& catalog);
+    void offer_updates_received(const QJsonArray& updates); // [{offer_id, available_seats, status}]
     void user_info_received(const QJsonObject& user_info);
     void reservations_received(const QJsonArray& reservations);
 
@@ -103,18 +120,31 @@ private:
 
     void connect_to_server();
     void disconnect_from_server();
-    void send_json_message(const QJsonObject& message);
+    bool send_json_message(const QJsonObject& message, quint32 request_id = 0);
+    void send_hello();
+    void handle_hello_response(const QJsonObject& response);
+    void send_queued_requests();
+    void send_offer_subscription();
+    bool send_session_resume();
+    void finish_session_resume(bool is_resumed, const Api_Response& response);
+    bool take_next_message(QByteArray& message, quint32& request_id);
     void send_request(Request_Type type, const QJsonObject& data);
-    void handle_response(const QJsonObject& response);
+    void dispatch_request(Request_Type type, const QJsonObject& data);
+    void handle_response(const QJsonObject& response, quint32 request_id);
+    void arm_request_timer();
     
     Api_Response parse_json_response(const QJsonObject& json_response) const;
-    void process_authentication_response(const Api_Response& response);
+    void process_authentication_response(Request_Type type, const Api_Response& response);
     void process_data_response(Request_Type type, const Api_Response& response);
 
     void handle_socket_error(QAbstractSocket::SocketError error);
     void emit_error(const QString& error_message);
+    void emit_request_failed(Request_Type type, const QString& error_message);
+    void fail_request(Request_Type type, const QString& error_message);
+    void fail_in_flight_requests(const QString& error_message, bool include_queued);
 
     QString request_type_to_string(Request_Type type) const;
+    static quint16 wire_type_for(const QString& type);
     bool is_authentication_required(Request_Type type) const;
 
     // Constants
@@ -135,19 +165,54 @@ private:
 
     bool m_is_connected;
     QString m_last_error;
-    Request_Type m_current_request_type;
     QByteArray m_receive_buffer;
+
+    // Framing - text lines until the server accepts binary frames in its HELLO reply.
+    // Binary frames: u32 length | u16 type | u16 flags | u32 request id, big-endian.
+    enum class Framing_Mode
+    {
+        Text_Lines,
+        Binary
+    };
+    Framing_Mode m_framing;
+    bool m_is_hello_pending;
+    // Set when HELLO settled on compression; frames flagged FRAME_FLAG_COMPRESSED go through it
+    std::unique_ptr<Payload_Decompressor> m_decompressor;
+    quint32 m_next_request_id;
     
-    // Store pending request when not connected
-    struct Pending_Request {
+    // Requests are pipelined: each carries a request id that the server echoes, so several
+    // can be outstanding on the socket and their responses may come back in any order.
+    // Until connected (and the framing settled) they wait in m_queued_requests.
+    struct Queued_Request
+    {
         Request_Type type;
         QJsonObject data;
     };
-    std::optional<Pending_Request> m_pending_request;
+    struct In_Flight_Request
+    {
+        Request_Type type;
+        qint64 deadline_ms; // On m_clock
+    };
+    QList<Queued_Request> m_queued_requests;
+    QMap<quint32, In_Flight_Request> m_in_flight;
+    QElapsedTimer m_clock;
+
+    // The server keeps the subscription per connection
+    bool m_wants_offer_updates;
+    bool m_is_offer_subscription_sent;
+
+    // A new connection is anonymous until RESUME_SESSION is answered. The server may run
+    // requests of one connection out of order, so the queue is held back until then.
+    bool m_is_session_resume_pending;
+    bool m_is_session_bound;
+    qint64 m_connected_at_ms; // On m_clock, for the reconnect-to-ready time
 
     	static constexpr int DEFAULT_TIMEOUT_MS = 15000; // 15 seconds - matches config.h
     static constexpr int DEFAULT_PORT = 8080;
-    static constexpr int MAX_BUFFER_SIZE = 1024 * 1024; // 1MB limit
+    static constexpr int MAX_BUFFER_SIZE = 1024 * 1024; // 1MB limit for text lines
+    static constexpr int FRAME_HEADER_SIZE = 12;
+    static constexpr quint16 FRAME_FLAG_COMPRESSED = 0x0004;
+    static constexpr int MAX_QUEUED_REQUESTS = 64;
 };
 
 Q_DECLARE_METATYPE(Api_Client::Request_Type)
@@ -0,0 +1,26 @@
+#pragma once
+#include <QByteArray>
+
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
+
+// Inflates binary frames the server sent with the compressed flag (zstd, negotiated in HELLO).
+// The dictionary is common/include/Offer_Dictionary.h, the server's too; DICTIONARY_NAME is its content hash.
+class Payload_Decompressor
+{
+public:
+    explicit Payload_Decompressor(bool use_dictionary);
+    ~Payload_Decompressor();
+
+    Payload_Decompressor(const Payload_Decompressor&) = delete;
+    Payload_Decompressor& operator=(const Payload_Decompressor&) = delete;
+
+    // False on damaged input or when the content would exceed max_bytes
+    bool decompress(const char* data, qsizetype size, qsizetype max_bytes, QByteArray& out);
+
+    static const char* const DICTIONARY_NAME;
+
+private:
+    ZSTD_DCtx_s* m_context;
+    ZSTD_DDict_s* m_dictionary; // Null without one
+};
@@ -42,12 +42,14 @@ protected:
 private slots:
     void on_view_offers_clicked();
     void on_favourite_clicked();
+    void on_image_ready(const QString& path, const QSize& size);
 
 private:
     void setup_ui();
     void setup_animations();
     void update_content();
-    void load_destination_image();
+    void load_destination_image(); // Placeholder now, the picture when Image_Cache has it
+    bool apply_image(const QPixmap& pixmap);
 
     void animate_hover_enter();
     void animate_hover_leave();
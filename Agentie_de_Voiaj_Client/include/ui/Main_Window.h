@@ -7,6 +7,8 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QScrollArea>
+#include <QListView>
+#include <QElapsedTimer>
 #include <QMenuBar>
 #include <QStatusBar>
 #include <QProgressBar>
@@ -34,6 +36,9 @@ public:
     Main_Window(QWidget *parent = nullptr);
     ~Main_Window();
 
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
 private slots:
     void on_login_action();
     void on_logout_action();
@@ -51,6 +56,7 @@ private slots:
 
     void on_destinations_loaded();
     void on_offers_loaded();
+    void on_offer_book_clicked(int offer_id);
     void on_reservations_loaded();
     void on_user_info_updated();
 
@@ -76,17 +82,19 @@ private:
     // UI refresh methods
     void refresh_offers_display();
     void refresh_reservations_display();
+    void refresh_destinations_display();
     
-    // Card creation methods
-    QWidget* create_offer_card(const int offer_index);
+    // Card creation methods; offers are painted by Offer_Delegate instead
     QWidget* create_reservation_card(const int reservation_index);
-    QWidget* create_offer_card(const Offer_Model::Offer& offer);
     QWidget* create_reservation_card(const Reservation_Model::Reservation& reservation);
 
     QWidget* m_central_widget;
     QTabWidget* m_tab_widget;
 
     QWidget* m_destinations_tab;
+    QWidget* m_destinations_content;
+    QGridLayout* m_destinations_grid_layout;
+    QElapsedTimer m_destinations_paint_timer; // Running from a rebuild until its first paint
     QWidget* m_offers_tab;
     QWidget* m_reservations_tab;
     QWidget* m_profile_tab;
@@ -120,9 +128,8 @@ private:
     std::unique_ptr<Offer_Model> m_offer_model;
     std::unique_ptr<Reservation_Model> m_reservation_model;
 
-    // Offers tab UI references
-    QWidget* m_offers_container;
-    QVBoxLayout* m_offers_container_layout;
+    // Offers tab UI references; the view only paints the rows on screen
+    QListView* m_offers_view;
     QLabel* m_offers_loading_label;
     QLabel* m_offers_no_offers_label;
 
@@ -0,0 +1,40 @@
+#pragma once
+#include <QStyledItemDelegate>
+#include <QRect>
+
+// Paints an Offer_Model row as a card, so a QListView over the model only draws the
+// visible rows and creates no widget per offer. The buttons are painted too; clicks
+// on them are reported through the signals below.
+class Offer_Delegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit Offer_Delegate(QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    // Size the pictures are requested at; the view repaints when Image_Cache reports one
+    static QSize image_size();
+
+    // Button areas within a card, shared by painting and hit testing
+    static QRect book_button_rect(const QRect& card_rect);
+    static QRect details_button_rect(const QRect& card_rect);
+
+    static constexpr int CARD_HEIGHT = 150;
+    static constexpr int CARD_SPACING = 10;
+
+signals:
+    void book_now_clicked(int offer_id);
+    void view_details_clicked(int offer_id);
+
+protected:
+    bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option,
+                     const QModelIndex& index) override;
+
+private:
+    static QRect card_rect(const QRect& item_rect);
+    void paint_button(QPainter* painter, const QRect& rect, const QString& text,
+                      const QColor& background, const QColor& foreground) const;
+};
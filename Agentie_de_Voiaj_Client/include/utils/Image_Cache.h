@@ -0,0 +1,45 @@
+#pragma once
+#include <QObject>
+#include <QPixmap>
+#include <QImage>
+#include <QCache>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+// Card images, decoded and scaled off the GUI thread. request() answers from a
+// memory LRU of scaled pixmaps or starts a job on the pool and returns a null
+// pixmap; the card keeps its placeholder until image_ready() names its image.
+// Jobs read a pre-scaled thumbnail from the disk cache when one exists for the
+// file's path, modification time and size, and write one otherwise.
+class Image_Cache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static Image_Cache& instance();
+
+    QPixmap request(const QString& path, const QSize& size);
+    void clear_memory();
+
+    // Scales to fill size and crops the overflow, as the cards show it
+    static QImage load_scaled(const QString& path, const QSize& size);
+
+signals:
+    void image_ready(const QString& path, const QSize& size);
+
+private:
+    explicit Image_Cache(QObject* parent = nullptr);
+    ~Image_Cache() override;
+
+    static QString cache_key(const QString& path, const QSize& size);
+    static QString thumbnail_path(const QString& path, const QSize& size);
+    static QImage load_thumbnail(const QString& path, const QSize& size); // Runs on the pool
+    void on_image_loaded(const QString& path, const QSize& size, const QImage& image);
+
+    QCache<QString, QPixmap> m_pixmaps; // Cost in KB
+    QSet<QString> m_pending;            // Keys with a job on the pool
+    QSet<QString> m_missing;            // Files that did not decode, not tried again
+    QThreadPool m_pool;
+};
@@ -82,13 +82,14 @@ void Destination_Model::refresh_destinations()
     m_is_loading = true;
     qDebug() << "Destination_Model: Refreshing destinations...";
     
-    Api_Client::instance().get_destinations();
+    Api_Client::instance().get_destinations(m_catalog_version);
 }
 
 void Destination_Model::clear_destinations()
 {
     beginResetModel();
     m_destinations.clear();
+    m_catalog_version = 0;
     endResetModel();
     
     emit destinations_cleared();
@@ -185,6 +186,8 @@ void Destination_Model::connect_api_signals()
     
     connect(&api, &Api_Client::destinations_received,
             this, &Destination_Model::on_destinations_received);
+    connect(&api, &Api_Client::destinations_catalog_received,
+            this, &Destination_Model::on_destinations_catalog_received);
     connect(&api, &Api_Client::network_error,
             this, &Destination_Model::on_network_error);
 }
@@ -215,6 +218,21 @@ void Destination_Model::on_destinations_received(const QJsonArray& destinations)
     emit data_refreshed();
 }
 
+void Destination_Model::on_destinations_catalog_received(qint64 version, const QJsonObject& catalog)
+{
+    if (catalog["not_modified"].toBool())
+    {
+        // The cards on screen are current, nothing is rebuilt
+        qDebug() << "Destination_Model: Destinations not modified since version" << version;
+        m_is_loading = false;
+        emit data_refreshed();
+        return;
+    }
+    
+    on_destinations_received(catalog["destinations"].toArray());
+    m_catalog_version = version;
+}
+
 void Destination_Model::on_network_error(const QString& error_message)
 {
     m_is_loading = false;
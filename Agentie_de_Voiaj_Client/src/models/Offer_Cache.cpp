@@ -0,0 +1,312 @@
+#include "models/Offer_Cache.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // Record fields, byte offsets
+    constexpr int ID = 0;
+    constexpr int DURATION_DAYS = 4;
+    constexpr int AVAILABLE_SEATS = 8;
+    constexpr int PRICE = 16;
+    constexpr int START_DATE = 24;
+    constexpr int END_DATE = 32;
+    constexpr int STRINGS = 40; // (u32 offset, u32 length) each, in the order below
+    constexpr int NAME = 0;
+    constexpr int DESTINATION = 1;
+    constexpr int DESCRIPTION = 2;
+    constexpr int IMAGE_PATH = 3;
+    constexpr int STATUS = 4;
+    constexpr int CREATED_AT = 5;
+    constexpr int MODIFIED_AT = 6;
+    constexpr int STRING_COUNT = 7;
+
+    constexpr qint64 NO_DATE = std::numeric_limits<qint64>::min();
+
+    qint64 date_to_ms(const QDateTime& date)
+    {
+        return date.isValid() ? date.toMSecsSinceEpoch() : NO_DATE;
+    }
+
+    QDateTime date_from_ms(qint64 ms)
+    {
+        return ms == NO_DATE ? QDateTime() : QDateTime::fromMSecsSinceEpoch(ms);
+    }
+
+    double read_double(const uchar* in)
+    {
+        quint64 bits = qFromLittleEndian<quint64>(in);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void write_double(uchar* out, double value)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        qToLittleEndian<quint64>(bits, out);
+    }
+}
+
+Offer_Cache::Offer_Cache(const QString& file_path)
+    : m_file_path(file_path)
+{
+}
+
+Offer_Cache::~Offer_Cache()
+{
+    close();
+}
+
+QString Offer_Cache::default_path()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/offers.cache";
+}
+
+bool Offer_Cache::open(qint64 max_age_ms)
+{
+    close();
+
+    m_file.setFileName(m_file_path);
+    if (!m_file.open(QIODevice::ReadOnly) || m_file.size() < HEADER_SIZE)
+    {
+        close();
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data)
+    {
+        close();
+        return false;
+    }
+
+    // Anything unexpected means a file from another build or a torn write: ignored, rewritten later
+    quint32 magic = qFromLittleEndian<quint32>(m_data);
+    quint16 version = qFromLittleEndian<quint16>(m_data + 4);
+    quint16 record_size = qFromLittleEndian<quint16>(m_data + 6);
+    qint64 saved_at_ms = qFromLittleEndian<qint64>(m_data + 8);
+    quint32 count = qFromLittleEndian<quint32>(m_data + 16);
+    quint64 string_table_offset = qFromLittleEndian<quint64>(m_data + 24);
+    qint64 catalog_version = qFromLittleEndian<qint64>(m_data + 32);
+
+    bool is_valid = magic == MAGIC && version == VERSION && record_size == RECORD_SIZE &&
+                    string_table_offset == HEADER_SIZE + static_cast<quint64>(count) * RECORD_SIZE &&
+                    string_table_offset <= static_cast<quint64>(m_size);
+    if (!is_valid || saved_at_ms + max_age_ms < QDateTime::currentMSecsSinceEpoch())
+    {
+        close();
+        return false;
+    }
+
+    m_record_count = static_cast<int>(count);
+    m_string_table_offset = static_cast<qint64>(string_table_offset);
+    m_catalog_version = catalog_version;
+    return true;
+}
+
+void Offer_Cache::close()
+{
+    if (m_data)
+    {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+    m_record_count = 0;
+    m_string_table_offset = 0;
+    m_catalog_version = 0;
+}
+
+int Offer_Cache::record_id(int index) const
+{
+    const uchar* in = record(index);
+    return in ? qFromLittleEndian<qint32>(in + ID) : 0;
+}
+
+Offer_Model::Offer Offer_Cache::read(int index) const
+{
+    Offer_Model::Offer offer;
+    const uchar* in = record(index);
+    if (!in)
+    {
+        return offer;
+    }
+
+    offer.id = qFromLittleEndian<qint32>(in + ID);
+    offer.duration_days = qFromLittleEndian<qint32>(in + DURATION_DAYS);
+    offer.available_seats = qFromLittleEndian<qint32>(in + AVAILABLE_SEATS);
+    offer.price_per_person = read_double(in + PRICE);
+    offer.start_date = date_from_ms(qFromLittleEndian<qint64>(in + START_DATE));
+    offer.end_date = date_from_ms(qFromLittleEndian<qint64>(in + END_DATE));
+
+    const uchar* refs = in + STRINGS;
+    offer.name = read_string(refs + NAME * 8);
+    offer.destination = read_string(refs + DESTINATION * 8);
+    offer.description = read_string(refs + DESCRIPTION * 8);
+    offer.image_path = read_string(refs + IMAGE_PATH * 8);
+    offer.status = read_string(refs + STATUS * 8);
+    offer.created_at = read_string(refs + CREATED_AT * 8);
+    offer.modified_at = read_string(refs + MODIFIED_AT * 8);
+    return offer;
+}
+
+bool Offer_Cache::write_all(const QVector<Offer_Model::Offer>& offers, qint64 catalog_version)
+{
+    // The mapping would keep the old file from being replaced
+    close();
+
+    QByteArray records(offers.size() * RECORD_SIZE, '\0');
+    QByteArray strings;
+    auto add_string = [&strings](uchar* ref, const QString& value) {
+        QByteArray utf8 = value.toUtf8();
+        qToLittleEndian<quint32>(static_cast<quint32>(strings.size()), ref);
+        qToLittleEndian<quint32>(static_cast<quint32>(utf8.size()), ref + 4);
+        strings.append(utf8);
+    };
+
+    for (int i = 0; i < offers.size(); ++i)
+    {
+        const Offer_Model::Offer& offer = offers[i];
+        uchar* out = reinterpret_cast<uchar*>(records.data()) + i * RECORD_SIZE;
+        qToLittleEndian<qint32>(offer.id, out + ID);
+        qToLittleEndian<qint32>(offer.duration_days, out + DURATION_DAYS);
+        qToLittleEndian<qint32>(offer.available_seats, out + AVAILABLE_SEATS);
+        write_double(out + PRICE, offer.price_per_person);
+        qToLittleEndian<qint64>(date_to_ms(offer.start_date), out + START_DATE);
+        qToLittleEndian<qint64>(date_to_ms(offer.end_date), out + END_DATE);
+
+        uchar* refs = out + STRINGS;
+        add_string(refs + NAME * 8, offer.name);
+        add_string(refs + DESTINATION * 8, offer.destination);
+        add_string(refs + DESCRIPTION * 8, offer.description);
+        add_string(refs + IMAGE_PATH * 8, offer.image_path);
+        add_string(refs + STATUS * 8, offer.status);
+        add_string(refs + CREATED_AT * 8, offer.created_at);
+        add_string(refs + MODIFIED_AT * 8, offer.modified_at);
+    }
+    static_assert(STRINGS + STRING_COUNT * 8 == RECORD_SIZE, "record layout and RECORD_SIZE disagree");
+
+    uchar header[HEADER_SIZE] = {};
+    qToLittleEndian<quint32>(MAGIC, header);
+    qToLittleEndian<quint16>(VERSION, header + 4);
+    qToLittleEndian<quint16>(RECORD_SIZE, header + 6);
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), header + 8);
+    qToLittleEndian<quint32>(static_cast<quint32>(offers.size()), header + 16);
+    qToLittleEndian<quint64>(HEADER_SIZE + static_cast<quint64>(records.size()), header + 24);
+    qToLittleEndian<qint64>(catalog_version, header + 32);
+
+    QDir().mkpath(QFileInfo(m_file_path).absolutePath());
+    QSaveFile file(m_file_path);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(reinterpret_cast<const char*>(header), HEADER_SIZE) != HEADER_SIZE ||
+        file.write(records) != records.size() ||
+        file.write(strings) != strings.size() ||
+        !file.commit())
+    {
+        qWarning() << "Offer_Cache: could not write" << m_file_path;
+        return false;
+    }
+    return true;
+}
+
+bool Offer_Cache::touch(qint64 catalog_version)
+{
+    QFile file(m_file_path);
+    uchar magic[4];
+    if (!file.open(QIODevice::ReadWrite) || file.read(reinterpret_cast<char*>(magic), 4) != 4 ||
+        qFromLittleEndian<quint32>(magic) != MAGIC)
+    {
+        return false;
+    }
+
+    uchar saved_at[8];
+    uchar version[8];
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), saved_at);
+    qToLittleEndian<qint64>(catalog_version, version);
+    return file.seek(8) && file.write(reinterpret_cast<const char*>(saved_at), 8) == 8 &&
+           file.seek(32) && file.write(reinterpret_cast<const char*>(version), 8) == 8;
+}
+
+bool Offer_Cache::update_record(int index, const Offer_Model::Offer& before, const Offer_Model::Offer& after)
+{
+    // Separate handle: the mapping stays read-only, and the rows it still has to decode are not touched
+    QFile file(m_file_path);
+    if (!file.open(QIODevice::ReadWrite) || file.size() < HEADER_SIZE)
+    {
+        return false;
+    }
+
+    uchar header[HEADER_SIZE];
+    if (file.read(reinterpret_cast<char*>(header), HEADER_SIZE) != HEADER_SIZE ||
+        qFromLittleEndian<quint32>(header) != MAGIC ||
+        index < 0 || static_cast<quint32>(index) >= qFromLittleEndian<quint32>(header + 16))
+    {
+        return false;
+    }
+
+    // A failed full write leaves an older file behind, its rows may not line up with the model's
+    qint64 record_offset = HEADER_SIZE + static_cast<qint64>(index) * RECORD_SIZE;
+    uchar id[4];
+    if (!file.seek(record_offset + ID) || file.read(reinterpret_cast<char*>(id), 4) != 4 ||
+        qFromLittleEndian<qint32>(id) != after.id)
+    {
+        return false;
+    }
+
+    uchar seats[4];
+    qToLittleEndian<qint32>(after.available_seats, seats);
+    if (!file.seek(record_offset + AVAILABLE_SEATS) || file.write(reinterpret_cast<const char*>(seats), 4) != 4)
+    {
+        return false;
+    }
+
+    if (before.status != after.status)
+    {
+        // The old bytes stay in the table unused until the next full write
+        QByteArray utf8 = after.status.toUtf8();
+        qint64 string_table_offset = static_cast<qint64>(qFromLittleEndian<quint64>(header + 24));
+        qint64 end = file.size();
+        uchar ref[8];
+        qToLittleEndian<quint32>(static_cast<quint32>(end - string_table_offset), ref);
+        qToLittleEndian<quint32>(static_cast<quint32>(utf8.size()), ref + 4);
+        if (!file.seek(end) || file.write(utf8) != utf8.size() ||
+            !file.seek(record_offset + STRINGS + STATUS * 8) || file.write(reinterpret_cast<const char*>(ref), 8) != 8)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const uchar* Offer_Cache::record(int index) const
+{
+    if (!m_data || index < 0 || index >= m_record_count)
+    {
+        return nullptr;
+    }
+    return m_data + HEADER_SIZE + static_cast<qint64>(index) * RECORD_SIZE;
+}
+
+QString Offer_Cache::read_string(const uchar* ref) const
+{
+    qint64 offset = m_string_table_offset + qFromLittleEndian<quint32>(ref);
+    qint64 length = qFromLittleEndian<quint32>(ref + 4);
+    if (offset + length > m_size)
+    {
+        return QString(); // Damaged file; appended after this mapping was made is not possible for undecoded rows
+    }
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + offset), static_cast<qsizetype>(length));
+}
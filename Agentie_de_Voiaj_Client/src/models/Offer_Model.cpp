@@ -1,5 +1,7 @@
 #include "models/Offer_Model.h"
+#include "models/Offer_Cache.h"
 #include "network/Api_Client.h"
+#include "config.h"
 #include <QDebug>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -7,22 +9,28 @@
 #include <QSettings>
 #include <QStandardPaths>
 #include <QDir>
+#include <QSet>
 
 Offer_Model::Offer_Model(QObject* parent)
     : QAbstractListModel(parent)
+    , m_cache(std::make_unique<Offer_Cache>())
     , m_settings(new QSettings(QSettings::IniFormat, QSettings::UserScope, "Agentie_de_Voiaj", "Offer_Model", this))
+    , m_refresh_timer(new QTimer(this))
 {
     connect_api_signals();
     
+    // Only the catalog is refreshed, a search result on screen is left alone
+    m_refresh_timer->setInterval(Config::Cache::OFFERS_CACHE_MINUTES * 60 * 1000);
+    connect(m_refresh_timer, &QTimer::timeout, this, [this]() {
+        if (m_catalog_version > 0)
+            refresh_offers();
+    });
+    
     // Load cached offers if available
     load_cached_offers();
 }
 
-Offer_Model::~Offer_Model()
-{
-    // Save current offers to cache
-    save_cached_offers();
-}
+Offer_Model::~Offer_Model() = default; // The cache file is written as the offers change
 
 int Offer_Model::rowCount(const QModelIndex& parent) const
 {
@@ -37,7 +45,7 @@ QVariant Offer_Model::data(const QModelIndex& index, int role) const
     if (!index.isValid() || index.row() >= m_offers.size())
         return QVariant();
     
-    const Offer& offer = m_offers[index.row()];
+    const Offer& offer = decoded_row(index.row());
     
     switch (role)
     {
@@ -99,7 +107,18 @@ void Offer_Model::refresh_offers()
     set_loading(true);
     qDebug() << "Offer_Model: Refreshing offers...";
     
-    Api_Client::instance().get_offers();
+    // After the first load, seat changes are pushed instead of reloading the list
+    if (!m_is_subscribed)
+    {
+        Api_Client::instance().subscribe_offer_updates();
+        m_is_subscribed = true;
+    }
+    
+    // Sends the version held, an unchanged catalog costs one short reply
+    if (!m_refresh_timer->isActive())
+        m_refresh_timer->start();
+    
+    Api_Client::instance().get_offers(m_catalog_version);
 }
 
 void Offer_Model::search_offers(const QString& destination, double min_price, double max_price)
@@ -125,6 +144,10 @@ void Offer_Model::clear_offers()
 {
     beginResetModel();
     m_offers.clear();
+    m_is_row_decoded.clear();
+    m_undecoded_rows = 0;
+    m_row_by_id.clear();
+    m_catalog_version = 0;
     endResetModel();
     
     emit offers_cleared();
@@ -132,23 +155,22 @@ void Offer_Model::clear_offers()
 
 const QVector<Offer_Model::Offer>& Offer_Model::get_offers() const
 {
+    decode_all_rows();
     return m_offers;
 }
 
 Offer_Model::Offer Offer_Model::get_offer(int index) const
 {
     if (index >= 0 && index < m_offers.size())
-        return m_offers.at(index);
+        return decoded_row(index);
     return Offer();
 }
 
 Offer_Model::Offer Offer_Model::get_offer_by_id(int id) const
 {
-    auto it = std::find_if(m_offers.begin(), m_offers.end(),
-                          [id](const Offer& offer) { return offer.id == id; });
-    
-    if (it != m_offers.end())
-        return *it;
+    auto it = m_row_by_id.constFind(id);
+    if (it != m_row_by_id.constEnd())
+        return decoded_row(it.value());
     return Offer();
 }
 
@@ -160,6 +182,7 @@ int Offer_Model::get_offer_count() const
 QVector<Offer_Model::Offer> Offer_Model::get_offers_by_destination(const QString& destination) const
 {
     QVector<Offer> results;
+    decode_all_rows();
     
     if (destination.isEmpty())
         return m_offers;
@@ -176,6 +199,7 @@ QVector<Offer_Model::Offer> Offer_Model::get_offers_by_destination(const QString
 QVector<Offer_Model::Offer> Offer_Model::get_offers_by_price_range(double min_price, double max_price) const
 {
     QVector<Offer> results;
+    decode_all_rows();
     
     for (const auto& offer : m_offers)
     {
@@ -189,6 +213,7 @@ QVector<Offer_Model::Offer> Offer_Model::get_offers_by_price_range(double min_pr
 QVector<Offer_Model::Offer> Offer_Model::get_available_offers() const
 {
     QVector<Offer> results;
+    decode_all_rows();
     
     for (const auto& offer : m_offers)
     {
@@ -222,6 +247,10 @@ void Offer_Model::connect_api_signals()
     
     connect(&api, &Api_Client::offers_received,
             this, &Offer_Model::on_offers_received);
+    connect(&api, &Api_Client::offers_catalog_received,
+            this, &Offer_Model::on_offers_catalog_received);
+    connect(&api, &Api_Client::offer_updates_received,
+            this, &Offer_Model::on_offer_updates_received);
     connect(&api, &Api_Client::booking_success,
             this, &Offer_Model::on_booking_success);
     connect(&api, &Api_Client::booking_failed,
@@ -238,8 +267,47 @@ void Offer_Model::on_offers_received(const QJsonArray& offers)
 {
     qDebug() << "Offer_Model: Received" << offers.size() << "offers";
     
+    // A search result, or a server without versions: nothing to ask for changes against
+    m_catalog_version = 0;
+    replace_offers(offers);
+}
+
+void Offer_Model::on_offers_catalog_received(qint64 version, const QJsonObject& catalog)
+{
+    if (catalog.contains("offers"))
+    {
+        QJsonArray offers = catalog["offers"].toArray();
+        qDebug() << "Offer_Model: Received" << offers.size() << "offers, catalog version" << version;
+        m_catalog_version = version;
+        replace_offers(offers);
+        return;
+    }
+    
+    set_loading(false);
+    m_catalog_version = version;
+    
+    if (catalog["not_modified"].toBool())
+    {
+        // Rows stay as they are, the file only records that they were confirmed
+        m_cache->touch(version);
+    }
+    else
+    {
+        apply_offer_changes(catalog["changed"].toArray(), catalog["removed"].toArray());
+        save_cached_offers();
+    }
+    
+    // The list on screen is current either way, the window drops its loading state
+    emit offers_loaded();
+    emit data_refreshed();
+}
+
+void Offer_Model::replace_offers(const QJsonArray& offers)
+{
     beginResetModel();
     m_offers.clear();
+    m_is_row_decoded.clear();
+    m_undecoded_rows = 0;
     
     for (const auto& value : offers)
     {
@@ -253,16 +321,90 @@ void Offer_Model::on_offers_received(const QJsonArray& offers)
         }
     }
     
+    rebuild_row_index();
     endResetModel();
     
     set_loading(false);
     emit offers_loaded();
     emit data_refreshed();
     
-    // Save to cache
+    // The list was replaced, so is the file
     save_cached_offers();
 }
 
+void Offer_Model::apply_offer_changes(const QJsonArray& changed, const QJsonArray& removed)
+{
+    // Rows move below, the cache file is written again from the decoded rows afterwards
+    decode_all_rows();
+    
+    QSet<int> removed_ids;
+    for (const auto& value : removed)
+        removed_ids.insert(value.toInt());
+    
+    for (int row = m_offers.size() - 1; row >= 0 && !removed_ids.isEmpty(); --row)
+    {
+        if (!removed_ids.contains(m_offers[row].id))
+            continue;
+        
+        beginRemoveRows(QModelIndex(), row, row);
+        m_offers.remove(row);
+        endRemoveRows();
+    }
+    rebuild_row_index();
+    
+    for (const auto& value : changed)
+    {
+        Offer offer = offer_from_json(value.toObject());
+        if (offer.id <= 0)
+            continue;
+        
+        auto it = m_row_by_id.constFind(offer.id);
+        if (it != m_row_by_id.constEnd())
+        {
+            m_offers[it.value()] = offer;
+            QModelIndex changed_index = index(it.value());
+            emit dataChanged(changed_index, changed_index);
+            continue;
+        }
+        
+        int row = m_offers.size();
+        beginInsertRows(QModelIndex(), row, row);
+        m_offers.append(offer);
+        m_row_by_id.insert(offer.id, row);
+        endInsertRows();
+    }
+    
+    qDebug() << "Offer_Model: Applied" << changed.size() << "changed and" << removed.size() << "removed offers";
+}
+
+void Offer_Model::on_offer_updates_received(const QJsonArray& updates)
+{
+    // Only the changed rows are touched, views keep their scroll position and selection
+    static const QVector<int> changed_roles = { Available_Seats_Role, Status_Role };
+    
+    for (const auto& value : updates)
+    {
+        QJsonObject update = value.toObject();
+        auto it = m_row_by_id.constFind(update["offer_id"].toInt());
+        if (it == m_row_by_id.constEnd())
+            continue; // Not in the current list, e.g. filtered out by a search
+        
+        int row = it.value();
+        Offer before = decoded_row(row);
+        int available_seats = update["available_seats"].toInt();
+        QString status = update["status"].toString();
+        if (before.available_seats == available_seats && before.status == status)
+            continue;
+        
+        Offer& offer = m_offers[row];
+        offer.available_seats = available_seats;
+        offer.status = status;
+        m_cache->update_record(row, before, offer); // Same row order as the file
+        QModelIndex changed = index(row);
+        emit dataChanged(changed, changed, changed_roles);
+    }
+}
+
 void Offer_Model::on_booking_success(const QString& message)
 {
     qDebug() << "Offer_Model: Booking successful:" << message;
@@ -323,6 +465,16 @@ Offer_Model::Offer Offer_Model::offer_from_json(const QJsonObject& jsonObj) cons
     return offer;
 }
 
+void Offer_Model::rebuild_row_index()
+{
+    m_row_by_id.clear();
+    m_row_by_id.reserve(m_offers.size());
+    for (int row = 0; row < m_offers.size(); ++row)
+    {
+        m_row_by_id.insert(m_offers[row].id, row);
+    }
+}
+
 void Offer_Model::set_loading(bool loading)
 {
     if (m_is_loading != loading)
@@ -342,61 +494,63 @@ void Offer_Model::save_cached_offers()
     if (m_offers.isEmpty())
         return;
     
-    QJsonArray offers_array;
-    for (const auto& offer : m_offers)
-    {
-        QJsonObject offer_obj;
-        offer_obj["Offer_ID"] = offer.id;
-        offer_obj["Name"] = offer.name;
-        offer_obj["Destination"] = offer.destination;
-        offer_obj["Price_per_Person"] = offer.price_per_person;
-        offer_obj["Duration_Days"] = offer.duration_days;
-        offer_obj["Available_Seats"] = offer.available_seats;
-        offer_obj["Description"] = offer.description;
-        offer_obj["Image_Path"] = offer.image_path;
-        offer_obj["Status"] = offer.status;
-        offer_obj["Date_Created"] = offer.created_at;
-        offer_obj["Date_Modified"] = offer.modified_at;
-        
-        offers_array.append(offer_obj);
-    }
-    
-    m_settings->setValue("cached_offers", offers_array);
-    m_settings->setValue("cache_timestamp", QDateTime::currentDateTime().toString(Qt::ISODate));
+    decode_all_rows();
+    m_cache->write_all(m_offers, m_catalog_version);
 }
 
 void Offer_Model::load_cached_offers()
 {
-    if (!m_settings->contains("cached_offers"))
-        return;
-    
-    QJsonArray offers_array = m_settings->value("cached_offers").toJsonArray();
-    if (offers_array.isEmpty())
-        return;
+    // The JSON copy in the settings file is replaced by the binary cache
+    if (m_settings->contains("cached_offers"))
+    {
+        m_settings->remove("cached_offers");
+        m_settings->remove("cache_timestamp");
+    }
     
-    // Check if cache is not too old (24 hours)
-    QString cache_timestamp = m_settings->value("cache_timestamp").toString();
-    QDateTime cache_time = QDateTime::fromString(cache_timestamp, Qt::ISODate);
-    if (cache_time.addDays(1) < QDateTime::currentDateTime())
+    qint64 max_age_ms = qint64(Config::Cache::OFFLINE_OFFERS_MAX_AGE_HOURS) * 60 * 60 * 1000;
+    if (!m_cache->open(max_age_ms) || m_cache->record_count() == 0)
+    {
+        m_cache->close();
         return;
+    }
     
+    // Only the ids are read now, for the row index; the rest when a row is first shown
+    int count = m_cache->record_count();
+    m_catalog_version = m_cache->catalog_version();
     beginResetModel();
-    m_offers.clear();
-    
-    for (const auto& value : offers_array)
+    m_offers = QVector<Offer>(count);
+    m_is_row_decoded = QVector<bool>(count, false);
+    m_undecoded_rows = count;
+    for (int row = 0; row < count; ++row)
     {
-        if (value.isObject())
-        {
-            Offer offer = offer_from_json(value.toObject());
-            if (offer.id > 0)
-            {
-                m_offers.append(offer);
-            }
-        }
+        m_offers[row].id = m_cache->record_id(row);
     }
     
+    rebuild_row_index();
     endResetModel();
     
-    qDebug() << "Offer_Model: Loaded" << m_offers.size() << "cached offers";
+    qDebug() << "Offer_Model: Mapped" << count << "cached offers";
 }
 
+const Offer_Model::Offer& Offer_Model::decoded_row(int row) const
+{
+    if (m_undecoded_rows > 0 && !m_is_row_decoded[row])
+    {
+        m_offers[row] = m_cache->read(row);
+        m_is_row_decoded[row] = true;
+        if (--m_undecoded_rows == 0)
+        {
+            m_is_row_decoded.clear();
+            m_cache->close();
+        }
+    }
+    return m_offers[row];
+}
+
+void Offer_Model::decode_all_rows() const
+{
+    for (int row = 0; m_undecoded_rows > 0 && row < m_offers.size(); ++row)
+    {
+        decoded_row(row);
+    }
+}
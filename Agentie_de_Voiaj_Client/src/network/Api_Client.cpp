@@ -1,9 +1,11 @@
 #include "network/Api_Client.h"
+#include "network/Payload_Decompressor.h"
 #include "config/config.h"
 
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QMutexLocker>
+#include <QtEndian>
 #include <QDebug>
 #include <mutex>
 
@@ -19,12 +21,20 @@ Api_Client::Api_Client(QObject* parent)
     , m_server_port(Config::Server::DEFAULT_PORT)
     , m_timeout_ms(DEFAULT_TIMEOUT_MS)
     , m_is_connected(false)
-    , m_current_request_type(Request_Type::Login)
+    , m_framing(Framing_Mode::Text_Lines)
+    , m_is_hello_pending(false)
+    , m_next_request_id(0)
+    , m_wants_offer_updates(false)
+    , m_is_offer_subscription_sent(false)
+    , m_is_session_resume_pending(false)
+    , m_is_session_bound(false)
+    , m_connected_at_ms(0)
 {
     // Setup timeout timer
     m_timeout_timer->setSingleShot(true);
     connect(m_timeout_timer.get(), &QTimer::timeout, 
             this, &Api_Client::on_request_timeout);
+    m_clock.start();
     
     	// Setup reconnection timer
 	m_reconnect_timer->setSingleShot(true);
@@ -81,6 +91,7 @@ void Api_Client::set_auth_token(const QString& token)
 {
     QMutexLocker locker(&m_mutex);
     m_auth_token = token;
+    m_is_session_bound = false; // Sent with the next queued requests
 }
 
 void Api_Client::set_timeout(int timeout_ms)
@@ -167,8 +178,11 @@ void Api_Client::test_connection()
     testData["type"] = "KEEPALIVE";
     
     // Don't use Request_Type::Login for keepalive - this is a protocol keepalive
-    if (is_connected()) {
-        send_json_message(testData);
+    // (skipped while HELLO is pending, the framing is not settled yet)
+    if (is_connected() && !m_is_hello_pending) {
+        if (!send_json_message(testData)) {
+            emit_error(get_last_error());
+        }
     } else {
         qDebug() << "Cannot test connection - not connected to server";
     }
@@ -309,8 +323,19 @@ void Api_Client::register_user(const QJsonObject& user_data)
 
 void Api_Client::logout()
 {
+    // The server revokes the token, otherwise it could still be resumed; disconnectFromHost()
+    // below writes it out before closing. No reply is waited for.
+    if (!m_auth_token.isEmpty() && !m_is_hello_pending)
+    {
+        QJsonObject logoutData;
+        logoutData["type"] = "LOGOUT";
+        logoutData["token"] = m_auth_token;
+        send_json_message(logoutData);
+    }
+    
     QMutexLocker locker(&m_mutex);
     m_auth_token.clear();
+    m_is_session_bound = false;
     m_is_connected = false;
     disconnect_from_server();
     
@@ -318,18 +343,20 @@ void Api_Client::logout()
     emit connection_status_changed(false);
 }
 
-void Api_Client::get_destinations()
+void Api_Client::get_destinations(qint64 known_version)
 {
     QJsonObject requestData;
     requestData["type"] = "GET_DESTINATIONS";
+    requestData["known_version"] = known_version;
     
     send_request(Request_Type::Get_Destinations, requestData);
 }
 
-void Api_Client::get_offers()
+void Api_Client::get_offers(qint64 known_version)
 {
     QJsonObject requestData;
     requestData["type"] = "GET_OFFERS";
+    requestData["known_version"] = known_version;
     
     send_request(Request_Type::Get_Offers, requestData);
 }
@@ -342,6 +369,12 @@ void Api_Client::search_offers(const QJsonObject& search_params)
     send_request(Request_Type::Search_Offers, requestData);
 }
 
+void Api_Client::subscribe_offer_updates()
+{
+    m_wants_offer_updates = true;
+    send_offer_subscription();
+}
+
 void Api_Client::get_user_info()
 {
     QJsonObject requestData;
@@ -449,66 +482,126 @@ QString Api_Client::get_last_error() const
 
 void Api_Client::send_request(Request_Type type, const QJsonObject& data)
 {
-    m_current_request_type = type;
-    
-    if (!is_connected())
+    // Until the HELLO reply arrives the framing is undecided, and until the session is
+    // resumed the connection is anonymous, so requests wait
+    if (!is_connected() || m_is_hello_pending || m_is_session_resume_pending)
     {
-        // Store the request for sending after connection is established
+        if (m_queued_requests.size() >= MAX_QUEUED_REQUESTS)
         {
-            QMutexLocker locker(&m_mutex);
-            m_pending_request = Pending_Request{type, data};
+            fail_request(type, "Too many requests waiting for the connection");
+            return;
         }
+        
+        // Sent in order once the connection is established
+        m_queued_requests.append(Queued_Request{type, data});
         connect_to_server();
         return;
     }
     
-    send_json_message(data);
+    dispatch_request(type, data);
 }
 
-void Api_Client::send_json_message(const QJsonObject& message)
+void Api_Client::dispatch_request(Request_Type type, const QJsonObject& data)
 {
-    if (m_socket->state() != QAbstractSocket::ConnectedState)
+    // 0 means "no id" to the server, skip it when the counter wraps
+    quint32 request_id = ++m_next_request_id;
+    if (request_id == 0)
+    {
+        request_id = ++m_next_request_id;
+    }
+    
+    // Binary frames carry the id in the header, text lines in the payload
+    QJsonObject message = data;
+    if (m_framing == Framing_Mode::Text_Lines)
+    {
+        message["request_id"] = static_cast<qint64>(request_id);
+    }
+    
+    if (!send_json_message(message, request_id))
     {
-        emit_error("Not connected to server");
+        fail_request(type, get_last_error());
         return;
     }
     
+    int timeout = (m_timeout_ms > 0) ? m_timeout_ms : Config::Server::REQUEST_TIMEOUT_MS;
+    m_in_flight.insert(request_id, In_Flight_Request{type, m_clock.elapsed() + timeout});
+    arm_request_timer();
+}
+
+void Api_Client::arm_request_timer()
+{
+    // One timer for every outstanding request, due at the earliest deadline
+    if (m_in_flight.isEmpty())
+    {
+        m_timeout_timer->stop();
+        return;
+    }
+    
+    qint64 earliest = m_in_flight.cbegin()->deadline_ms;
+    for (auto it = m_in_flight.cbegin(); it != m_in_flight.cend(); ++it)
+    {
+        earliest = qMin(earliest, it->deadline_ms);
+    }
+    m_timeout_timer->start(static_cast<int>(qMax<qint64>(0, earliest - m_clock.elapsed())));
+}
+
+bool Api_Client::send_json_message(const QJsonObject& message, quint32 request_id)
+{
+    auto set_error = [this](const QString& error) {
+        QMutexLocker locker(&m_mutex);
+        m_last_error = error;
+    };
+    
+    if (m_socket->state() != QAbstractSocket::ConnectedState)
+    {
+        set_error("Not connected to server");
+        return false;
+    }
+    
     // Validate message size
     QJsonDocument doc(message);
     QByteArray jsonData = doc.toJson(QJsonDocument::Compact);
     
     if (jsonData.size() > MAX_BUFFER_SIZE)
     {
-        emit_error("Message too large to send");
-        return;
+        set_error("Message too large to send");
+        return false;
     }
     
-    // Add carriage return and newline delimiter to match server expectation
-    jsonData.append("\r\n");
-    
-    qDebug() << "Sending JSON message:" << jsonData;
+    if (m_framing == Framing_Mode::Binary)
+    {
+        QByteArray header(FRAME_HEADER_SIZE, '\0');
+        qToBigEndian<quint32>(static_cast<quint32>(jsonData.size()), header.data());
+        qToBigEndian<quint16>(wire_type_for(message["type"].toString()), header.data() + 4);
+        qToBigEndian<quint16>(0, header.data() + 6);
+        qToBigEndian<quint32>(request_id, header.data() + 8);
+        
+        qDebug() << "Sending JSON frame" << request_id << ":" << jsonData;
+        jsonData.prepend(header);
+    }
+    else
+    {
+        qDebug() << "Sending JSON message:" << jsonData;
+        
+        // Add carriage return and newline delimiter to match server expectation
+        jsonData.append("\r\n");
+    }
     
     qint64 bytesWritten = m_socket->write(jsonData);
     if (bytesWritten == -1)
     {
-        emit_error(QString("Failed to write to socket: %1").arg(m_socket->errorString()));
-        return;
+        set_error(QString("Failed to write to socket: %1").arg(m_socket->errorString()));
+        return false;
     }
     
     if (bytesWritten != jsonData.size())
     {
-        emit_error(QString("Incomplete message sent: %1 of %2 bytes").arg(bytesWritten).arg(jsonData.size()));
-        return;
+        set_error(QString("Incomplete message sent: %1 of %2 bytes").arg(bytesWritten).arg(jsonData.size()));
+        return false;
     }
     
-    if (!m_socket->flush())
-    {
-        qWarning() << "Socket flush failed, but data was written";
-    }
-    
-    	// Start timeout timer with configured timeout
-	int timeout = (m_timeout_ms > 0) ? m_timeout_ms : Config::Server::REQUEST_TIMEOUT_MS;
-	m_timeout_timer->start(timeout);
+    // No flush: back-to-back requests leave in as few segments as Qt can manage
+    return true;
 }
 
 void Api_Client::on_socket_connected()
@@ -518,22 +611,142 @@ void Api_Client::on_socket_connected()
     // Stop reconnection attempts
     m_reconnect_timer->stop();
     
-    std::optional<Pending_Request> pending;
     {
         QMutexLocker locker(&m_mutex);
         m_is_connected = true;
-        pending = m_pending_request;
-        m_pending_request.reset();
     }
+    m_connected_at_ms = m_clock.elapsed();
     
     emit connection_status_changed(true);
     
-    // Send pending request if exists
-    if (pending.has_value())
+    if (Config::Server::USE_BINARY_FRAMING)
+    {
+        // Queued requests go out once the framing is settled
+        send_hello();
+        return;
+    }
+    
+    send_queued_requests();
+}
+
+void Api_Client::send_hello()
+{
+    QJsonObject helloData;
+    helloData["type"] = "HELLO";
+    helloData["framing"] = "binary";
+    if (Config::Server::USE_COMPRESSION)
+    {
+        helloData["compression"] = "zstd";
+        helloData["dictionary"] = Payload_Decompressor::DICTIONARY_NAME;
+    }
+    
+    if (!send_json_message(helloData))
+    {
+        emit_error(get_last_error());
+        return;
+    }
+    
+    m_is_hello_pending = true;
+    int timeout = (m_timeout_ms > 0) ? m_timeout_ms : Config::Server::REQUEST_TIMEOUT_MS;
+    m_timeout_timer->start(timeout);
+}
+
+void Api_Client::handle_hello_response(const QJsonObject& response)
+{
+    m_is_hello_pending = false;
+    
+    // Older servers answer HELLO with an error, the connection simply stays on text lines
+    QJsonObject data = response["data"].toObject();
+    if (response["success"].toBool() && data["framing"].toString() == "binary")
+    {
+        m_framing = Framing_Mode::Binary;
+        // Servers without compression leave it out or answer "none"
+        if (data["compression"].toString() == "zstd")
+        {
+            bool use_dictionary = data["dictionary"].toString() == Payload_Decompressor::DICTIONARY_NAME;
+            m_decompressor = std::make_unique<Payload_Decompressor>(use_dictionary);
+        }
+    }
+    qDebug() << "Framing negotiated:" << (m_framing == Framing_Mode::Binary ? "binary" : "text")
+             << (m_decompressor ? "compressed" : "");
+    
+    m_timeout_timer->stop();
+    send_queued_requests();
+}
+
+void Api_Client::send_offer_subscription()
+{
+    // Until the connection is ready send_queued_requests() calls this again
+    if (!m_wants_offer_updates || m_is_offer_subscription_sent || !is_connected() || m_is_hello_pending)
+    {
+        return;
+    }
+    
+    QJsonObject requestData;
+    requestData["type"] = "SUBSCRIBE_OFFERS";
+    requestData["subscribe"] = true;
+    
+    m_is_offer_subscription_sent = true;
+    dispatch_request(Request_Type::Subscribe_Offers, requestData);
+}
+
+bool Api_Client::send_session_resume()
+{
+    // One lookup on the server instead of the full login, see handle_resume_session()
+    if (m_auth_token.isEmpty() || m_is_session_bound || m_is_session_resume_pending ||
+        m_socket->state() != QAbstractSocket::ConnectedState)
+    {
+        return false;
+    }
+    
+    QJsonObject requestData;
+    requestData["type"] = "RESUME_SESSION";
+    requestData["token"] = m_auth_token;
+    
+    m_is_session_resume_pending = true;
+    dispatch_request(Request_Type::Resume_Session, requestData);
+    return true;
+}
+
+void Api_Client::finish_session_resume(bool is_resumed, const Api_Response& response)
+{
+    m_is_session_resume_pending = false;
+    
+    if (is_resumed)
     {
-        qDebug() << "Sending pending request:" << request_type_to_string(pending->type);
-        m_current_request_type = pending->type;
-        send_json_message(pending->data);
+        m_is_session_bound = true;
+        qDebug() << "Session resumed" << (m_clock.elapsed() - m_connected_at_ms) << "ms after connecting";
+        emit session_resumed(response.data);
+    }
+    else
+    {
+        qWarning() << "Session could not be resumed:" << response.message;
+        m_auth_token.clear();
+        emit session_expired();
+    }
+    
+    // The queued requests of an expired session fail on the server with a login error
+    send_queued_requests();
+}
+
+void Api_Client::send_queued_requests()
+{
+    // The rest waits for the RESUME_SESSION reply, which calls this again
+    if (send_session_resume())
+    {
+        return;
+    }
+    
+    send_offer_subscription();
+    
+    // All of them go out back to back, the responses are matched by request id
+    QList<Queued_Request> queued;
+    queued.swap(m_queued_requests);
+    
+    for (const Queued_Request& request : queued)
+    {
+        qDebug() << "Sending queued request:" << request_type_to_string(request.type);
+        dispatch_request(request.type, request.data);
     }
 }
 
@@ -547,7 +760,16 @@ void Api_Client::on_socket_disconnected()
         m_receive_buffer.clear();
     }
     
-    m_timeout_timer->stop();
+    // Every connection starts on text lines and negotiates again
+    m_framing = Framing_Mode::Text_Lines;
+    m_is_hello_pending = false;
+    m_decompressor.reset();
+    m_is_offer_subscription_sent = false;
+    m_is_session_resume_pending = false;
+    m_is_session_bound = false;
+    
+    // Responses to requests already sent will not arrive on a new connection
+    fail_in_flight_requests("Connection lost before the server responded", false);
     emit connection_status_changed(false);
     
     // Start reconnection attempts only if this wasn't an intentional disconnect
@@ -596,12 +818,13 @@ void Api_Client::attempt_reconnection()
 
 void Api_Client::on_socket_ready_read()
 {
-    m_timeout_timer->stop();
-    
     QByteArray data = m_socket->readAll();
     
-    // Check buffer size limit to prevent memory exhaustion
-    if (m_receive_buffer.size() + data.size() > MAX_BUFFER_SIZE)
+    // Check buffer size limit to prevent memory exhaustion; a binary frame
+    // announces its length, so it may be larger than a text line
+    int buffer_limit = m_framing == Framing_Mode::Binary ?
+        Config::Server::MAX_FRAME_BYTES + FRAME_HEADER_SIZE : MAX_BUFFER_SIZE;
+    if (m_receive_buffer.size() + data.size() > buffer_limit)
     {
         qWarning() << "Buffer size limit exceeded, clearing buffer";
         emit_error("Receive buffer overflow - connection reset");
@@ -611,33 +834,26 @@ void Api_Client::on_socket_ready_read()
     
     m_receive_buffer.append(data);
     
-    // Process complete JSON messages (delimited by newlines)
+    // Process complete messages (lines or frames, depending on the negotiated framing)
     int processed_messages = 0;
     const int MAX_MESSAGES_PER_READ = 100; // Prevent infinite loop
     
     while (processed_messages < MAX_MESSAGES_PER_READ)
     {
-        int newlineIndex = m_receive_buffer.indexOf('\n');
-        if (newlineIndex == -1)
+        QByteArray messageData;
+        quint32 request_id = 0;
+        if (!take_next_message(messageData, request_id))
         {
             break; // No complete message yet
         }
         
-        QByteArray messageData = m_receive_buffer.left(newlineIndex);
-        // Remove \r if present before \n
-        if (!messageData.isEmpty() && messageData.endsWith('\r'))
-        {
-            messageData.chop(1);
-        }
-        m_receive_buffer.remove(0, newlineIndex + 1);
-        
         if (messageData.isEmpty())
         {
             processed_messages++;
             continue;
         }
         
-        qDebug() << "Received JSON message:" << messageData;
+        qDebug() << "Received JSON message:" << messageData.left(512);
         
         QJsonParseError parseError;
         QJsonDocument doc = QJsonDocument::fromJson(messageData, &parseError);
@@ -651,7 +867,16 @@ void Api_Client::on_socket_ready_read()
         
         if (doc.isObject())
         {
-            handle_response(doc.object());
+            // The server switches framing right after its HELLO reply, so the bytes
+            // still buffered are read in the new mode on the next iteration
+            if (m_is_hello_pending)
+            {
+                handle_hello_response(doc.object());
+            }
+            else
+            {
+                handle_response(doc.object(), request_id);
+            }
         }
         
         processed_messages++;
@@ -663,6 +888,60 @@ void Api_Client::on_socket_ready_read()
     }
 }
 
+bool Api_Client::take_next_message(QByteArray& message, quint32& request_id)
+{
+    if (m_framing == Framing_Mode::Binary)
+    {
+        if (m_receive_buffer.size() < FRAME_HEADER_SIZE)
+        {
+            return false;
+        }
+        
+        quint32 length = qFromBigEndian<quint32>(m_receive_buffer.constData());
+        if (length > static_cast<quint32>(Config::Server::MAX_FRAME_BYTES) ||
+            m_receive_buffer.size() - FRAME_HEADER_SIZE < static_cast<qsizetype>(length))
+        {
+            return false; // Incomplete; an oversized frame trips the buffer limit
+        }
+        
+        quint16 flags = qFromBigEndian<quint16>(m_receive_buffer.constData() + 6);
+        request_id = qFromBigEndian<quint32>(m_receive_buffer.constData() + 8);
+        if (flags & FRAME_FLAG_COMPRESSED)
+        {
+            // A frame that does not inflate is dropped like unparsable JSON; its request times out
+            const char* payload = m_receive_buffer.constData() + FRAME_HEADER_SIZE;
+            if (!m_decompressor ||
+                !m_decompressor->decompress(payload, static_cast<qsizetype>(length), Config::Server::MAX_FRAME_BYTES, message))
+            {
+                qWarning() << "Dropping compressed frame that could not be inflated, request" << request_id;
+                message.clear();
+            }
+        }
+        else
+        {
+            message = m_receive_buffer.mid(FRAME_HEADER_SIZE, static_cast<qsizetype>(length));
+        }
+        m_receive_buffer.remove(0, FRAME_HEADER_SIZE + static_cast<qsizetype>(length));
+        return true;
+    }
+    
+    int newlineIndex = m_receive_buffer.indexOf('\n');
+    if (newlineIndex == -1)
+    {
+        return false;
+    }
+    
+    request_id = 0; // Text lines carry it in the payload
+    message = m_receive_buffer.left(newlineIndex);
+    // Remove \r if present before \n
+    if (!message.isEmpty() && message.endsWith('\r'))
+    {
+        message.chop(1);
+    }
+    m_receive_buffer.remove(0, newlineIndex + 1);
+    return true;
+}
+
 void Api_Client::on_socket_error(QAbstractSocket::SocketError error)
 {
     handle_socket_error(error);
@@ -670,21 +949,59 @@ void Api_Client::on_socket_error(QAbstractSocket::SocketError error)
 
 void Api_Client::on_request_timeout()
 {
-    qWarning() << "Request timeout occurred for:" << request_type_to_string(m_current_request_type);
+    if (m_is_hello_pending)
+    {
+        // No HELLO reply, carry on with text lines
+        qWarning() << "HELLO timed out, keeping text framing";
+        m_is_hello_pending = false;
+        send_queued_requests();
+        return;
+    }
+    
+    // Only the expired requests fail; the connection might still be valid and the others
+    // can still be answered. A late response to an expired request is dropped.
+    qint64 now = m_clock.elapsed();
+    QList<Request_Type> expired;
+    bool is_resume_expired = false;
+    for (auto it = m_in_flight.begin(); it != m_in_flight.end();)
+    {
+        if (it->deadline_ms <= now)
+        {
+            qWarning() << "Request timeout occurred for:" << request_type_to_string(it->type) << "id" << it.key();
+            is_resume_expired = is_resume_expired || it->type == Request_Type::Resume_Session;
+            expired.append(it->type);
+            it = m_in_flight.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    arm_request_timer();
     
-    // Don't disconnect completely for request timeout, just emit error
-    // The connection might still be valid, just this specific request failed
-    emit_error("Request timeout - server did not respond in time");
+    for (Request_Type type : expired)
+    {
+        fail_request(type, "Request timeout - server did not respond in time");
+    }
     
-    // Clear pending request if any
+    if (is_resume_expired)
     {
-        QMutexLocker locker(&m_mutex);
-        m_pending_request.reset();
+        // Not tried again on this connection; the token is kept for the next one
+        m_is_session_resume_pending = false;
+        m_is_session_bound = true;
+        send_queued_requests();
     }
 }
 
-void Api_Client::handle_response(const QJsonObject& response)
+void Api_Client::handle_response(const QJsonObject& response, quint32 request_id)
 {
+    // Pushes answer no request, they are told apart by their type
+    if (response["type"].toString() == "OFFER_UPDATE")
+    {
+        emit offer_updates_received(response["data"].toArray());
+        return;
+    }
+    
     Api_Response api_response = parse_json_response(response);
     
     // Special handling for KEEPALIVE/PONG responses
@@ -693,29 +1010,62 @@ void Api_Client::handle_response(const QJsonObject& response)
         return; // No further processing needed for keepalive
     }
     
-    qDebug() << "Response received for:" << request_type_to_string(m_current_request_type);
+    if (request_id == 0)
+    {
+        request_id = response["request_id"].toVariant().toUInt();
+    }
+    
+    // A server that does not echo ids answers in order, so the oldest request is the one answered
+    auto it = request_id != 0 ? m_in_flight.find(request_id) : m_in_flight.begin();
+    if (it == m_in_flight.end())
+    {
+        qWarning() << "Dropping response for unknown or expired request" << request_id;
+        return;
+    }
+    
+    Request_Type type = it->type;
+    m_in_flight.erase(it);
+    arm_request_timer();
+    
+    qDebug() << "Response received for:" << request_type_to_string(type) << "id" << request_id;
     qDebug() << "Success:" << api_response.success;
     qDebug() << "Message:" << api_response.message;
     
+    // A server without offer pushes refuses the subscription, that is not an error for the user
+    if (type == Request_Type::Subscribe_Offers)
+    {
+        if (!api_response.success)
+        {
+            qWarning() << "Offer updates are not available:" << api_response.message;
+        }
+        emit request_completed(type, api_response);
+        return;
+    }
+    
+    if (type == Request_Type::Resume_Session)
+    {
+        finish_session_resume(api_response.success, api_response);
+        emit request_completed(type, api_response);
+        return;
+    }
+    
     if (api_response.success)
     {
-        if (m_current_request_type == Request_Type::Login || m_current_request_type == Request_Type::Register)
+        if (type == Request_Type::Login || type == Request_Type::Register)
         {
-            process_authentication_response(api_response);
+            process_authentication_response(type, api_response);
         }
         else
         {
-            process_data_response(m_current_request_type, api_response);
+            process_data_response(type, api_response);
         }
     }
     else
     {
-        QMutexLocker locker(&m_mutex);
-        m_last_error = api_response.message;
-        emit_error(api_response.message);
+        fail_request(type, api_response.message);
     }
     
-    emit request_completed(m_current_request_type, api_response);
+    emit request_completed(type, api_response);
 }
 
 Api_Client::Api_Response Api_Client::parse_json_response(const QJsonObject& json_response) const
@@ -729,31 +1079,31 @@ Api_Client::Api_Response Api_Client::parse_json_response(const QJsonObject& json
     return response;
 }
 
-void Api_Client::process_authentication_response(const Api_Response& response)
+void Api_Client::process_authentication_response(Request_Type type, const Api_Response& response)
 {
     if (response.success)
     {
         QJsonObject userData = response.data;
         
-        if (m_current_request_type == Request_Type::Login)
+        if (type == Request_Type::Login)
         {
+            // This connection is already logged in, only later ones resume with the token
+            if (userData.contains("session_token"))
+            {
+                QMutexLocker locker(&m_mutex);
+                m_auth_token = userData["session_token"].toString();
+                m_is_session_bound = true;
+            }
             emit login_success(userData);
         }
-        else if (m_current_request_type == Request_Type::Register)
+        else if (type == Request_Type::Register)
         {
             emit register_success();
         }
     }
     else
     {
-        if (m_current_request_type == Request_Type::Login)
-        {
-            emit login_failed(response.message);
-        }
-        else if (m_current_request_type == Request_Type::Register)
-        {
-            emit register_failed(response.message);
-        }
+        emit_request_failed(type, response.message);
     }
 }
 
@@ -776,13 +1126,25 @@ void Api_Client::process_data_response(Request_Type type, const Api_Response& re
         dataArray.append(response.data);
     }
     
+    // Versioned catalog replies are objects, older servers send the plain list
+    qint64 catalog_version = static_cast<qint64>(response.data["version"].toDouble());
+    
     switch (type)
     {
         case Request_Type::Get_Destinations:
-            emit destinations_received(dataArray);
+            if (catalog_version > 0)
+                emit destinations_catalog_received(catalog_version, response.data);
+            else
+                emit destinations_received(dataArray);
             break;
             
         case Request_Type::Get_Offers:
+            if (catalog_version > 0)
+                emit offers_catalog_received(catalog_version, response.data);
+            else
+                emit offers_received(dataArray);
+            break;
+            
         case Request_Type::Search_Offers:
             emit offers_received(dataArray);
             break;
@@ -838,6 +1200,9 @@ void Api_Client::handle_socket_error(QAbstractSocket::SocketError error)
     }
     
     emit_error(errorMsg);
+    
+    // Requests waiting for this connection fail with it instead of being sent on a later one
+    fail_in_flight_requests(errorMsg, true);
 }
 
 void Api_Client::emit_error(const QString& error_message)
@@ -849,9 +1214,43 @@ void Api_Client::emit_error(const QString& error_message)
     
     qWarning() << "Api_Client error:" << error_message;
     emit network_error(error_message);
+}
+
+void Api_Client::fail_request(Request_Type type, const QString& error_message)
+{
+    emit_error(error_message);
+    emit_request_failed(type, error_message);
+}
+
+void Api_Client::fail_in_flight_requests(const QString& error_message, bool include_queued)
+{
+    QList<Request_Type> failed;
+    for (auto it = m_in_flight.cbegin(); it != m_in_flight.cend(); ++it)
+    {
+        failed.append(it->type);
+    }
+    m_in_flight.clear();
+    m_timeout_timer->stop();
     
-    // Emit specific error signals based on current request type
-    switch (m_current_request_type)
+    if (include_queued)
+    {
+        for (const Queued_Request& request : m_queued_requests)
+        {
+            failed.append(request.type);
+        }
+        m_queued_requests.clear();
+    }
+    
+    for (Request_Type type : failed)
+    {
+        emit_request_failed(type, error_message);
+    }
+}
+
+void Api_Client::emit_request_failed(Request_Type type, const QString& error_message)
+{
+    // Specific error signals for the requests whose callers wait for one
+    switch (type)
     {
         case Request_Type::Login:
             emit login_failed(error_message);
@@ -884,10 +1283,33 @@ QString Api_Client::request_type_to_string(Request_Type type) const
         case Request_Type::Cancel_Reservation: return "Cancel_Reservation";
         case Request_Type::Get_User_Info: return "Get_User_Info";
         case Request_Type::Update_User_Info: return "Update_User_Info";
+        case Request_Type::Subscribe_Offers: return "Subscribe_Offers";
+        case Request_Type::Resume_Session: return "Resume_Session";
         default: return "Unknown";
     }
 }
 
+quint16 Api_Client::wire_type_for(const QString& type)
+{
+    // Same codes as the server's to_wire_type(); 0 leaves the type to the payload
+    if (type == "AUTH") return 1;
+    if (type == "REGISTER") return 2;
+    if (type == "GET_DESTINATIONS") return 3;
+    if (type == "GET_OFFERS") return 4;
+    if (type == "SEARCH_OFFERS") return 5;
+    if (type == "BOOK_OFFER") return 6;
+    if (type == "GET_USER_RESERVATIONS") return 7;
+    if (type == "CANCEL_RESERVATION") return 8;
+    if (type == "GET_USER_INFO") return 9;
+    if (type == "UPDATE_USER_INFO") return 10;
+    if (type == "KEEPALIVE") return 11;
+    if (type == "HELLO") return 12;
+    if (type == "SUBSCRIBE_OFFERS") return 14;
+    if (type == "RESUME_SESSION") return 16;
+    if (type == "LOGOUT") return 17;
+    return 0;
+}
+
 bool Api_Client::is_authentication_required(Request_Type type) const
 {
     switch (type)
@@ -897,6 +1319,8 @@ bool Api_Client::is_authentication_required(Request_Type type) const
         case Request_Type::Get_Destinations:
         case Request_Type::Get_Offers:
         case Request_Type::Search_Offers:
+        case Request_Type::Subscribe_Offers:
+        case Request_Type::Resume_Session:
             return false;
         default:
             return true;
@@ -0,0 +1,42 @@
+#include "network/Payload_Decompressor.h"
+#include "Offer_Dictionary.h" // common/include, the one copy shared with the server
+
+#include <zstd.h>
+
+#pragma comment(lib, "zstd.lib")
+
+const char* const Payload_Decompressor::DICTIONARY_NAME = Offer_Dictionary::NAME.text;
+
+Payload_Decompressor::Payload_Decompressor(bool use_dictionary)
+    : m_context(ZSTD_createDCtx())
+    , m_dictionary(use_dictionary ? ZSTD_createDDict(Offer_Dictionary::TEXT, Offer_Dictionary::SIZE) : nullptr)
+{
+}
+
+Payload_Decompressor::~Payload_Decompressor()
+{
+    ZSTD_freeDDict(m_dictionary);
+    ZSTD_freeDCtx(m_context);
+}
+
+bool Payload_Decompressor::decompress(const char* data, qsizetype size, qsizetype max_bytes, QByteArray& out)
+{
+    // The server always records the content size in the frame
+    unsigned long long content_size = ZSTD_getFrameContentSize(data, static_cast<size_t>(size));
+    if (!m_context || content_size == ZSTD_CONTENTSIZE_ERROR || content_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+        content_size > static_cast<unsigned long long>(max_bytes))
+    {
+        return false;
+    }
+
+    out.resize(static_cast<qsizetype>(content_size));
+    size_t read = m_dictionary ?
+        ZSTD_decompress_usingDDict(m_context, out.data(), static_cast<size_t>(out.size()), data, static_cast<size_t>(size), m_dictionary) :
+        ZSTD_decompressDCtx(m_context, out.data(), static_cast<size_t>(out.size()), data, static_cast<size_t>(size));
+    if (ZSTD_isError(read) || read != static_cast<size_t>(out.size()))
+    {
+        out.clear();
+        return false;
+    }
+    return true;
+}
@@ -1,5 +1,6 @@
 #include "ui/Destination_Card.h"
 #include "config.h"
+#include "utils/Image_Cache.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -33,6 +34,9 @@ Destination_Card::Destination_Card(QWidget* parent)
 {
     setup_ui();
     setup_animations();
+    
+    connect(&Image_Cache::instance(), &Image_Cache::image_ready,
+            this, &Destination_Card::on_image_ready);
 }
 
 Destination_Card::Destination_Card(const Destination_Model::Destination& destination, QWidget* parent)
@@ -270,21 +274,13 @@ void Destination_Card::load_destination_image()
         return;
     }
     
-    // Try to load image from path
-    QString imagePath = m_destination.image_path;
-    if (!imagePath.isEmpty() && QDir().exists(imagePath))
+    // Decoded on Image_Cache's pool; a cached thumbnail is shown right away
+    if (apply_image(Image_Cache::instance().request(m_destination.image_path, m_image_size)))
     {
-        QPixmap pixmap(imagePath);
-        if (!pixmap.isNull())
-        {
-            pixmap = pixmap.scaled(m_image_size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-            m_image_label->setPixmap(pixmap);
-            m_image_label->setStyleSheet("border: none;");
-            return;
-        }
+        return;
     }
     
-    // Use emoji based on destination name or country
+    // Until then, or without a picture: emoji based on destination name or country
     QString emoji = QString::fromUtf8("🏖️"); // Default
     QString name = m_destination.name.toLower();
     QString country = m_destination.country.toLower();
@@ -315,6 +311,27 @@ void Destination_Card::load_destination_image()
     m_image_label->setText(emoji);
 }
 
+bool Destination_Card::apply_image(const QPixmap& pixmap)
+{
+    if (!m_image_label || pixmap.isNull())
+    {
+        return false;
+    }
+    
+    m_image_label->setPixmap(pixmap);
+    m_image_label->setStyleSheet("border: none;");
+    return true;
+}
+
+void Destination_Card::on_image_ready(const QString& path, const QSize& size)
+{
+    if (path != m_destination.image_path || size != m_image_size)
+    {
+        return;
+    }
+    apply_image(Image_Cache::instance().request(path, size));
+}
+
 void Destination_Card::enterEvent(QEnterEvent* event)
 {
     QWidget::enterEvent(event);
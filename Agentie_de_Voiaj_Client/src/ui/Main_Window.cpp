@@ -6,6 +6,9 @@
 #include "models/Offer_Model.h"
 #include "models/Reservation_Model.h"
 #include "utils/Style_Manager.h"
+#include "ui/Offer_Delegate.h"
+#include "ui/Destination_Card.h"
+#include "utils/Image_Cache.h"
 #include "config.h"
 
 #include <QApplication>
@@ -21,12 +24,15 @@
 #include <QTimer>
 #include <QGroupBox>
 #include <QScrollArea>
+#include <QScrollBar>
 
 Main_Window::Main_Window(QWidget *parent)
     : QMainWindow(parent)
     , m_central_widget(nullptr)
     , m_tab_widget(nullptr)
     , m_destinations_tab(nullptr)
+    , m_destinations_content(nullptr)
+    , m_destinations_grid_layout(nullptr)
     , m_offers_tab(nullptr)
     , m_reservations_tab(nullptr)
     , m_profile_tab(nullptr)
@@ -54,8 +60,7 @@ Main_Window::Main_Window(QWidget *parent)
     , m_destination_model(std::make_unique<Destination_Model>(this))
     , m_offer_model(std::make_unique<Offer_Model>(this))
     , m_reservation_model(std::make_unique<Reservation_Model>(this))
-    , m_offers_container(nullptr)
-    , m_offers_container_layout(nullptr)
+    , m_offers_view(nullptr)
     , m_offers_loading_label(nullptr)
     , m_offers_no_offers_label(nullptr)
     , m_reservations_auth_widget(nullptr)
@@ -99,8 +104,9 @@ Main_Window::Main_Window(QWidget *parent)
     // Initialize with login prompt
     show_login_prompt();
     
-    // Load destinations
+    // Load destinations and offers; both requests are pipelined on the connection being opened
     m_destination_model->refresh_destinations();
+    m_offer_model->refresh_offers();
     
     setWindowTitle("Agentie de Voiaj");
     setMinimumSize(800, 600);
@@ -281,6 +287,11 @@ void Main_Window::create_destinations_tab()
     scrollArea->setWidgetResizable(true);
     layout->addWidget(scrollArea);
     
+    // Replaced by the real cards once the destinations arrive
+    m_destinations_content = scrollContent;
+    m_destinations_grid_layout = gridLayout;
+    m_destinations_content->installEventFilter(this);
+    
     m_tab_widget->addTab(m_destinations_tab, "Destinații");
 }
 
@@ -404,9 +415,7 @@ void Main_Window::create_offers_tab()
     layout->addLayout(searchLayout);
     
     // Offers list
-    QScrollArea* scrollArea = new QScrollArea();
-    QWidget* scrollContent = new QWidget();
-    QVBoxLayout* offersLayout = new QVBoxLayout(scrollContent);
+    QVBoxLayout* offersLayout = new QVBoxLayout();
     
     // Loading indicator
     QLabel* loadingLabel = new QLabel("Se încarcă ofertele...");
@@ -421,19 +430,31 @@ void Main_Window::create_offers_tab()
     noOffersLabel->hide();
     offersLayout->addWidget(noOffersLabel);
     
-    // Offers container
-    QWidget* offersContainer = new QWidget();
-    QVBoxLayout* offersContainerLayout = new QVBoxLayout(offersContainer);
-    offersContainerLayout->setSpacing(15);
-    offersLayout->addWidget(offersContainer);
-    
-    scrollArea->setWidget(scrollContent);
-    scrollArea->setWidgetResizable(true);
-    layout->addWidget(scrollArea);
+    // Cards are painted by the delegate straight from the model: only the visible rows
+    // cost anything, and seat pushes repaint their row without touching the others
+    QListView* offersView = new QListView();
+    Offer_Delegate* offerDelegate = new Offer_Delegate(offersView);
+    offersView->setModel(m_offer_model.get());
+    offersView->setItemDelegate(offerDelegate);
+    offersView->setUniformItemSizes(true);
+    offersView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    offersView->verticalScrollBar()->setSingleStep(20);
+    offersView->setSelectionMode(QAbstractItemView::NoSelection);
+    offersView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    offersView->setMouseTracking(true); // Hover border
+    offersView->setFrameShape(QFrame::NoFrame);
+    offersView->setStyleSheet("QListView { background: transparent; }");
+    connect(offerDelegate, &Offer_Delegate::book_now_clicked, this, &Main_Window::on_offer_book_clicked);
+    connect(&Image_Cache::instance(), &Image_Cache::image_ready, offersView, [offersView](const QString&, const QSize& size) {
+        if (size == Offer_Delegate::image_size()) {
+            offersView->viewport()->update();
+        }
+    });
+    offersLayout->addWidget(offersView, 1);
+    layout->addLayout(offersLayout, 1);
     
     // Store references for later use
-    m_offers_container = offersContainer;
-    m_offers_container_layout = offersContainerLayout;
+    m_offers_view = offersView;
     m_offers_loading_label = loadingLabel;
     m_offers_no_offers_label = noOffersLabel;
     
@@ -1078,6 +1099,7 @@ void Main_Window::on_authentication_status_changed(bool is_authenticated)
 void Main_Window::on_destinations_loaded()
 {
     m_status_bar->showMessage("Destinații încărcate cu succes", 3000);
+    refresh_destinations_display();
 }
 
 void Main_Window::on_offers_loaded()
@@ -1215,23 +1237,57 @@ void Main_Window::show_loading_indicator(bool show)
 
 void Main_Window::refresh_offers_display()
 {
-    if (!m_offers_container_layout || !m_offer_model) {
+    if (!m_offers_view || !m_offer_model) {
         return;
     }
     
-    // Clear existing offers
+    // The view follows the model's reset on its own, only the empty state is ours
+    m_offers_view->setVisible(m_offer_model->get_offer_count() > 0);
+}
+
+void Main_Window::on_offer_book_clicked(int offer_id)
+{
+    if (!m_offer_model) {
+        return;
+    }
+    
+    // TODO: Open booking dialog
+    Offer_Model::Offer offer = m_offer_model->get_offer_by_id(offer_id);
+    QMessageBox::information(this, "Rezervare", 
+        QString("Rezervare pentru oferta: %1").arg(offer.name));
+}
+
+void Main_Window::refresh_destinations_display()
+{
+    if (!m_destinations_grid_layout || !m_destination_model) {
+        return;
+    }
+    
+    m_destinations_paint_timer.start();
+    
     QLayoutItem* item;
-    while ((item = m_offers_container_layout->takeAt(0)) != nullptr) {
+    while ((item = m_destinations_grid_layout->takeAt(0)) != nullptr) {
         delete item->widget();
         delete item;
     }
     
-    // Add new offers
-    const auto& offers = m_offer_model->get_offers();
-    for (const auto& offer : offers) {
-        QWidget* offerCard = create_offer_card(offer);
-        m_offers_container_layout->addWidget(offerCard);
+    // Pictures are decoded by Image_Cache off this thread, the cards start with a placeholder
+    const auto& destinations = m_destination_model->get_destinations();
+    for (int i = 0; i < destinations.size(); ++i) {
+        Destination_Card* card = new Destination_Card(destinations[i]);
+        m_destinations_grid_layout->addWidget(card, i / 3, i % 3);
+    }
+}
+
+bool Main_Window::eventFilter(QObject* watched, QEvent* event)
+{
+    // Time to first paint of the destinations grid, logged once per rebuild
+    if (watched == m_destinations_content && event->type() == QEvent::Paint && m_destinations_paint_timer.isValid()) {
+        qDebug() << "Destinations tab first paint after" << m_destinations_paint_timer.elapsed() << "ms for"
+                 << (m_destination_model ? m_destination_model->get_destination_count() : 0) << "destinations";
+        m_destinations_paint_timer.invalidate();
     }
+    return QMainWindow::eventFilter(watched, event);
 }
 
 void Main_Window::refresh_reservations_display()
@@ -1255,71 +1311,6 @@ void Main_Window::refresh_reservations_display()
     }
 }
 
-QWidget* Main_Window::create_offer_card(const Offer_Model::Offer& offer)
-{
-    QWidget* offerCard = new QWidget();
-    offerCard->setFixedHeight(150);
-    offerCard->setStyleSheet(
-        "QWidget { "
-        "background-color: white; "
-        "border: 1px solid #e0e0e0; "
-        "border-radius: 8px; "
-        "margin: 5px; "
-        "} "
-        "QWidget:hover { "
-        "border-color: #4a90e2; "
-        "box-shadow: 0 2px 8px rgba(0,0,0,0.1); "
-        "}"
-    );
-    
-    QHBoxLayout* offerLayout = new QHBoxLayout(offerCard);
-    
-    // Image placeholder
-    QLabel* imageLabel = new QLabel("🏖️");
-    imageLabel->setFixedSize(120, 120);
-    imageLabel->setAlignment(Qt::AlignCenter);
-    imageLabel->setStyleSheet("background-color: #f8f9fa; border-radius: 4px; font-size: 32px;");
-    offerLayout->addWidget(imageLabel);
-    
-    // Offer details
-    QVBoxLayout* detailsLayout = new QVBoxLayout();
-    
-    QLabel* titleLabel = new QLabel(offer.name);
-    titleLabel->setStyleSheet("font-weight: bold; font-size: 18px;");
-    detailsLayout->addWidget(titleLabel);
-    
-    QLabel* descLabel = new QLabel(offer.description);
-    descLabel->setWordWrap(true);
-    detailsLayout->addWidget(descLabel);
-    
-    QLabel* priceLabel = new QLabel(QString("€%1/persoană").arg(offer.price_per_person));
-    priceLabel->setStyleSheet("font-weight: bold; font-size: 16px; color: #e74c3c;");
-    detailsLayout->addWidget(priceLabel);
-    
-    detailsLayout->addStretch();
-    offerLayout->addLayout(detailsLayout);
-    
-    // Actions
-    QVBoxLayout* actionsLayout = new QVBoxLayout();
-    actionsLayout->addStretch();
-    
-    QPushButton* bookButton = new QPushButton("Rezervă Acum");
-    bookButton->setStyleSheet("background-color: #27ae60; color: white; font-weight: bold;");
-    connect(bookButton, &QPushButton::clicked, [this, offer_id = offer.id, offer_name = offer.name]() {
-        // TODO: Open booking dialog
-        QMessageBox::information(this, "Rezervare", 
-            QString("Rezervare pentru oferta: %1").arg(offer_name));
-    });
-    actionsLayout->addWidget(bookButton);
-    
-    QPushButton* detailsButton = new QPushButton("Detalii");
-    actionsLayout->addWidget(detailsButton);
-    
-    offerLayout->addLayout(actionsLayout);
-    
-    return offerCard;
-}
-
 QWidget* Main_Window::create_reservation_card(const Reservation_Model::Reservation& reservation)
 {
     QWidget* reservationCard = new QWidget();
@@ -1374,16 +1365,6 @@ QWidget* Main_Window::create_reservation_card(const Reservation_Model::Reservati
     return reservationCard;
 }
 
-QWidget* Main_Window::create_offer_card(const int offer_index)
-{
-    if (!m_offer_model || offer_index < 0 || offer_index >= m_offer_model->get_offer_count()) {
-        return nullptr;
-    }
-    
-    Offer_Model::Offer offer = m_offer_model->get_offer(offer_index);
-    return create_offer_card(offer);
-}
-
 QWidget* Main_Window::create_reservation_card(const int reservation_index)
 {
     if (!m_reservation_model || reservation_index < 0 || reservation_index >= m_reservation_model->get_reservation_count()) {
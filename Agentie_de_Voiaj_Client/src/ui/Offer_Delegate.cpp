@@ -0,0 +1,196 @@
+#include "ui/Offer_Delegate.h"
+#include "models/Offer_Model.h"
+#include "utils/Image_Cache.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QMouseEvent>
+#include <QFontMetrics>
+
+namespace
+{
+    constexpr int CARD_MARGIN = 5;
+    constexpr int CARD_RADIUS = 8;
+    constexpr int IMAGE_SIZE = 120;
+    constexpr int PADDING = 10;
+    constexpr int BUTTON_WIDTH = 120;
+    constexpr int BUTTON_HEIGHT = 30;
+}
+
+Offer_Delegate::Offer_Delegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void Offer_Delegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!index.isValid())
+    {
+        return;
+    }
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    // Card background; a hovered card gets the accent border the widget cards had
+    QRect card = card_rect(option.rect);
+    bool is_hovered = option.state & QStyle::State_MouseOver;
+    QPainterPath card_path;
+    card_path.addRoundedRect(card, CARD_RADIUS, CARD_RADIUS);
+    painter->fillPath(card_path, QColor("#ffffff"));
+    painter->setPen(QPen(QColor(is_hovered ? "#4a90e2" : "#e0e0e0"), 1));
+    painter->drawPath(card_path);
+
+    // Picture from Image_Cache, a placeholder until its job is done (see image_size())
+    QRect image(card.left() + PADDING, card.top() + (card.height() - IMAGE_SIZE) / 2, IMAGE_SIZE, IMAGE_SIZE);
+    QPainterPath image_path;
+    image_path.addRoundedRect(image, 4, 4);
+    QPixmap picture = Image_Cache::instance().request(index.data(Offer_Model::Image_Role).toString(), image_size());
+    painter->setPen(QColor("#2c3e50"));
+    if (!picture.isNull())
+    {
+        painter->save();
+        painter->setClipPath(image_path);
+        painter->drawPixmap(image, picture);
+        painter->restore();
+    }
+    else
+    {
+        painter->fillPath(image_path, QColor("#f8f9fa"));
+        QFont emoji_font = option.font;
+        emoji_font.setPixelSize(32);
+        painter->setFont(emoji_font);
+        painter->drawText(image, Qt::AlignCenter, QStringLiteral("🏖️"));
+    }
+
+    // Details between the image and the buttons
+    int text_left = image.right() + PADDING * 2;
+    int text_right = book_button_rect(card).left() - PADDING * 2;
+    QRect text_area(text_left, card.top() + PADDING, qMax(0, text_right - text_left), card.height() - PADDING * 2);
+
+    QFont title_font = option.font;
+    title_font.setPixelSize(18);
+    title_font.setBold(true);
+    QFontMetrics title_metrics(title_font);
+    QString name = index.data(Offer_Model::Name_Role).toString();
+    painter->setFont(title_font);
+    painter->drawText(QRect(text_area.left(), text_area.top(), text_area.width(), title_metrics.height()),
+                      Qt::AlignLeft | Qt::AlignVCenter, title_metrics.elidedText(name, Qt::ElideRight, text_area.width()));
+
+    QFont body_font = option.font;
+    body_font.setPixelSize(13);
+    QFontMetrics body_metrics(body_font);
+    painter->setFont(body_font);
+    painter->setPen(QColor("#7f8c8d"));
+    int line_top = text_area.top() + title_metrics.height() + 4;
+    QString destination = index.data(Offer_Model::Destination_Role).toString();
+    int duration = index.data(Offer_Model::Duration_Role).toInt();
+    QString subtitle = duration > 0 ? QString("%1 · %2 zile").arg(destination).arg(duration) : destination;
+    painter->drawText(QRect(text_area.left(), line_top, text_area.width(), body_metrics.height()),
+                      Qt::AlignLeft | Qt::AlignVCenter, body_metrics.elidedText(subtitle, Qt::ElideRight, text_area.width()));
+
+    // Description: wrapped, whatever does not fit in two lines is clipped
+    line_top += body_metrics.height() + 4;
+    painter->setPen(QColor("#2c3e50"));
+    QString description = index.data(Offer_Model::Description_Role).toString().simplified();
+    painter->drawText(QRect(text_area.left(), line_top, text_area.width(), body_metrics.lineSpacing() * 2),
+                      Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, description);
+
+    // Price and seats along the bottom
+    QFont price_font = option.font;
+    price_font.setPixelSize(16);
+    price_font.setBold(true);
+    QFontMetrics price_metrics(price_font);
+    int bottom_top = text_area.bottom() - price_metrics.height();
+    painter->setFont(price_font);
+    painter->setPen(QColor("#e74c3c"));
+    QString price = QString("€%1/persoană").arg(index.data(Offer_Model::Price_Role).toDouble());
+    painter->drawText(QRect(text_area.left(), bottom_top, text_area.width(), price_metrics.height()),
+                      Qt::AlignLeft | Qt::AlignVCenter, price);
+
+    int seats = index.data(Offer_Model::Available_Seats_Role).toInt();
+    painter->setFont(body_font);
+    painter->setPen(QColor(seats > 0 ? "#27ae60" : "#e74c3c"));
+    painter->drawText(QRect(text_area.left(), bottom_top, text_area.width(), price_metrics.height()),
+                      Qt::AlignRight | Qt::AlignVCenter, seats > 0 ? QString("%1 locuri libere").arg(seats) : QString("Epuizat"));
+
+    paint_button(painter, book_button_rect(card), "Rezervă Acum", QColor("#27ae60"), QColor("#ffffff"));
+    paint_button(painter, details_button_rect(card), "Detalii", QColor("#ecf0f1"), QColor("#2c3e50"));
+
+    painter->restore();
+}
+
+QSize Offer_Delegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(index)
+    // Every row has the same height, so the view can use uniform item sizes
+    return QSize(option.rect.width(), CARD_HEIGHT + CARD_SPACING);
+}
+
+QSize Offer_Delegate::image_size()
+{
+    return QSize(IMAGE_SIZE, IMAGE_SIZE);
+}
+
+QRect Offer_Delegate::book_button_rect(const QRect& card_rect)
+{
+    return QRect(card_rect.right() - PADDING - BUTTON_WIDTH,
+                 card_rect.center().y() - BUTTON_HEIGHT - 3, BUTTON_WIDTH, BUTTON_HEIGHT);
+}
+
+QRect Offer_Delegate::details_button_rect(const QRect& card_rect)
+{
+    return QRect(card_rect.right() - PADDING - BUTTON_WIDTH,
+                 card_rect.center().y() + 3, BUTTON_WIDTH, BUTTON_HEIGHT);
+}
+
+bool Offer_Delegate::editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option,
+                                 const QModelIndex& index)
+{
+    if (event->type() != QEvent::MouseButtonRelease || !index.isValid())
+    {
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+
+    auto* mouse_event = static_cast<QMouseEvent*>(event);
+    if (mouse_event->button() != Qt::LeftButton)
+    {
+        return false;
+    }
+
+    QRect card = card_rect(option.rect);
+    QPoint position = mouse_event->position().toPoint();
+    int offer_id = index.data(Offer_Model::Id_Role).toInt();
+    if (book_button_rect(card).contains(position))
+    {
+        emit book_now_clicked(offer_id);
+        return true;
+    }
+    if (details_button_rect(card).contains(position))
+    {
+        emit view_details_clicked(offer_id);
+        return true;
+    }
+    return false;
+}
+
+QRect Offer_Delegate::card_rect(const QRect& item_rect)
+{
+    // The spacing below each card is part of its row
+    return QRect(item_rect.left() + CARD_MARGIN, item_rect.top() + CARD_MARGIN,
+                 item_rect.width() - CARD_MARGIN * 2, CARD_HEIGHT - CARD_MARGIN * 2);
+}
+
+void Offer_Delegate::paint_button(QPainter* painter, const QRect& rect, const QString& text,
+                                  const QColor& background, const QColor& foreground) const
+{
+    QPainterPath path;
+    path.addRoundedRect(rect, 4, 4);
+    painter->fillPath(path, background);
+
+    QFont font = painter->font();
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(foreground);
+    painter->drawText(rect, Qt::AlignCenter, text);
+}
@@ -0,0 +1,164 @@
+#include "utils/Image_Cache.h"
+#include "config.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+Image_Cache& Image_Cache::instance()
+{
+    // Deleted with the application, the pool is drained before the GUI goes away
+    static Image_Cache* s_instance = new Image_Cache(QCoreApplication::instance());
+    return *s_instance;
+}
+
+Image_Cache::Image_Cache(QObject* parent)
+    : QObject(parent)
+{
+    m_pixmaps.setMaxCost(Config::Cache::IMAGE_MEMORY_CACHE_MB * 1024);
+
+    // One core stays free for the GUI thread
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+Image_Cache::~Image_Cache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QPixmap Image_Cache::request(const QString& path, const QSize& size)
+{
+    if (path.isEmpty() || size.isEmpty())
+    {
+        return QPixmap();
+    }
+
+    QString key = cache_key(path, size);
+    if (QPixmap* cached = m_pixmaps.object(key))
+    {
+        return *cached;
+    }
+    if (m_pending.contains(key) || m_missing.contains(key))
+    {
+        return QPixmap();
+    }
+
+    // QPixmap belongs to the GUI thread, the job hands back a QImage
+    m_pending.insert(key);
+    m_pool.start([this, path, size]() {
+        QImage image = load_thumbnail(path, size);
+        QMetaObject::invokeMethod(this, [this, path, size, image]() {
+            on_image_loaded(path, size, image);
+        }, Qt::QueuedConnection);
+    });
+    return QPixmap();
+}
+
+void Image_Cache::clear_memory()
+{
+    m_pixmaps.clear();
+    m_missing.clear();
+}
+
+QImage Image_Cache::load_scaled(const QString& path, const QSize& size)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    // Decoded straight at the size that covers the card: JPEG skips most of the work
+    QSize original = reader.size();
+    if (original.isValid())
+    {
+        reader.setScaledSize(original.scaled(size, Qt::KeepAspectRatioByExpanding));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull())
+    {
+        return image;
+    }
+
+    QSize covering = image.size().scaled(size, Qt::KeepAspectRatioByExpanding);
+    if (image.size() != covering)
+    {
+        image = image.scaled(covering, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QRect visible((image.width() - size.width()) / 2, (image.height() - size.height()) / 2,
+                  size.width(), size.height());
+    return image.copy(visible).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+QString Image_Cache::cache_key(const QString& path, const QSize& size)
+{
+    return QString("%1|%2x%3").arg(path).arg(size.width()).arg(size.height());
+}
+
+QString Image_Cache::thumbnail_path(const QString& path, const QSize& size)
+{
+    // A changed file gets a new name, the stale thumbnail is simply never read again
+    QFileInfo info(path);
+    QByteArray identity = QString("%1|%2|%3x%4")
+        .arg(info.absoluteFilePath())
+        .arg(info.lastModified().toMSecsSinceEpoch())
+        .arg(size.width())
+        .arg(size.height())
+        .toUtf8();
+    QString name = QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex() + ".png";
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails/" + name;
+}
+
+QImage Image_Cache::load_thumbnail(const QString& path, const QSize& size)
+{
+    if (!QFileInfo::exists(path))
+    {
+        return QImage();
+    }
+
+    QString thumbnail = Config::Cache::USE_THUMBNAIL_DISK_CACHE ? thumbnail_path(path, size) : QString();
+    if (!thumbnail.isEmpty())
+    {
+        QImage cached(thumbnail);
+        if (cached.size() == size)
+        {
+            return cached.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+    }
+
+    QImage image = load_scaled(path, size);
+    if (!image.isNull() && !thumbnail.isEmpty())
+    {
+        // Written under a temporary name and renamed, a reader never sees half a file
+        QDir().mkpath(QFileInfo(thumbnail).absolutePath());
+        QSaveFile file(thumbnail);
+        if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit())
+        {
+            qWarning() << "Image_Cache: could not write thumbnail for" << path;
+        }
+    }
+    return image;
+}
+
+void Image_Cache::on_image_loaded(const QString& path, const QSize& size, const QImage& image)
+{
+    QString key = cache_key(path, size);
+    m_pending.remove(key);
+
+    if (image.isNull())
+    {
+        m_missing.insert(key);
+        return;
+    }
+
+    int cost_kb = qMax<qsizetype>(1, image.sizeInBytes() / 1024);
+    m_pixmaps.insert(key, new QPixmap(QPixmap::fromImage(image)), cost_kb);
+    emit image_ready(path, size);
+}
@@ -4,13 +4,19 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QTimer>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QJsonDocument>
 #include <memory>
 
 // Include test headers
 #include "models/Offer_Model.h"
+#include "models/Offer_Cache.h"
 #include "models/Reservation_Model.h"
 #include "network/Api_Client.h"
 #include "ui/Main_Window.h"
+#include "ui/Offer_Delegate.h"
+#include "utils/Image_Cache.h"
 #include "core/Application.h"
 
 // Mock API Client for testing
@@ -214,6 +220,74 @@ private slots:
         QCOMPARE(new_model->rowCount(), 2); // Should load from cache
     }
     
+    void test_offer_cache_startup_20k() {
+        QTemporaryDir dir;
+        Offer_Cache cache(dir.filePath("offers.cache"));
+        
+        QVector<Offer_Model::Offer> offers(20000);
+        QJsonArray legacy;
+        for (int i = 0; i < offers.size(); ++i) {
+            Offer_Model::Offer& offer = offers[i];
+            offer.id = i + 1;
+            offer.name = QString("Offer %1").arg(i);
+            offer.destination = "Brașov";
+            offer.price_per_person = 100.5 + i;
+            offer.duration_days = 7;
+            offer.available_seats = i % 40;
+            offer.description = "Seven nights, half board, transfer included";
+            offer.image_path = QString("images/offer_%1.jpg").arg(i % 50);
+            offer.status = "Available";
+            offer.start_date = QDateTime::fromMSecsSinceEpoch(1700000000000LL + i);
+            legacy.append(QJsonObject{{"Offer_ID", offer.id}, {"Name", offer.name}, {"Destination", offer.destination},
+                                      {"Price_per_Person", offer.price_per_person}, {"Description", offer.description},
+                                      {"Image_Path", offer.image_path}, {"Status", offer.status}});
+        }
+        QVERIFY(cache.write_all(offers, 42));
+        QByteArray legacy_blob = QJsonDocument(legacy).toJson(QJsonDocument::Compact);
+        
+        // Startup path before: parse the whole JSON blob
+        QElapsedTimer timer;
+        timer.start();
+        QCOMPARE(QJsonDocument::fromJson(legacy_blob).array().size(), 20000);
+        qint64 json_ms = timer.elapsed();
+        
+        // Startup path now: map, check the header, read the ids, decode one screen of rows
+        timer.restart();
+        QVERIFY(cache.open(24LL * 60 * 60 * 1000));
+        QCOMPARE(cache.record_count(), 20000);
+        QCOMPARE(cache.catalog_version(), qint64(42));
+        qint64 id_sum = 0;
+        for (int i = 0; i < cache.record_count(); ++i)
+            id_sum += cache.record_id(i);
+        for (int i = 0; i < 10; ++i)
+            cache.read(i);
+        qint64 mapped_ms = timer.elapsed();
+        qDebug() << "20k offers at startup: JSON" << json_ms << "ms, mapped cache" << mapped_ms << "ms";
+        QCOMPARE(id_sum, qint64(20000) * 20001 / 2);
+        
+        Offer_Model::Offer last = cache.read(19999);
+        QCOMPARE(last.name, QString("Offer 19999"));
+        QCOMPARE(last.destination, QString("Brașov"));
+        QCOMPARE(last.price_per_person, 100.5 + 19999);
+        QCOMPARE(last.start_date, offers[19999].start_date);
+        QVERIFY(!last.end_date.isValid());
+        
+        // Seat and status changes are patched into the file, no rewrite
+        Offer_Model::Offer after = last;
+        after.available_seats = 0;
+        after.status = "Sold out";
+        cache.close();
+        QVERIFY(cache.update_record(19999, last, after));
+        QVERIFY(cache.open(24LL * 60 * 60 * 1000));
+        QCOMPARE(cache.read(19999).available_seats, 0);
+        QCOMPARE(cache.read(19999).status, QString("Sold out"));
+        QCOMPARE(cache.read(19998).status, QString("Available"));
+        
+        // Too old is the same as missing
+        QTest::qSleep(5);
+        QVERIFY(!cache.open(1));
+    }
+    
     void cleanupTestCase() {
         // Cleanup test environment
     }
@@ -342,6 +416,20 @@ private slots:
         // Test offer booking
     }
     
+    void test_offer_delegate_layout() {
+        Offer_Delegate delegate;
+        QStyleOptionViewItem option;
+        option.rect = QRect(0, 0, 800, 0);
+        
+        // Uniform rows, and the painted buttons sit inside the card without overlapping
+        QCOMPARE(delegate.sizeHint(option, QModelIndex()).height(), Offer_Delegate::CARD_HEIGHT + Offer_Delegate::CARD_SPACING);
+        QRect card(5, 5, 790, Offer_Delegate::CARD_HEIGHT - 10);
+        QRect book = Offer_Delegate::book_button_rect(card);
+        QRect details = Offer_Delegate::details_button_rect(card);
+        QVERIFY(card.contains(book) && card.contains(details));
+        QVERIFY(!book.intersects(details));
+    }
+    
     void test_main_window_reservation_display() {
         auto window = std::make_unique<Main_Window>();
         
@@ -351,6 +439,29 @@ private slots:
     }
 };
 
+// Test class for Image_Cache
+class TestImageCache : public QObject {
+    Q_OBJECT
+    
+private slots:
+    void test_image_cache_scaled_and_async() {
+        QTemporaryDir dir;
+        QString path = dir.filePath("wide.png");
+        QImage source(800, 200, QImage::Format_RGB32);
+        source.fill(Qt::blue);
+        QVERIFY(source.save(path));
+        
+        // Filled and cropped to the card, whatever the source aspect ratio
+        QCOMPARE(Image_Cache::load_scaled(path, QSize(280, 120)).size(), QSize(280, 120));
+        
+        // First request only starts the job, the next one is served from memory
+        QSignalSpy ready(&Image_Cache::instance(), &Image_Cache::image_ready);
+        QVERIFY(Image_Cache::instance().request(path, QSize(120, 120)).isNull());
+        QVERIFY(ready.wait(5000));
+        QCOMPARE(Image_Cache::instance().request(path, QSize(120, 120)).size(), QSize(120, 120));
+    }
+};
+
 // Test class for Api_Client
 class TestApiClient : public QObject {
     Q_OBJECT
@@ -384,6 +495,7 @@ int main(int argc, char *argv[]) {
     TestOfferModel testOfferModel;
     TestReservationModel testReservationModel;
     TestMainWindow testMainWindow;
+    TestImageCache testImageCache;
     TestApiClient testApiClient;
     
     int result = 0;
@@ -391,6 +503,7 @@ int main(int argc, char *argv[]) {
     result += QTest::qExec(&testOfferModel, argc, argv);
     result += QTest::qExec(&testReservationModel, argc, argv);
     result += QTest::qExec(&testMainWindow, argc, argv);
+    result += QTest::qExec(&testImageCache, argc, argv);
     result += QTest::qExec(&testApiClient, argc, argv);
     
     return result;
@@ -7,6 +7,8 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QThread>
+#include <QElapsedTimer>
+#include <QPointer>
 #include <memory>
 
 // Include test headers
@@ -446,6 +448,151 @@ private:
     std::unique_ptr<MockTcpServer> mock_server;
 };
 
+// Answers every request after a per-type delay and echoes its request_id, so pipelined
+// requests are outstanding together and their responses come back out of order
+class DelayedMockServer : public QObject {
+    Q_OBJECT
+public:
+    DelayedMockServer(QObject* parent = nullptr) : QObject(parent), tcp_server(new QTcpServer(this)) {
+        connect(tcp_server, &QTcpServer::newConnection, this, &DelayedMockServer::handle_new_connection);
+    }
+    
+    bool start() {
+        return tcp_server->listen(QHostAddress::LocalHost, 0);
+    }
+    
+    int get_port() const {
+        return tcp_server->serverPort();
+    }
+    
+    void set_delay(const QString& message_type, int delay_ms) {
+        delays[message_type] = delay_ms;
+    }
+    
+    int get_peak_in_flight() const {
+        return peak_in_flight;
+    }
+    
+private slots:
+    void handle_new_connection() {
+        QTcpSocket* client_socket = tcp_server->nextPendingConnection();
+        if (!client_socket) {
+            return;
+        }
+        
+        auto buffer = std::make_shared<QByteArray>();
+        connect(client_socket, &QTcpSocket::readyRead, [this, client_socket, buffer]() {
+            buffer->append(client_socket->readAll());
+            int newline;
+            while ((newline = buffer->indexOf('\n')) != -1) {
+                QByteArray line = buffer->left(newline).trimmed();
+                buffer->remove(0, newline + 1);
+                if (!line.isEmpty()) {
+                    handle_request(client_socket, QJsonDocument::fromJson(line).object());
+                }
+            }
+        });
+        connect(client_socket, &QTcpSocket::disconnected, client_socket, &QObject::deleteLater);
+    }
+    
+private:
+    void handle_request(QTcpSocket* client_socket, const QJsonObject& request) {
+        QString message_type = request["type"].toString();
+        
+        QJsonObject response;
+        response["success"] = true;
+        response["message"] = message_type;
+        
+        if (message_type == "HELLO") {
+            // Stay on text lines
+            response["data"] = QJsonObject{{"framing", "text"}};
+            write_response(client_socket, response);
+            return;
+        }
+        
+        QJsonObject item;
+        item["id"] = 1;
+        item["name"] = message_type;
+        response["data"] = QJsonObject{{"data", QJsonArray{item}}};
+        response["request_id"] = request["request_id"];
+        
+        in_flight++;
+        peak_in_flight = qMax(peak_in_flight, in_flight);
+        
+        QPointer<QTcpSocket> target(client_socket);
+        QTimer::singleShot(delays.value(message_type, 0), this, [this, target, response]() {
+            in_flight--;
+            if (target) {
+                write_response(target, response);
+            }
+        });
+    }
+    
+    void write_response(QTcpSocket* client_socket, const QJsonObject& response) {
+        client_socket->write(QJsonDocument(response).toJson(QJsonDocument::Compact) + "\r\n");
+    }
+    
+    QTcpServer* tcp_server;
+    QHash<QString, int> delays;
+    int in_flight = 0;
+    int peak_in_flight = 0;
+};
+
+// Cold start: time from opening Main_Window until destinations and offers are both loaded
+class TestColdStart : public QObject {
+    Q_OBJECT
+    
+private slots:
+    void initTestCase() {
+        mock_server = std::make_unique<DelayedMockServer>();
+        mock_server->set_delay("GET_DESTINATIONS", DESTINATIONS_DELAY_MS);
+        mock_server->set_delay("GET_OFFERS", OFFERS_DELAY_MS);
+        QVERIFY(mock_server->start());
+        
+        Api_Client::instance().set_server_url("127.0.0.1", mock_server->get_port());
+    }
+    
+    void test_cold_start_to_populated_main_window() {
+        Api_Client& api_client = Api_Client::instance();
+        QSignalSpy connectedSpy(&api_client, &Api_Client::connection_status_changed);
+        
+        QStringList arrival_order;
+        connect(&api_client, &Api_Client::destinations_received, this, [&arrival_order]() {
+            arrival_order.append("destinations");
+        });
+        connect(&api_client, &Api_Client::offers_received, this, [&arrival_order]() {
+            arrival_order.append("offers");
+        });
+        
+        QElapsedTimer cold_start;
+        cold_start.start();
+        
+        Main_Window window;
+        QVERIFY(connectedSpy.wait(5000));
+        qint64 connected_ms = cold_start.elapsed();
+        
+        QTRY_COMPARE_WITH_TIMEOUT(arrival_order.size(), 2, 5000);
+        qint64 populated_ms = cold_start.elapsed();
+        disconnect(&api_client, nullptr, this, nullptr);
+        
+        qDebug() << "Cold start:" << populated_ms << "ms to a populated Main_Window,"
+                 << (populated_ms - connected_ms) << "ms after connecting";
+        
+        // Both requests were outstanding together and the faster one was delivered first
+        QVERIFY(mock_server->get_peak_in_flight() >= 2);
+        QCOMPARE(arrival_order, QStringList({"offers", "destinations"}));
+        
+        // One round trip for the slowest request rather than the sum of all of them
+        QVERIFY(populated_ms - connected_ms < DESTINATIONS_DELAY_MS + OFFERS_DELAY_MS);
+    }
+    
+private:
+    static constexpr int DESTINATIONS_DELAY_MS = 400;
+    static constexpr int OFFERS_DELAY_MS = 200;
+    
+    std::unique_ptr<DelayedMockServer> mock_server;
+};
+
 // Main test runner
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
@@ -453,11 +600,13 @@ int main(int argc, char *argv[]) {
     // Run integration tests
     TestClientServerIntegration testIntegration;
     TestPerformanceIntegration testPerformance;
+    TestColdStart testColdStart;
     
     int result = 0;
     
     result += QTest::qExec(&testIntegration, argc, argv);
     result += QTest::qExec(&testPerformance, argc, argv);
+    result += QTest::qExec(&testColdStart, argc, argv);
     
     return result;
 }
@@ -12,6 +12,43 @@ namespace Config
 		constexpr int BUFFER_SIZE = 4096;
 		constexpr int SOCKET_TIMEOUT_MS = 30000; // 30 seconds
 		constexpr bool ENABLE_KEEP_ALIVE = true; // Enable TCP keep-alive
+
+		// Reactor mode - client sockets multiplexed over a few WSAPoll threads
+		constexpr bool USE_REACTOR = true; // false falls back to one thread per client
+		constexpr int IO_THREAD_COUNT = 4;
+		constexpr int MAX_REACTOR_CONNECTIONS = 50000;
+		constexpr int REACTOR_BACKLOG_SIZE = 512;
+		constexpr int POLL_TIMEOUT_MS = 1000;
+		constexpr int MAX_READS_PER_EVENT = 16; // recv() calls per readiness event, keeps loops fair
+		constexpr int MAX_PENDING_OUTPUT_BYTES = 4 * 1024 * 1024; // Slow readers are dropped past this
+		constexpr int SEND_COALESCE_BYTES = 512; // Queued messages up to this size are copied into one segment
+		constexpr int MAX_SEND_SEGMENTS = 64; // Buffers handed to one WSASend
+		constexpr int CLIENT_REGISTRY_SHARDS = 16; // Lock shards of the connected client table
+
+		// Worker pool - requests run off the I/O threads, cheap message types first
+		constexpr int WORKER_THREAD_COUNT = 16; // 0 runs requests on the I/O threads; about the database pool size
+		constexpr int WORKER_QUEUE_CAPACITY = 1024; // Requests beyond it get a "server busy" reply
+		constexpr int WORKER_QUEUE_HIGH_PRIORITY_RESERVE = 64; // Slots only KEEPALIVE and authentication may take
+		constexpr int WORKER_MAX_QUEUE_WAIT_MS = 250; // Lower priority requests waiting longer go first
+		constexpr int MAX_UNTAGGED_REQUESTS = 64; // Per connection, requests without a request_id waiting their turn; more get an immediate busy reply
+		constexpr int SERVER_BUSY_ERROR_CODE = 503; // error_code of the "server busy" reply, safe to retry
+
+		// Length-prefixed binary frames, offered to clients that ask for them in HELLO
+		constexpr bool ENABLE_BINARY_FRAMING = true;
+
+		// zstd for binary frame payloads, for clients that ask for it in HELLO
+		constexpr bool ENABLE_COMPRESSION = true;
+		constexpr int COMPRESSION_MIN_BYTES = 1024; // Smaller payloads go out as they are
+		constexpr int COMPRESSION_LEVEL = 3;
+
+		// Per message type latency histograms - GET_SERVER_STATS and a periodic report in the log
+		constexpr bool ENABLE_SERVER_STATS_REQUEST = true;
+		constexpr bool SERVER_STATS_LOOPBACK_ONLY = true; // Answered only to connections from this machine
+		constexpr int LATENCY_REPORT_INTERVAL_SECONDS = 300; // 0 disables the report
+
+		// Seat availability pushed to SUBSCRIBE_OFFERS connections after bookings and cancellations
+		constexpr bool ENABLE_OFFER_PUSH = true;
+		constexpr int OFFER_PUSH_COALESCE_MS = 200; // Changes to an offer within this window go out once
 	}
 
 	// Database Configuration
@@ -24,6 +61,34 @@ namespace Config
 		constexpr int QUERY_TIMEOUT = 15; // seconds
 		constexpr bool AUTO_COMMIT = true; // Auto-commit transactions
 
+		// Connection pool - every query borrows its own connection and statement handle
+		constexpr int POOL_MIN_SIZE = 2;
+		constexpr int POOL_MAX_SIZE = 16;
+		constexpr int POOL_IDLE_TIMEOUT_SECONDS = 300; // Idle connections above POOL_MIN_SIZE are closed
+		constexpr int POOL_ACQUIRE_TIMEOUT_MS = 5000;
+		constexpr int POOL_HEALTH_CHECK_INTERVAL_SECONDS = 30;
+
+		// Result fetching - columns are bound once and fetched this many rows per SQLFetch
+		constexpr int FETCH_BLOCK_ROWS = 256;
+		constexpr int FETCH_MAX_BOUND_COLUMN_BYTES = 8192; // Wider columns are read with SQLGetData
+
+		// Prepared statements kept per pooled connection, least recently used are closed first
+		constexpr int STATEMENT_CACHE_SIZE = 64;
+
+		// BOOK_OFFER runs sp_Book_Offer, one round trip; false sends the statements one by one
+		constexpr bool USE_BOOKING_PROCEDURE = true;
+
+		// Offer catalog - GET_OFFERS is served from memory and refreshed from Date_Modified deltas
+		constexpr bool USE_OFFER_CATALOG = true;
+		constexpr int OFFER_CATALOG_REFRESH_SECONDS = 5; // Picks up edits made outside the server
+		constexpr int OFFER_CATALOG_FULL_RELOAD_SECONDS = 300; // Deletes and joined-table edits leave no delta
+		constexpr int OFFER_CATALOG_DELTA_OVERLAP_SECONDS = 30;
+		constexpr int OFFER_CATALOG_MAX_REMOVED = 4096; // Ids kept for conditional GET_OFFERS, older versions get the full list
+
+		// Seat counters - sold out offers refuse BOOK_OFFER in memory, reloaded from Offers on this interval
+		constexpr bool USE_SEAT_COUNTERS = true;
+		constexpr int SEAT_COUNTER_RECONCILE_SECONDS = 10;
+
 		// Connection string template - not used, build_connection_string() used instead
 		const std::string CONNECTION_TEMPLATE =
 			"DRIVER={" + DRIVER + "};"
@@ -46,6 +111,14 @@ namespace Config
 		const std::string LOG_DIRECTORY = "logs/";
 		const std::string CONFIG_DIRECTORY = "config/";
 		const std::string SQL_SCRIPTS_DIRECTORY = "sql/";
+
+		// Asynchronous logging - records go through a bounded ring drained by a writer thread
+		constexpr bool ASYNC_LOGGING = true;
+		constexpr int LOG_RING_CAPACITY = 8192; // Records of up to 512 bytes, 4 MB in total
+		constexpr bool LOG_DROP_ON_OVERLOAD = true; // Full ring drops DEBUG/INFO; false makes every caller wait
+		constexpr int LOG_FLUSH_INTERVAL_MS = 50;
+		constexpr long long MAX_LOG_FILE_BYTES = 16LL * 1024 * 1024; // Then rotated to server_<date>.1.log, .2 ...
+		constexpr int MAX_ROTATED_LOG_FILES = 5;
 	}
 
 	// JSON Message Configuration
@@ -64,6 +137,16 @@ namespace Config
 		constexpr int LOCKOUT_DURATION_MINUTES = 15;
 		constexpr bool REQUIRE_EMAIL_VALIDATION = false;
 		// Salt is now per-user (username) for better security
+
+		// Usernames with no account are refused from memory for this long after a failed lookup
+		constexpr int AUTH_NEGATIVE_CACHE_SECONDS = 30;
+		constexpr int AUTH_NEGATIVE_CACHE_MAX_ENTRIES = 10000;
+
+		// Session tokens - handed out at login, RESUME_SESSION on a new connection skips the password
+		constexpr int SESSION_TTL_MINUTES = 720; // Sliding, every resume starts it again
+		constexpr int SESSION_MAX_LIFETIME_HOURS = 168; // From the login; resumes cannot extend a session past it
+		constexpr int SESSION_STORE_SHARDS = 16;
+		constexpr int SESSION_SWEEP_EVERY = 256; // Logins into a shard between sweeps of its expired sessions
 	}
 
 	// Business Logic Configuration
@@ -89,6 +172,7 @@ namespace Config
 		const std::string INVALID_REQUEST = "Invalid request format";
 		const std::string SERVER_ERROR = "Internal server error";
 		const std::string SOCKET_COMM_ERROR = "Socket communication error";
+		const std::string SERVER_BUSY = "Server busy, please retry";
 	}
 
 	// Success Messages
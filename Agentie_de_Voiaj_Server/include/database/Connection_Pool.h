@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <sqltypes.h>
+
+#include "config.h"
+#include "database/Statement_Cache.h"
+
+namespace Database
+{
+	struct Pool_Config
+	{
+		int min_size = Config::Database::POOL_MIN_SIZE;
+		int max_size = Config::Database::POOL_MAX_SIZE;
+		int idle_timeout_seconds = Config::Database::POOL_IDLE_TIMEOUT_SECONDS;
+		int acquire_timeout_ms = Config::Database::POOL_ACQUIRE_TIMEOUT_MS;
+		int health_check_interval_seconds = Config::Database::POOL_HEALTH_CHECK_INTERVAL_SECONDS;
+	};
+
+	struct Pool_Stats
+	{
+		int total_connections = 0;
+		int idle_connections = 0;
+		int peak_connections = 0;
+		long long acquire_count = 0;
+		long long wait_count = 0;		// Acquires that had to block for a free connection
+		long long timeout_count = 0;
+		long long evicted_count = 0;	// Closed for being idle past idle_timeout_seconds
+		long long broken_count = 0;		// Closed after failing a health check or a query
+	};
+
+	// One physical ODBC connection owned by the pool
+	struct Pooled_Connection
+	{
+		SQLHDBC hdbc = SQL_NULL_HDBC;
+		std::chrono::steady_clock::time_point last_used;
+		std::chrono::steady_clock::time_point last_checked;
+		bool is_broken = false;
+		std::unique_ptr<Statement_Cache> statements; // Prepared on this connection, freed before it disconnects
+	};
+
+	class Connection_Pool
+	{
+	public:
+		// RAII borrow of a connection, returned to the pool on destruction
+		class Lease
+		{
+		private:
+			Connection_Pool* pool = nullptr;
+			std::unique_ptr<Pooled_Connection> connection;
+
+		public:
+			Lease() = default;
+			Lease(Connection_Pool* pool, std::unique_ptr<Pooled_Connection> connection)
+				: pool(pool), connection(std::move(connection))
+			{
+			}
+			~Lease() { release(); }
+
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+			Lease(Lease&& other) noexcept = default;
+			Lease& operator=(Lease&& other) noexcept
+			{
+				if (this != &other)
+				{
+					release();
+					pool = other.pool;
+					connection = std::move(other.connection);
+					other.pool = nullptr;
+				}
+				return *this;
+			}
+
+			SQLHDBC get_hdbc() const { return connection ? connection->hdbc : SQL_NULL_HDBC; }
+			Statement_Cache* get_statement_cache() const { return connection ? connection->statements.get() : nullptr; }
+			bool is_valid() const { return connection != nullptr; }
+
+			// Marks the connection as unusable, it is closed instead of being reused
+			void invalidate() { if (connection) connection->is_broken = true; }
+			void release();
+		};
+
+	private:
+		SQLHENV henv;
+		std::string connection_string;
+		Pool_Config config;
+
+		mutable std::mutex pool_mutex;
+		std::condition_variable pool_cv;
+		std::vector<std::unique_ptr<Pooled_Connection>> idle_connections; // LIFO, warmest connection first
+		int total_connections = 0;
+		int peak_connections = 0;
+		bool is_open = false;
+
+		std::atomic<long long> acquire_count{ 0 };
+		std::atomic<long long> wait_count{ 0 };
+		std::atomic<long long> timeout_count{ 0 };
+		std::atomic<long long> evicted_count{ 0 };
+		std::atomic<long long> broken_count{ 0 };
+
+	public:
+		Connection_Pool(SQLHENV henv, const std::string& connection_string, const Pool_Config& config = Pool_Config());
+		~Connection_Pool();
+
+		Connection_Pool(const Connection_Pool&) = delete;
+		Connection_Pool& operator=(const Connection_Pool&) = delete;
+
+		bool open();
+		void close();
+		bool is_pool_open() const;
+
+		Lease acquire();
+		Pool_Stats get_stats() const;
+		const Pool_Config& get_config() const { return config; }
+
+		static bool is_connection_alive(SQLHDBC hdbc);
+
+	private:
+		std::unique_ptr<Pooled_Connection> create_connection();
+		void destroy_connection(std::unique_ptr<Pooled_Connection> connection);
+		void return_connection(std::unique_ptr<Pooled_Connection> connection);
+		std::vector<std::unique_ptr<Pooled_Connection>> collect_idle_victims();
+		std::string get_connection_error(SQLHDBC hdbc) const;
+	};
+}
@@ -8,6 +8,8 @@
 #include <mutex>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <unordered_map>
 #include <sstream>
 #include <iomanip>
 
@@ -25,6 +27,12 @@
 
 // Utils header
 #include "utils/utils.h"
+#include "database/Connection_Pool.h"
+#include "database/Result_Set.h"
+#include "database/Row_Fetcher.h"
+#include "database/Offer_Catalog.h"
+#include "database/Seat_Counters.h"
+#include "database/Unknown_User_Cache.h"
 
 #pragma comment(lib, "odbc32.lib")
 
@@ -47,7 +55,7 @@ namespace Database
 	{
 		Result_Type type;
 		std::string message;
-		std::vector<std::map<std::string, std::string>> data;
+		Result_Set data;
 		int affected_rows = 0;
 		
 		Query_Result(Result_Type t = Result_Type::SUCCESS, const std::string& msg = "")
@@ -70,8 +78,31 @@ namespace Database
 	{
 	private:
 		SQLHENV henv;
-		SQLHDBC hdbc;
-		SQLHSTMT hstmt;
+		std::unique_ptr<Connection_Pool> connection_pool;
+		Pool_Config pool_config;
+
+		// Connections pinned by begin_transaction() until commit/rollback, one per thread
+		std::unordered_map<std::thread::id, Connection_Pool::Lease> transaction_connections;
+		std::mutex transaction_mutex;
+		std::atomic<int> active_transactions;
+
+		Fetch_Stats fetch_stats; // Accumulated over every SELECT
+		mutable std::mutex fetch_stats_mutex;
+
+		std::atomic<long long> statement_cache_hits;
+		std::atomic<long long> statement_cache_misses;
+
+		std::shared_ptr<Offer_Catalog> offer_catalog; // Created on connect(), null in demo mode
+		std::shared_ptr<Seat_Counters> seat_counters; // Created on connect(), null in demo mode
+		std::atomic<bool> use_booking_procedure;
+		std::atomic<bool> use_seat_counters;
+		Unknown_User_Cache unknown_users; // Logins refused without a query
+		std::atomic<long long> destinations_version; // Bumped by add/update/delete_destination
+
+		// Told about every offer change after the catalog, outside offer_listeners_mutex
+		std::vector<std::pair<int, std::function<void(int, Offer_Change)>>> offer_listeners;
+		std::mutex offer_listeners_mutex;
+		int next_offer_listener_id = 1;
 
 		std::string server;
 		std::string database;
@@ -79,9 +110,9 @@ namespace Database
 		std::string password;
 		std::string connection_string;
 
-		bool is_connected;
+		std::atomic<bool> is_connected;
 		bool is_demo_mode; // When true, returns mock data instead of real DB operations
-		std::mutex db_mutex;
+		std::mutex db_mutex; // Guards connect/disconnect, queries only touch their borrowed connection
 
 		static constexpr int MAX_RETRIES_ATTEMPTS = 3;
 		static constexpr int RETRY_DELAY_MS = 1000;
@@ -105,6 +136,23 @@ namespace Database
 		void set_configuration_params(const std::string& server, const std::string& database,
 			const std::string& username, const std::string& password);
 		std::string get_connection_string() const;
+		void set_pool_config(const Pool_Config& config);
+		Pool_Stats get_pool_stats() const;
+		Fetch_Stats get_fetch_stats() const;
+		Statement_Cache_Stats get_statement_cache_stats() const;
+		void set_use_booking_procedure(bool enabled); // Defaults to Config::Database::USE_BOOKING_PROCEDURE
+		void set_use_seat_counters(bool enabled); // Defaults to Config::Database::USE_SEAT_COUNTERS
+
+		// In-memory GET_OFFERS catalog, null when not connected or disabled in config
+		std::shared_ptr<Offer_Catalog> get_offer_catalog();
+		std::shared_ptr<Seat_Counters> get_seat_counters(); // null when not connected or disabled in config
+		void notify_offer_changed(int offer_id, Offer_Change change);
+		// offer_id is 0 when an offer was added. Returns an id for remove_offer_listener();
+		// a listener may still be running while it is removed
+		int add_offer_listener(std::function<void(int, Offer_Change)> listener);
+		void remove_offer_listener(int listener_id);
+		// For conditional GET_DESTINATIONS; edits made outside this server are not seen
+		long long get_destinations_version() const { return destinations_version.load(); }
 
 		// Core query methods
 		Query_Result execute_query(const std::string& query);
@@ -114,7 +162,8 @@ namespace Database
 		Query_Result execute_delete(const std::string& query);
 
 		// Advanced features
-		Query_Result execute_prepared(const std::string& query, const std::vector<std::pair<std::string, std::string>>& params);
+		// Runs query with '?' placeholders through the connection's prepared statement cache
+		Query_Result execute_prepared(const std::string& query, const std::vector<Sql_Param>& params);
 		
 		// Transaction support
 		bool begin_transaction();
@@ -176,12 +225,15 @@ namespace Database
 			double min_price = 0, double max_price = 0,
 			const std::string& start_date = "", 
 			const std::string& end_date = "");
+		static Query_Result validate_search_criteria(const Offer_Search_Criteria& criteria); // Shared with the catalog search
 		Query_Result add_offer(const Offer_Data& offer);
 		Query_Result update_offer(const Offer_Data& offer);
 		Query_Result delete_offer(int offer_id);
 
 		// Reservation management
-		Query_Result book_offer(int user_id, int offer_id, int person_count = 1);
+		// persons is empty or has one entry per traveler. Data holds Reservation_ID on success.
+		Query_Result book_offer(int user_id, int offer_id, int person_count = 1,
+			const std::vector<Reservation_Person_Data>& persons = {});
 		Query_Result get_user_reservations(int user_id);
 		Query_Result get_offer_reservations(int offer_id);
 		Query_Result get_reservation_by_id(int reservation_id);
@@ -223,11 +275,19 @@ namespace Database
 		bool initialize_handles();
 		void cleanup_handles();
 		std::string build_connection_string() const;
-		Query_Result process_select_result();
-		Query_Result process_execution_result();
+		Query_Result process_select_result(SQLHDBC hdbc, SQLHSTMT hstmt);
+		Query_Result process_execution_result(SQLHSTMT hstmt);
+		Connection_Pool::Lease* get_transaction_connection();
+		bool end_transaction(SQLSMALLINT completion_type);
+		Query_Result book_offer_with_procedure(int user_id, int offer_id, int person_count,
+			const std::vector<Reservation_Person_Data>& persons);
+		Query_Result book_offer_in_transaction(int user_id, int offer_id, int person_count,
+			const std::vector<Reservation_Person_Data>& persons);
 		bool handle_sql_error(SQLSMALLINT handle_type, SQLHANDLE handle);
 		std::string get_sql_error(SQLSMALLINT handle_type, SQLHANDLE handle);
+		std::string get_sql_state(SQLSMALLINT handle_type, SQLHANDLE handle);
 		bool retry_operation(std::function<bool()> operation, int max_attempts = MAX_RETRIES_ATTEMPTS);
+		void on_destinations_changed();
 		
 		// Table creation SQL
 		std::string get_create_users_table_sql();
@@ -240,4 +300,23 @@ namespace Database
 		std::string get_create_reservation_persons_table_sql();
 		std::string get_create_indexes_sql();
 	};
+
+	// A transaction that rolls back when it goes out of scope uncommitted, including when an
+	// execute_*() call throws; otherwise its connection would stay pinned to the thread
+	class Transaction_Scope
+	{
+	private:
+		Database_Manager& manager;
+		bool is_open;
+
+	public:
+		explicit Transaction_Scope(Database_Manager& manager);
+		~Transaction_Scope();
+
+		Transaction_Scope(const Transaction_Scope&) = delete;
+		Transaction_Scope& operator=(const Transaction_Scope&) = delete;
+
+		bool is_started() const { return is_open; }
+		bool commit(); // Ends the transaction either way, false when the commit failed
+	};
 }
\ No newline at end of file
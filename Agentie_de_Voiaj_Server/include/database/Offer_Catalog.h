@@ -0,0 +1,140 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "config.h"
+#include "database/Result_Set.h"
+#include "database/Offer_Index.h"
+
+namespace Database
+{
+	class Database_Manager;
+
+	enum class Offer_Change
+	{
+		MODIFIED,	// Seats booked or released, offer edited or added
+		DELETED
+	};
+
+	// One GET_OFFERS row and the catalog version it last changed in
+	struct Versioned_Offer
+	{
+		int offer_id = 0;
+		long long changed_version = 0;
+		std::shared_ptr<const std::string> row_json;
+	};
+
+	// Immutable view of the available offers, shared with every request that reads it
+	struct Offer_Catalog_Snapshot
+	{
+		long long version = 0;		// Only moves when the GET_OFFERS rows change, see next_version()
+		long long base_version = 0;	// Oldest known version a delta can still be built from
+		size_t offer_count = 0;
+		std::string offers_json; // GET_OFFERS payload, same rows and order as get_available_offers()
+		std::vector<Versioned_Offer> offers; // The rows of offers_json, same order
+		std::map<int, long long> removed; // Offer id -> version it left GET_OFFERS in
+		std::string built_for_date; // Departure dates are compared against this day
+		std::shared_ptr<const Offer_Index> search_index; // SEARCH_OFFERS, active offers with seats left
+	};
+
+	struct Offer_Catalog_Stats
+	{
+		long long hits = 0;				// Requests answered from the current snapshot
+		long long searches = 0;			// SEARCH_OFFERS answered from the index
+		long long delta_refreshes = 0;	// Date_Modified queries
+		long long full_reloads = 0;
+		long long rows_refreshed = 0;
+		size_t cached_offers = 0;		// All offers held in memory, available or not
+	};
+
+	// In-memory copy of the joined offer rows behind GET_OFFERS. Rows are kept
+	// for every offer (so seat and status changes can move an offer in or out of
+	// the available set) and refreshed from Date_Modified deltas; book/cancel
+	// mark the catalog stale through Database_Manager::notify_offer_changed().
+	class Offer_Catalog
+	{
+	private:
+		struct Catalog_Entry
+		{
+			std::shared_ptr<const std::string> row_json; // Serialized once per change, shared with the snapshots
+			std::string status;
+			std::string departure_date;
+			std::string return_date;
+			std::string destination_name;
+			std::string country;
+			double price = 0.0;
+			int total_seats = 0;
+			int reserved_seats = 0;
+		};
+
+		Database_Manager* db_manager;
+
+		std::mutex refresh_mutex; // Held while querying, one refresh at a time
+		std::map<int, Catalog_Entry> entries;
+		std::string watermark; // Highest Date_Modified seen, ISO 8601
+		std::chrono::steady_clock::time_point last_full_reload;
+		bool is_loaded = false;
+
+		mutable std::mutex snapshot_mutex;
+		std::shared_ptr<const Offer_Catalog_Snapshot> snapshot;
+
+		std::atomic<bool> is_stale;
+		std::atomic<long long> next_refresh_ms; // steady_clock, timed refresh for edits made outside the server
+		std::atomic<size_t> cached_offers;
+		std::mutex deleted_mutex;
+		std::set<int> deleted_offers;
+
+		std::atomic<long long> hits;
+		std::atomic<long long> searches;
+		std::atomic<long long> delta_refreshes;
+		std::atomic<long long> full_reloads;
+		std::atomic<long long> rows_refreshed;
+
+	public:
+		explicit Offer_Catalog(Database_Manager* db_manager);
+
+		Offer_Catalog(const Offer_Catalog&) = delete;
+		Offer_Catalog& operator=(const Offer_Catalog&) = delete;
+
+		// Current available offers, refreshed first when stale. Throws DatabaseException
+		// only when nothing has been loaded yet, otherwise a failed refresh serves the last snapshot.
+		std::shared_ptr<const Offer_Catalog_Snapshot> get_snapshot();
+
+		// SEARCH_OFFERS from the snapshot's index, JSON array ordered by departure date.
+		// Criteria must pass Offer_Index::can_answer() and be validated by the caller.
+		std::string search(const Offer_Search_Criteria& criteria, size_t* match_count = nullptr);
+
+		// Offer change listener, cheap: only marks the catalog stale
+		void on_offer_changed(int offer_id, Offer_Change change);
+		void invalidate();
+
+		Offer_Catalog_Stats get_stats() const;
+
+		// Conditional GET_OFFERS for a client holding known_version:
+		// {"version":..,"not_modified":true}, {"version":..,"changed":[rows],"removed":[ids]}, or
+		// {"version":..,"offers":[rows]} when the version is from another run, too old, or the delta is not smaller
+		static std::string build_changes_since(const Offer_Catalog_Snapshot& snapshot, long long known_version);
+
+		// Sets version, base_version, removed and each row's changed_version of next by comparing
+		// its offers with previous (null for the first snapshot)
+		static void carry_versions(const Offer_Catalog_Snapshot* previous, Offer_Catalog_Snapshot& next);
+
+		// At least previous + 1 and at least the wall clock in ms, so a restarted server
+		// never hands out a version an older run already used
+		static long long next_version(long long previous);
+
+	private:
+		bool needs_refresh(const Offer_Catalog_Snapshot* current, const std::string& today) const;
+		void refresh(const std::string& today);
+		bool apply_rows(const Result_Set& rows);
+		void rebuild_snapshot(const std::string& today);
+		static std::string to_iso_timestamp(const std::string& sql_timestamp);
+	};
+}
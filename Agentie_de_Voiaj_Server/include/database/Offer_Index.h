@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Database
+{
+	// SEARCH_OFFERS filters, 0 or empty leaves a filter unset (same as Database_Manager::search_offers)
+	struct Offer_Search_Criteria
+	{
+		std::string destination;	// Substring of the destination name or country, case-insensitive
+		double min_price = 0.0;
+		double max_price = 0.0;
+		std::string start_date;		// Departure_Date >= start_date
+		std::string end_date;		// Return_Date <= end_date
+	};
+
+	// One searchable offer; row_json is the serialized row shared with the catalog
+	struct Indexed_Offer
+	{
+		int offer_id = 0;
+		double price = 0.0;
+		std::string departure_date;
+		std::string return_date;
+		std::string destination_name;
+		std::string country;
+		std::shared_ptr<const std::string> row_json;
+	};
+
+	// Fixed-size bitset over document positions, 64 documents per word
+	class Offer_Bitmap
+	{
+	private:
+		std::vector<uint64_t> words;
+		size_t bit_count = 0;
+
+	public:
+		Offer_Bitmap() = default;
+		explicit Offer_Bitmap(size_t bit_count, bool is_set = false);
+
+		void set(size_t bit) { words[bit >> 6] |= uint64_t(1) << (bit & 63); }
+		bool test(size_t bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+		void set_range(size_t first, size_t last); // [first, last)
+
+		Offer_Bitmap& operator&=(const Offer_Bitmap& other);
+		Offer_Bitmap& operator|=(const Offer_Bitmap& other);
+
+		size_t size() const { return bit_count; }
+		size_t count() const;
+
+		static unsigned lowest_bit(uint64_t word)
+		{
+#ifdef _MSC_VER
+			unsigned long index = 0;
+			_BitScanForward64(&index, word);
+			return static_cast<unsigned>(index);
+#else
+			return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+		}
+
+		// Calls func(position) for every set bit, ascending
+		template<typename Func>
+		void for_each(Func func) const
+		{
+			for (size_t w = 0; w < words.size(); w++)
+			{
+				uint64_t word = words[w];
+				while (word)
+				{
+					func(w * 64 + lowest_bit(word));
+					word &= word - 1;
+				}
+			}
+		}
+	};
+
+	// Immutable search index over the offers SEARCH_OFFERS can return. Documents are
+	// kept in Departure_Date order so a match set read in bit order is already sorted
+	// like the SQL path's ORDER BY. Each filter produces a bitmap and the bitmaps are
+	// intersected:
+	//  - destination: trigram postings over the distinct destination name/country
+	//    pairs, candidates verified with a substring check (LIKE '%x%' semantics)
+	//  - price and return date: document ids sorted by value, a range is a binary search
+	//  - departure date: the document order itself, a range is a contiguous run of bits
+	class Offer_Index
+	{
+	private:
+		struct Destination_Entry
+		{
+			std::string name;		// Lowercase
+			std::string country;	// Lowercase
+			std::vector<uint32_t> offers; // Document ids, ascending
+		};
+
+		std::vector<Indexed_Offer> offers; // Position is the document id
+		std::vector<Destination_Entry> destinations;
+		std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams; // Trigram -> destination ids, ascending
+
+		std::vector<uint32_t> by_price;
+		std::vector<double> sorted_prices;
+		std::vector<uint32_t> by_return_date;
+		std::vector<std::string> sorted_return_dates;
+
+	public:
+		explicit Offer_Index(std::vector<Indexed_Offer> offers);
+
+		Offer_Index(const Offer_Index&) = delete;
+		Offer_Index& operator=(const Offer_Index&) = delete;
+
+		// False when the destination holds LIKE wildcards (% _ [), those still go to SQL
+		static bool can_answer(const Offer_Search_Criteria& criteria);
+
+		Offer_Bitmap match(const Offer_Search_Criteria& criteria) const;
+
+		// Matching rows as a JSON array, ordered by Departure_Date
+		std::string search(const Offer_Search_Criteria& criteria, size_t* match_count = nullptr) const;
+
+		size_t size() const { return offers.size(); }
+		const Indexed_Offer& offer(size_t position) const { return offers[position]; }
+
+	private:
+		Offer_Bitmap match_destination(const std::string& text) const;
+		static std::string to_lower_ascii(const std::string& text);
+		static uint32_t trigram_key(const char* text);
+	};
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+
+#include <windows.h>
+#include <sqltypes.h>
+
+namespace Database
+{
+	enum class Column_Type
+	{
+		INT,		// INTEGER, SMALLINT, TINYINT, BIGINT, BIT
+		DOUBLE,		// DECIMAL, NUMERIC, FLOAT, REAL - scale keeps DECIMAL formatting stable
+		DATE,		// DATE
+		TIMESTAMP,	// DATETIME, DATETIME2 - scale is the number of fractional second digits
+		STRING		// Everything else, stored as text
+	};
+
+	// Columnar query result: column names are stored once, values live in one
+	// contiguous typed buffer per column (strings share a single arena) and
+	// NULLs are tracked in a per-column bitmap.
+	class Result_Set
+	{
+	public:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		class Row_View
+		{
+		private:
+			const Result_Set* result_set;
+			size_t row;
+
+		public:
+			Row_View(const Result_Set* result_set, size_t row) : result_set(result_set), row(row) {}
+
+			size_t index() const { return row; }
+			size_t column_count() const { return result_set->columns.size(); }
+			const std::string& column_name(size_t column) const { return result_set->columns[column].name; }
+
+			// O(1) access by column index
+			bool is_null(size_t column) const;
+			int64_t get_int(size_t column) const;
+			double get_double(size_t column) const;
+			SQL_TIMESTAMP_STRUCT get_date(size_t column) const;
+			std::string_view get_string_view(size_t column) const; // STRING columns only, empty otherwise
+			std::string get_string(size_t column) const; // Any column, formatted like the driver's SQL_C_CHAR text
+
+			// Access by name through the column index (hash lookup)
+			bool is_null(const std::string& name) const;
+			int64_t get_int(const std::string& name) const;
+			double get_double(const std::string& name) const;
+			std::string get_string(const std::string& name) const;
+
+			// Compatibility with the former std::map<std::string, std::string> rows
+			std::string operator[](const std::string& name) const; // "" for NULL or unknown columns
+			std::string at(const std::string& name) const; // Throws std::out_of_range for unknown columns
+			std::map<std::string, std::string> to_map() const;
+
+			// Appends the row as a JSON object; pass json_key_order() when writing many rows
+			void append_json(std::string& out) const;
+			void append_json(std::string& out, const std::vector<size_t>& key_order) const;
+		};
+
+		class Iterator
+		{
+		private:
+			const Result_Set* result_set;
+			size_t row;
+
+		public:
+			Iterator(const Result_Set* result_set, size_t row) : result_set(result_set), row(row) {}
+
+			Row_View operator*() const { return Row_View(result_set, row); }
+			Iterator& operator++() { ++row; return *this; }
+			bool operator==(const Iterator& other) const { return row == other.row; }
+			bool operator!=(const Iterator& other) const { return row != other.row; }
+		};
+
+	private:
+		struct Column
+		{
+			std::string name;
+			Column_Type type = Column_Type::STRING;
+			int scale = 0;
+			size_t value_count = 0;
+
+			std::vector<int64_t> int_values;
+			std::vector<double> double_values;
+			std::vector<SQL_TIMESTAMP_STRUCT> date_values;
+			std::vector<uint32_t> string_offsets; // Value i is string_arena[offsets[i], offsets[i + 1])
+			std::string string_arena;
+			std::vector<uint64_t> null_bits;
+		};
+
+		std::vector<Column> columns;
+		std::unordered_map<std::string, size_t> column_index;
+		size_t row_count = 0;
+
+	public:
+		Result_Set() = default;
+
+		// Schema
+		size_t add_column(const std::string& name, Column_Type type, int scale = 0);
+		size_t find_column(const std::string& name) const;
+		size_t column_count() const { return columns.size(); }
+		const std::string& column_name(size_t column) const { return columns[column].name; }
+		Column_Type column_type(size_t column) const { return columns[column].type; }
+
+		// Building - append one value to every column, then end_row()
+		void reserve(size_t rows);
+		void append_int(size_t column, int64_t value);
+		void append_double(size_t column, double value);
+		void append_date(size_t column, const SQL_TIMESTAMP_STRUCT& value);
+		void append_string(size_t column, const char* value, size_t length);
+		void append_null(size_t column);
+		void end_row();
+
+		// Compatibility with std::vector<std::map<std::string, std::string>>
+		void push_back(const std::map<std::string, std::string>& row);
+		bool empty() const { return row_count == 0; }
+		size_t size() const { return row_count; }
+		Row_View operator[](size_t row) const { return Row_View(this, row); }
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, row_count); }
+		void clear();
+
+		static std::string format_date(const SQL_TIMESTAMP_STRUCT& value, Column_Type type, int scale);
+
+		// JSON rendering, the shape clients receive: one object per row with every value
+		// as a string (NULL as ""). Keys are sorted the way nlohmann::json orders them and
+		// a duplicated column name keeps its last value, so the text matches a dumped DOM.
+		std::vector<size_t> json_key_order() const;
+		void append_json(std::string& out) const; // All rows as an array, straight from the columns
+
+	private:
+		void append_json_value(std::string& out, size_t row, size_t column) const;
+		void mark_null(Column& column, size_t row, bool is_null);
+		const Column* find_column_ptr(const std::string& name) const;
+	};
+}
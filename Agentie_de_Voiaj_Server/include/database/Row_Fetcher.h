@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <sqltypes.h>
+
+#include "config.h"
+#include "database/Result_Set.h"
+
+namespace Database
+{
+	// ODBC calls made while fetching, per_row() is what bulk fetching is meant to cut down
+	struct Fetch_Stats
+	{
+		long long rows = 0;
+		long long fetch_calls = 0;		// SQLFetch
+		long long get_data_calls = 0;	// SQLGetData, long columns only once columns are bound
+		long long set_pos_calls = 0;	// SQLSetPos, positioning inside a block for SQLGetData
+
+		long long odbc_calls() const { return fetch_calls + get_data_calls + set_pos_calls; }
+		double per_row() const { return rows > 0 ? static_cast<double>(odbc_calls()) / rows : 0.0; }
+
+		void add(const Fetch_Stats& other)
+		{
+			rows += other.rows;
+			fetch_calls += other.fetch_calls;
+			get_data_calls += other.get_data_calls;
+			set_pos_calls += other.set_pos_calls;
+		}
+	};
+
+	// Reads an executed statement's result into a Result_Set. Columns are bound
+	// once with SQLBindCol and fetched block_rows at a time (column-wise row-array
+	// binding); long columns (TEXT, VARCHAR(MAX), ...) cannot be bound to a fixed
+	// buffer and are read with chunked SQLGetData instead.
+	class Row_Fetcher
+	{
+	private:
+		struct Column_Binding
+		{
+			Column_Type type = Column_Type::STRING;
+			SQLSMALLINT c_type = SQL_C_CHAR;
+			SQLLEN element_size = 0;	// Bytes per row in buffer
+			bool is_bound = false;
+			std::vector<char> buffer;
+			std::vector<SQLLEN> indicators;
+		};
+
+		SQLHDBC hdbc;
+		SQLHSTMT hstmt;
+		SQLULEN block_rows;
+		SQLULEN rows_fetched = 0;
+		std::vector<SQLUSMALLINT> row_status;
+		std::vector<Column_Binding> bindings;
+		std::string text_buffer;
+		Fetch_Stats stats;
+
+	public:
+		// The statement is not owned, its bindings and row-array attributes are reset on destruction
+		Row_Fetcher(SQLHDBC hdbc, SQLHSTMT hstmt, int block_rows = Config::Database::FETCH_BLOCK_ROWS);
+		~Row_Fetcher();
+
+		Row_Fetcher(const Row_Fetcher&) = delete;
+		Row_Fetcher& operator=(const Row_Fetcher&) = delete;
+
+		// False on an ODBC error, diagnostics are left on the statement handle
+		bool fetch_all(Result_Set& rows);
+		const Fetch_Stats& get_stats() const { return stats; }
+
+	private:
+		bool describe_columns(Result_Set& rows);
+		bool bind_columns();
+		bool append_bound_value(Result_Set& rows, size_t column, SQLULEN row);
+		bool append_unbound_value(Result_Set& rows, size_t column);
+		bool read_long_text(SQLUSMALLINT column, bool& is_null);
+	};
+}
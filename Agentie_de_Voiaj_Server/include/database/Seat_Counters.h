@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+#include "config.h"
+
+namespace Database
+{
+	class Database_Manager;
+
+	enum class Seat_Hold
+	{
+		HELD,		// Seats taken from the counter, the booking goes to the database
+		SOLD_OUT,	// Refused without a query
+		UNKNOWN		// Offer not loaded yet, the database decides
+	};
+
+	struct Seat_Counter_Stats
+	{
+		long long held = 0;
+		long long rejected = 0;			// Bookings refused in memory
+		long long unknown = 0;
+		long long reconciliations = 0;	// Full reloads from Offers
+		long long corrections = 0;		// Counters that had drifted from Total_Seats - Reserved_Seats
+		size_t tracked_offers = 0;
+	};
+
+	// Available seats per offer, kept in memory so a sold out offer refuses
+	// bookings without queueing on its row lock. The counters only filter: the
+	// guarded UPDATE in the database still decides, and they are reloaded from
+	// Offers every SEAT_COUNTER_RECONCILE_SECONDS. Drift between reloads only
+	// ever overestimates the seats, so nothing bookable is refused.
+	class Seat_Counters
+	{
+	private:
+		Database_Manager* db_manager; // null in tests, nothing is reloaded then
+
+		mutable std::shared_mutex counters_mutex; // Guards the map, the counters themselves are atomic
+		std::unordered_map<int, std::unique_ptr<std::atomic<int>>> counters;
+
+		std::mutex reconcile_mutex; // Held while querying, one reload at a time
+		std::atomic<long long> next_reconcile_ms;
+
+		std::atomic<long long> held;
+		std::atomic<long long> rejected;
+		std::atomic<long long> unknown;
+		std::atomic<long long> reconciliations;
+		std::atomic<long long> corrections;
+
+	public:
+		explicit Seat_Counters(Database_Manager* db_manager);
+
+		Seat_Counters(const Seat_Counters&) = delete;
+		Seat_Counters& operator=(const Seat_Counters&) = delete;
+
+		// Reloads first when the interval has passed and no other thread is reloading
+		Seat_Hold try_hold(int offer_id, int seats);
+
+		// Seats go back: a hold the database did not turn into a booking, or a cancellation
+		void release(int offer_id, int seats);
+
+		void set_available(int offer_id, int available_seats);
+		void forget(int offer_id);
+
+		// Full reload, returns false when the query failed and the counters were kept
+		bool reconcile();
+		// One offer, after the database refused a booking the counter allowed
+		void reconcile_offer(int offer_id);
+
+		Seat_Counter_Stats get_stats() const;
+
+	private:
+		std::atomic<int>* find_counter(int offer_id) const; // Caller holds counters_mutex
+	};
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <sqltypes.h>
+
+#include "config.h"
+
+namespace Database
+{
+	enum class Param_Type
+	{
+		INT,
+		DOUBLE,
+		STRING,
+		TABLE,
+		NULL_VALUE
+	};
+
+	// Column of a table-valued parameter, values are sent as text and converted by the server
+	struct Sql_Table_Column
+	{
+		SQLSMALLINT sql_type = SQL_VARCHAR;	// SQL_VARCHAR, SQL_TYPE_DATE, SQL_INTEGER ...
+		SQLULEN size = 0;					// Declared length, 10 for a DATE
+	};
+
+	// Rows for a user-defined table type parameter. The type is taken from the procedure
+	// signature, so a TABLE parameter only works with {call ...} syntax.
+	struct Sql_Table
+	{
+		std::vector<Sql_Table_Column> columns;
+		std::vector<std::vector<std::string>> rows; // One value per column
+	};
+
+	// Memory bind_parameters() hands to the driver, must stay alive until SQLExecute returns
+	struct Param_Buffers
+	{
+		std::vector<SQLLEN> indicators;
+		std::vector<std::vector<char>> table_values;	// One column-wise array per table column
+		std::vector<std::vector<SQLLEN>> table_lengths;
+	};
+
+	struct Statement_Cache_Stats
+	{
+		long long hits = 0;		// Executions that reused a prepared statement, no parse or plan lookup
+		long long misses = 0;	// Executions that had to SQLPrepare first
+
+		double hit_rate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+	};
+
+	// Typed input parameter for a '?' placeholder, bound with SQLBindParameter
+	struct Sql_Param
+	{
+		Param_Type type = Param_Type::NULL_VALUE;
+		int int_value = 0;
+		double double_value = 0.0;
+		std::string string_value;
+		std::shared_ptr<const Sql_Table> table_value;
+
+		Sql_Param() = default;
+		Sql_Param(int value) : type(Param_Type::INT), int_value(value) {}
+		Sql_Param(double value) : type(Param_Type::DOUBLE), double_value(value) {}
+		Sql_Param(const std::string& value) : type(Param_Type::STRING), string_value(value) {}
+		Sql_Param(const char* value) : type(Param_Type::STRING), string_value(value ? value : "") {}
+		Sql_Param(std::shared_ptr<const Sql_Table> value) : type(Param_Type::TABLE), table_value(std::move(value)) {}
+
+		static Sql_Param null() { return Sql_Param(); }
+	};
+
+	// LRU cache of SQLPrepare'd statements for one connection, keyed by SQL text.
+	// A connection is only used by the thread holding its lease, so the cache is
+	// not synchronized.
+	class Statement_Cache
+	{
+	private:
+		struct Cached_Statement
+		{
+			std::string sql;
+			SQLHSTMT hstmt;
+		};
+
+		SQLHDBC hdbc;
+		size_t capacity;
+		std::list<Cached_Statement> statements; // Most recently used first
+		std::unordered_map<std::string, std::list<Cached_Statement>::iterator> index;
+
+	public:
+		Statement_Cache(SQLHDBC hdbc, size_t capacity = Config::Database::STATEMENT_CACHE_SIZE);
+		~Statement_Cache();
+
+		Statement_Cache(const Statement_Cache&) = delete;
+		Statement_Cache& operator=(const Statement_Cache&) = delete;
+
+		// Returns the prepared statement for sql, preparing it on a miss. On failure
+		// returns SQL_NULL_HSTMT and fills error with the driver diagnostics.
+		SQLHSTMT acquire(const std::string& sql, bool& was_cached, std::string& error);
+
+		// Drops a statement that failed, the next acquire() prepares it again
+		void discard(const std::string& sql);
+		void clear();
+		size_t size() const { return statements.size(); }
+
+		static bool bind_parameters(SQLHSTMT hstmt, const std::vector<Sql_Param>& params, Param_Buffers& buffers);
+		static std::string get_statement_error(SQLHSTMT hstmt);
+
+	private:
+		static SQLRETURN bind_table(SQLHSTMT hstmt, SQLUSMALLINT number, const Sql_Table& table,
+			SQLLEN& row_count, Param_Buffers& buffers);
+	};
+}
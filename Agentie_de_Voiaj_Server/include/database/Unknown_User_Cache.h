@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+#include "config.h"
+
+namespace Database
+{
+	// Usernames that recently matched no account. Logins for them are refused
+	// without a query, so a credential stuffing burst of made-up names costs one
+	// lookup per name per window. Keys are lower case, like the column's collation.
+	class Unknown_User_Cache
+	{
+	private:
+		std::chrono::milliseconds ttl;
+		size_t max_entries;
+
+		mutable std::mutex mutex;
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> expiry_by_username;
+
+		std::atomic<long long> hits;
+
+	public:
+		Unknown_User_Cache(std::chrono::milliseconds ttl = std::chrono::seconds(Config::Security::AUTH_NEGATIVE_CACHE_SECONDS),
+			size_t max_entries = Config::Security::AUTH_NEGATIVE_CACHE_MAX_ENTRIES);
+
+		bool contains(const std::string& username);
+		void add(const std::string& username);
+		void remove(const std::string& username); // The name was just registered
+
+		long long get_hits() const { return hits.load(); }
+		size_t size() const;
+
+	private:
+		static std::string to_key(const std::string& username);
+	};
+}
@@ -5,12 +5,17 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <deque>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <winsock2.h>
 
 #include "network/Network_Types.h"
+#include "network/Frame_Codec.h"
+#include "network/Send_Queue.h"
+#include "network/Payload_Compressor.h"
+#include "network/Response_Writer.h"
 #include "database/Database_Manager.h"
 
 // Forward declarations
@@ -19,23 +24,56 @@ namespace SocketNetwork
 {
 	class Socket_Server;
 	class Protocol_Handler;
+	class Io_Reactor;
+	class Worker_Pool;
 }
 
 namespace SocketNetwork
 {
-	class Client_Handler
+	class Client_Handler : public std::enable_shared_from_this<Client_Handler>
 	{
 	private:
 		SocketRAII client_socket;
-		Client_Info client_info;
+		Client_Info client_info; // Session fields and activity times guarded by session_mutex
+		mutable std::mutex session_mutex;
 		std::shared_ptr<Database::Database_Manager> db_manager;
 		Protocol_Handler* protocol_handler;
 		Socket_Server* server;
 
+		// Thread-per-client mode owns a thread, reactor mode is driven by an Io_Reactor loop
 		std::thread handler_thread;
+		Io_Reactor* reactor = nullptr;
+		int reactor_loop = -1;
+		Worker_Pool* worker_pool = nullptr; // Requests run there when set, responses may go out of order
+
+		// Requests without a request_id can only be matched to their replies by order, so they
+		// run one at a time, in arrival order, on a single worker; tagged requests may overtake them
+		struct Untagged_Request
+		{
+			Parsed_Message message;
+			Frame_Header reply;
+			std::chrono::steady_clock::time_point started;
+		};
+		std::deque<Untagged_Request> untagged_requests; // Guarded by untagged_mutex
+		bool is_untagged_running = false; // A worker is draining untagged_requests
+		std::mutex untagged_mutex;
 		std::atomic<bool> is_running;
+		std::atomic<bool> is_subscribed_to_offers{ false };
 		std::mutex send_mutex;
 
+		Frame_Decoder decoder;		// Partial message bytes, touched only by the owning I/O thread
+		Send_Queue send_queue;		// Bytes the socket would not take yet, guarded by send_mutex
+		std::atomic<bool> has_output{ false };
+
+		Framing_Mode output_framing = Framing_Mode::TEXT_LINES; // Guarded by send_mutex
+		Response_Writer response_writer; // Guarded by send_mutex
+		Framing_Mode requested_framing = Framing_Mode::TEXT_LINES; // Set by HELLO, applied once its response is out
+		bool has_framing_request = false;
+		std::unique_ptr<Payload_Compressor> compressor; // Binary framing only, guarded by send_mutex
+		std::string compressed_frame; // Guarded by send_mutex
+		bool has_compression_request = false;
+		bool requested_dictionary = false;
+
 		std::chrono::steady_clock::time_point last_activity;
 		int messages_received = 0;
 		int messages_sent = 0;
@@ -50,13 +88,38 @@ namespace SocketNetwork
 		void stop_handling();
 		bool is_client_running() const;
 
-		bool send_message(const std::string& message);
+		// Reactor mode - must be attached before start_handling()
+		void attach_reactor(Io_Reactor* reactor, int loop_index);
+		bool on_readable();
+		bool on_writable();
+		bool has_pending_output() const;
+
+		// Must be attached before start_handling()
+		void attach_worker_pool(Worker_Pool* pool);
+
+		// header carries the type and request id echoed in binary frames, ignored for text lines
+		bool send_message(const std::string& message, const Frame_Header& header = Frame_Header());
+		// Queues the buffer itself, broadcasts share one copy between all recipients
+		bool send_shared_message(const Shared_Buffer& message, const Frame_Header& header = Frame_Header());
+		bool send_response(const Response& response, const Frame_Header& header = Frame_Header());
 		std::string receive_message();
 
-		const Client_Info& get_client_info() const;
+		// Switches both directions to mode after the current response has been sent
+		void request_framing(Framing_Mode mode);
+		// Large binary frames go out compressed from then on, applied like the framing
+		void request_compression(bool use_dictionary);
+		Framing_Mode get_framing() const { return decoder.get_mode(); }
+
+		const Client_Info& get_client_info() const; // Socket, address and port; they never change
+		Client_Info get_client_snapshot() const; // Whole copy, session fields included
+		int get_user_id() const;
+		Socket_Server* get_server() const { return server; }
 		void update_last_activity();
 		bool is_authenticated() const;
 		void set_authenticated(int user_id, const std::string& username);
+		void clear_authentication(); // After LOGOUT
+		void set_offer_subscription(bool is_subscribed) { is_subscribed_to_offers = is_subscribed; }
+		bool is_offer_subscriber() const { return is_subscribed_to_offers.load(); }
 
 		int get_messages_received() const 
 		{ 
@@ -69,12 +132,24 @@ namespace SocketNetwork
 		}
 		std::chrono::milliseconds get_idle_time() const;
 
+	friend class Io_Reactor;
+
 	private:
 		void handle_client_loop();
-		bool process_message(const std::string& message);
+		bool receive_frame(Frame& frame);
+		bool process_message(const Frame& frame);
+		bool execute_request(const Parsed_Message& parsed_message, Frame_Header reply,
+			std::chrono::steady_clock::time_point started);
+		bool queue_untagged_request(Parsed_Message&& parsed_message, const Frame_Header& reply,
+			std::chrono::steady_clock::time_point started); // False when it was refused
+		void run_untagged_requests();
+		bool send_encoded(const std::string& wire_message); // Caller holds send_mutex
+		bool flush_output(); // Caller holds send_mutex
+		const std::string& compress_frame(const std::string& wire_message); // Caller holds send_mutex
+		void apply_requested_framing();
 		void handle_disconnection();
 		bool is_socket_valid() const;
-		void send_error_response(const std::string& error_message);
+		void send_error_response(const std::string& error_message, const Frame_Header& request = Frame_Header());
 		void send_success_response(const std::string& data = "", const std::string& message = "");
 	};
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <winsock2.h>
+
+#include "network/Network_Types.h"
+
+namespace SocketNetwork
+{
+	class Client_Handler;
+
+	// Connected clients, split into shards by socket so accepts, disconnects and lookups
+	// on different sockets rarely meet on the same lock, with a second sharded index from
+	// user id to that user's connections. Iteration hands out a copy of the references:
+	// callers send outside every registry lock.
+	class Client_Registry
+	{
+	public:
+		using Client_Ptr = std::shared_ptr<Client_Handler>;
+
+	private:
+		struct Client_Shard
+		{
+			mutable std::mutex mutex;
+			std::unordered_map<SOCKET, Client_Ptr> clients;
+		};
+
+		struct User_Shard
+		{
+			mutable std::mutex mutex;
+			std::unordered_map<int, std::vector<SOCKET>> sockets;
+		};
+
+		std::vector<std::unique_ptr<Client_Shard>> client_shards;
+		std::vector<std::unique_ptr<User_Shard>> user_shards;
+		std::atomic<int> client_count{ 0 };
+
+	public:
+		explicit Client_Registry(size_t shard_count = Config::Server::CLIENT_REGISTRY_SHARDS);
+
+		bool add(SOCKET socket, Client_Ptr client);
+		Client_Ptr remove(SOCKET socket); // nullptr when it was not registered
+		Client_Ptr find(SOCKET socket) const;
+		int size() const { return client_count.load(); }
+
+		// Called after a connection authenticates; previous_user_id is 0 on first login
+		void bind_user(SOCKET socket, int user_id, int previous_user_id);
+		void unbind_user(SOCKET socket, int user_id);
+		std::vector<Client_Ptr> find_by_user(int user_id); // Also prunes sockets that left
+
+		std::vector<Client_Ptr> snapshot() const;
+		std::vector<Client_Ptr> remove_if(const std::function<bool(const Client_Ptr&)>& predicate);
+		std::vector<Client_Ptr> clear();
+
+	private:
+		Client_Shard& client_shard(SOCKET socket) const;
+		User_Shard& user_shard(int user_id) const;
+	};
+}
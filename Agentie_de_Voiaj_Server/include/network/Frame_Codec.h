@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "network/Network_Types.h"
+
+namespace SocketNetwork
+{
+	enum class Framing_Mode
+	{
+		TEXT_LINES,	// One JSON document per line, "\r\n" terminated (default)
+		BINARY		// Frame_Header followed by the JSON payload, negotiated with HELLO
+	};
+
+	// 12-byte header, all fields big-endian on the wire:
+	//   u32 length | u16 message_type | u16 flags | u32 request_id
+	// length counts the payload only. Responses echo the request's type and id.
+	struct Frame_Header
+	{
+		uint32_t length = 0;
+		uint16_t message_type = 0;	// Wire code, see to_wire_type(); 0 leaves the type to the payload
+		uint16_t flags = 0;
+		uint32_t request_id = 0;
+	};
+
+	constexpr size_t FRAME_HEADER_SIZE = 12;
+	constexpr uint16_t FRAME_FLAG_RESPONSE = 0x0001;
+	constexpr uint16_t FRAME_FLAG_ERROR = 0x0002;	// Response with success == false
+	constexpr uint16_t FRAME_FLAG_COMPRESSED = 0x0004;	// Payload is zstd, see Payload_Compressor
+
+	struct Frame
+	{
+		Frame_Header header;
+		std::string payload;
+	};
+
+	// Per-connection reassembly buffer. Bytes are appended as they arrive and whole
+	// messages are taken off the front; a line or frame split across reads waits for
+	// the rest, several packed into one read come out one by one.
+	class Frame_Decoder
+	{
+	public:
+		enum class Result
+		{
+			FRAME,		// frame holds the next message
+			NEED_MORE,	// Incomplete, wait for more bytes
+			TOO_LARGE	// Message exceeds max_payload_bytes, the connection should be dropped
+		};
+
+	private:
+		Framing_Mode mode = Framing_Mode::TEXT_LINES;
+		size_t max_payload_bytes;
+		std::string buffer;
+		size_t read_offset = 0;	// Start of the first unconsumed byte
+		size_t scan_offset = 0;	// TEXT_LINES: bytes before this hold no '\n', not scanned again
+
+	public:
+		explicit Frame_Decoder(size_t max_payload_bytes);
+
+		void append(const char* data, size_t size);
+		Result next(Frame& frame);
+
+		// Bytes already buffered are decoded in the new mode, so the switch takes
+		// effect right after the message that negotiated it
+		void set_mode(Framing_Mode new_mode);
+		Framing_Mode get_mode() const { return mode; }
+		size_t buffered() const { return buffer.size() - read_offset; }
+		void clear();
+
+	private:
+		void compact();
+	};
+
+	// Serializes a message for the wire in the given mode
+	std::string encode_frame(Framing_Mode mode, const Frame_Header& header, const std::string& payload);
+	void write_frame_header(char* out, const Frame_Header& header);
+	Frame_Header read_frame_header(const char* in);
+
+	// Stable wire codes for Message_Type, independent of the enum's order
+	uint16_t to_wire_type(Message_Type type);
+	Message_Type from_wire_type(uint16_t code);
+}
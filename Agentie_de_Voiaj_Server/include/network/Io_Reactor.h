@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <winsock2.h>
+
+#include "network/Network_Types.h"
+
+// Forward declarations
+
+namespace SocketNetwork
+{
+	class Socket_Server;
+	class Client_Handler;
+}
+
+namespace SocketNetwork
+{
+	// Multiplexes all client sockets over a small fixed set of I/O threads.
+	// Every loop owns its own WSAPoll set; other threads hand clients over through
+	// pending_clients and wake the loop with a byte on a loopback UDP socket.
+	class Io_Reactor
+	{
+	private:
+		struct Io_Loop
+		{
+			std::thread thread;
+			SocketRAII wake_socket;
+			std::atomic<bool> wake_pending{ false };
+			std::atomic<int> client_count{ 0 };
+
+			std::mutex pending_mutex;
+			std::vector<std::shared_ptr<Client_Handler>> pending_clients;
+
+			// Owned by the loop thread, poll_fds[0] is the wake socket and
+			// poll_fds[i + 1] belongs to clients[i]
+			std::vector<WSAPOLLFD> poll_fds;
+			std::vector<std::shared_ptr<Client_Handler>> clients;
+		};
+
+		Socket_Server* server;
+		std::vector<std::unique_ptr<Io_Loop>> loops;
+		std::atomic<bool> is_running;
+
+	public:
+		Io_Reactor(Socket_Server* server, int thread_count);
+		~Io_Reactor();
+
+		bool start();
+		void stop();
+		bool is_reactor_running() const;
+
+		bool add_client(std::shared_ptr<Client_Handler> client);
+		void wake(int loop_index);
+		int get_thread_count() const;
+
+	private:
+		void run_loop(int loop_index);
+		bool create_wake_socket(Io_Loop& loop);
+		void drain_wake_socket(Io_Loop& loop);
+		void adopt_pending_clients(Io_Loop& loop);
+		void close_loop_clients(Io_Loop& loop);
+	};
+}
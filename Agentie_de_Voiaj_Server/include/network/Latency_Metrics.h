@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+#include "network/Network_Types.h"
+
+namespace SocketNetwork
+{
+	enum class Latency_Phase
+	{
+		PARSE,		// Payload to Parsed_Message
+		DATABASE,	// Handler, dominated by its queries
+		SERIALIZE,	// Response to wire bytes
+		TOTAL		// Parse through send
+	};
+
+	constexpr size_t LATENCY_PHASE_COUNT = 4;
+	constexpr size_t MESSAGE_TYPE_COUNT = static_cast<size_t>(Message_Type::UNKNOWN) + 1;
+
+	// Log-linear buckets in microseconds, HDR style: exact below 64 us, then 32 buckets
+	// per power of two (about 3% relative error) up to ~71 minutes.
+	class Latency_Histogram
+	{
+	public:
+		static constexpr int SUB_BUCKET_BITS = 5;
+		static constexpr size_t BUCKET_COUNT = 896;
+		static constexpr uint64_t MAX_TRACKABLE_US = (1ULL << 32) - 1; // Longer samples are clamped
+
+		static size_t bucket_index(uint64_t micros);
+		static uint64_t bucket_upper_bound(size_t index);
+
+	private:
+		std::vector<uint64_t> counts; // Allocated by the first sample
+		uint64_t total_count = 0;
+		uint64_t sum_us = 0;
+		uint64_t max_us = 0;
+
+	public:
+		void record(uint64_t micros);
+		void add_bucket(size_t index, uint64_t count);
+		void add_totals(uint64_t count, uint64_t sum, uint64_t peak);
+		void merge(const Latency_Histogram& other);
+
+		uint64_t count() const { return total_count; }
+		uint64_t peak() const { return max_us; }
+		uint64_t sum() const { return sum_us; }
+		double mean() const;
+		// Highest value of the bucket holding the p-th percentile, at most peak()
+		uint64_t percentile(double p) const;
+	};
+
+	// Histograms for every message type and phase, merged from all threads
+	struct Latency_Snapshot
+	{
+		std::vector<Latency_Histogram> histograms = std::vector<Latency_Histogram>(MESSAGE_TYPE_COUNT * LATENCY_PHASE_COUNT);
+
+		Latency_Histogram& at(Message_Type type, Latency_Phase phase);
+		const Latency_Histogram& at(Message_Type type, Latency_Phase phase) const;
+		uint64_t request_count() const;
+		double average_response_time_ms() const; // TOTAL over all message types
+	};
+
+	// Process-wide request latencies. Every thread records into its own histograms with
+	// plain relaxed stores, no locks or shared cache lines on the request path; readers
+	// merge them on demand. Histograms of exited threads are folded into a retired total.
+	class Latency_Metrics
+	{
+	public:
+		static void record(Message_Type type, Latency_Phase phase, std::chrono::steady_clock::duration elapsed);
+		static Latency_Snapshot snapshot();
+		// Samples recorded while resetting may survive it
+		static void reset();
+
+		// p50/p99/p999/max per message type and phase, for the log
+		static std::string format_report(const Latency_Snapshot& snapshot);
+		static nlohmann::json to_json(const Latency_Snapshot& snapshot);
+
+		static const char* phase_name(Latency_Phase phase);
+	};
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <atomic>
 #include <functional>
+#include <memory>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -12,13 +13,27 @@
 #include "config.h"
 #include "utils/utils.h"
 
+namespace Database
+{
+	class Result_Set;
+}
+
 namespace SocketNetwork
 {
+	enum class Io_Mode
+	{
+		THREAD_PER_CLIENT,
+		REACTOR
+	};
+
 	struct Server_Config
 	{
 		std::string ip_address = "127.0.0.1";
 		int port = Config::Server::PORT;
-		int max_clients = Config::Server::MAX_CONNECTIONS;
+		Io_Mode io_mode = Config::Server::USE_REACTOR ? Io_Mode::REACTOR : Io_Mode::THREAD_PER_CLIENT;
+		int io_thread_count = Config::Server::IO_THREAD_COUNT;
+		int worker_thread_count = Config::Server::WORKER_THREAD_COUNT; // 0 processes requests on the I/O threads
+		int max_clients = Config::Server::USE_REACTOR ? Config::Server::MAX_REACTOR_CONNECTIONS : Config::Server::MAX_CONNECTIONS;
 		int receive_timeout_ms = Config::Server::SOCKET_TIMEOUT_MS;
 		int send_timeout_ms = Config::Server::SOCKET_TIMEOUT_MS;
 		int keep_alive_interval_ms = 60000;
@@ -58,8 +73,12 @@ namespace SocketNetwork
 		int total_messages_sent;
 		std::string uptime;
 		std::string start_time;
-		double average_response_time_ms;
+		double average_response_time_ms; // Mean of all requests since start or reset
 		int memory_usage_mb;
+		long long statement_cache_hits = 0;
+		long long statement_cache_misses = 0;
+		double statement_cache_hit_rate = 0.0; // Share of prepared executions that skipped SQLPrepare
+		long long bookings_refused_in_memory = 0; // Sold out offers answered by the seat counters
 	};
 
 	enum class Message_Type
@@ -76,6 +95,12 @@ namespace SocketNetwork
 		UPDATE_USER_INFO,
 		// Admin message types reserved for future implementation
 		KEEPALIVE,
+		HELLO,		// Connection setup, negotiates the framing mode
+		GET_SERVER_STATS,	// Counters and per message type latencies, loopback only by default
+		SUBSCRIBE_OFFERS,	// Asks for OFFER_UPDATE pushes on this connection
+		OFFER_UPDATE,		// Server push, never a request: seats and status of changed offers
+		RESUME_SESSION,		// Authenticates a new connection with the token from an earlier login
+		LOGOUT,			// Revokes the session token, the connection is anonymous again
 		ERR,
 		UNKNOWN
 	};
@@ -87,6 +112,7 @@ namespace SocketNetwork
 		nlohmann::json json_data; // Store parsed JSON data
 		bool is_valid = false;
 		std::string error_message;
+		uint32_t request_id = 0; // Client's correlation id, echoed in the response; 0 when not sent
 
 		Parsed_Message() : type(Message_Type::UNKNOWN), is_valid(false)
 		{
@@ -99,6 +125,9 @@ namespace SocketNetwork
 		std::string message;
 		std::string data; // JSON data
 		int error_code = 0;
+		bool data_is_json = false; // data is already valid JSON, sent without being parsed again
+		std::shared_ptr<const Database::Result_Set> rows; // When set, serialized as data straight from the columns
+		uint32_t request_id = 0; // Copied from the Parsed_Message it answers
 
 		Response(bool s = false, const std::string& msg = "", const std::string& d = "")
 			: success(s), message(msg), data(d)
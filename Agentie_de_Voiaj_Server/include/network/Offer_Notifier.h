@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "network/Network_Types.h"
+#include "database/Database_Manager.h"
+
+namespace SocketNetwork
+{
+	class Socket_Server;
+
+	// What an OFFER_UPDATE push carries for one offer
+	struct Offer_Seats
+	{
+		int offer_id = 0;
+		int available_seats = 0;
+		std::string status; // Offers.Status, "deleted" once the offer is gone
+	};
+
+	// Turns offer changes reported by Database_Manager into OFFER_UPDATE pushes for
+	// the connections that sent SUBSCRIBE_OFFERS. Changes are collected for a short
+	// window after the first one, so a burst of bookings on one offer costs a single
+	// seat query and a single entry in the push.
+	class Offer_Notifier
+	{
+	public:
+		struct Stats
+		{
+			uint64_t changes = 0;	// Reported by the database layer
+			uint64_t pushes = 0;	// OFFER_UPDATE messages broadcast
+			uint64_t offers_pushed = 0;
+		};
+
+	private:
+		Socket_Server* server;
+		std::shared_ptr<Database::Database_Manager> db_manager;
+		std::chrono::milliseconds coalesce_window;
+		int listener_id = 0;
+
+		std::thread notifier_thread;
+		std::map<int, Database::Offer_Change> pending; // offer_id -> latest change
+		std::chrono::steady_clock::time_point first_pending_at;
+		bool is_stopping = false;
+		std::mutex pending_mutex;
+		std::condition_variable pending_condition;
+
+		std::atomic<uint64_t> changes{ 0 };
+		std::atomic<uint64_t> pushes{ 0 };
+		std::atomic<uint64_t> offers_pushed{ 0 };
+
+	public:
+		Offer_Notifier(Socket_Server* server, std::shared_ptr<Database::Database_Manager> db_manager,
+			std::chrono::milliseconds coalesce_window = std::chrono::milliseconds(Config::Server::OFFER_PUSH_COALESCE_MS));
+		~Offer_Notifier();
+
+		Offer_Notifier(const Offer_Notifier&) = delete;
+		Offer_Notifier& operator=(const Offer_Notifier&) = delete;
+
+		bool start();
+		void stop(); // Changes still waiting for their window are dropped
+
+		// Database listener, only records the change
+		void on_offer_changed(int offer_id, Database::Offer_Change change);
+
+		Stats get_stats() const;
+
+		// {"type":"OFFER_UPDATE","data":[{"offer_id":..,"available_seats":..,"status":..}]}
+		static std::string build_update_message(const std::vector<Offer_Seats>& offers);
+
+	private:
+		void run();
+		void publish(const std::map<int, Database::Offer_Change>& changes);
+	};
+}
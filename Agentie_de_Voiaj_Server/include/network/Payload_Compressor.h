@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+struct ZSTD_CCtx_s;
+
+namespace SocketNetwork
+{
+	// zstd for binary frame payloads, negotiated per connection in HELLO. Both sides can
+	// prime it with the shared dictionary of catalog JSON (common/include/Offer_Dictionary.h), which
+	// is what lets replies of a few KB shrink as well. A compressed frame carries
+	// FRAME_FLAG_COMPRESSED and its length counts the compressed bytes. Not thread safe,
+	// the owning connection holds its send lock.
+	class Payload_Compressor
+	{
+	private:
+		ZSTD_CCtx_s* context = nullptr;
+		bool use_dictionary = false;
+		std::string output;
+
+	public:
+		explicit Payload_Compressor(bool use_dictionary);
+		~Payload_Compressor();
+
+		Payload_Compressor(const Payload_Compressor&) = delete;
+		Payload_Compressor& operator=(const Payload_Compressor&) = delete;
+
+		// Compressed bytes in a buffer reused by the next call, or null when size is below
+		// COMPRESSION_MIN_BYTES or the result would not be smaller
+		const std::string* compress(const char* data, size_t size);
+
+		// Fails on damaged input and on content larger than max_bytes
+		static bool decompress(const char* data, size_t size, bool use_dictionary, size_t max_bytes, std::string& out);
+
+		static const char* const DICTIONARY_NAME;
+		static const std::string& dictionary();
+	};
+}
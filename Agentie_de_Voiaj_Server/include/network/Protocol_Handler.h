@@ -23,9 +23,14 @@ namespace SocketNetwork
 	public:
 		explicit Protocol_Handler(std::shared_ptr<Database::Database_Manager> db_manager);
 
-		Parsed_Message parse_message(const std::string& json_message);
+		// framed_type and framed_request_id come from a binary frame header; when set they
+		// take precedence over the payload's "type" and "request_id"
+		Parsed_Message parse_message(const std::string& json_message, Message_Type framed_type = Message_Type::UNKNOWN,
+			uint32_t framed_request_id = 0);
 		Message_Type get_message_type(const nlohmann::json& json_obj);
-		std::string message_type_to_string(Message_Type type);
+		uint32_t get_request_id(const nlohmann::json& json_obj);
+		static long long get_known_version(const nlohmann::json& json_obj); // Catalog version the client holds, 0 when none
+		static std::string message_type_to_string(Message_Type type);
 
 		Response process_message(const Parsed_Message& parsed_message, SocketNetwork::Client_Handler* client_handler);
 		std::string create_response(bool success, const std::string& message = "",
@@ -44,6 +49,11 @@ namespace SocketNetwork
 		Response handle_get_user_info(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
 		Response handle_update_user_info(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
 		Response handle_keepalive(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
+		Response handle_hello(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
+		Response handle_get_server_stats(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
+		Response handle_subscribe_offers(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
+		Response handle_resume_session(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
+		Response handle_logout(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
 
 		// Admin functions not implemented for college project scope
 		// Response handle_admin_get_stats(const Parsed_Message& message, SocketNetwork::Client_Handler* client);
@@ -59,7 +69,8 @@ namespace SocketNetwork
 
 	private:
 		// JSON utilities
-		std::string vector_to_json(const std::vector<std::map<std::string, std::string>>& data);
+		Response rows_response(const std::string& message, Database::Result_Set&& rows);
+		std::string row_to_json(const Database::Result_Set::Row_View& row);
 		// std::string create_json_response(bool success, const std::string& message = "", const nlohmann::json& data = nlohmann::json::object(), int error_code = 0);  // Not used
 	};
 }
\ No newline at end of file
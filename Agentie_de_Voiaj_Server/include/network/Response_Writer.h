@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+#include "network/Network_Types.h"
+#include "network/Frame_Codec.h"
+
+namespace SocketNetwork
+{
+	// Serializes a Response in one pass into a buffer that is reused from one response
+	// to the next: frame header (or line terminator), envelope and rows, with no
+	// nlohmann::json DOM in between and no second parse of pre-serialized data.
+	// The text is what Utils::JSON::create_success_response / create_error_response
+	// produce, keys in nlohmann's sorted order.
+	class Response_Writer
+	{
+	private:
+		std::string buffer;
+
+		// A very large response does not pin its memory for the rest of the connection
+		static constexpr size_t RETAINED_CAPACITY = 1024 * 1024;
+
+	public:
+		// Returns the whole wire message; valid until the next write()
+		const std::string& write(const Response& response, Framing_Mode mode, const Frame_Header& header);
+
+		// Appends only the JSON envelope
+		static void append_body(std::string& out, const Response& response);
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <memory>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <winsock2.h>
+
+#include "network/Frame_Codec.h"
+
+namespace SocketNetwork
+{
+	// Immutable message bytes; a broadcast hands the same buffer to every recipient
+	using Shared_Buffer = std::shared_ptr<const std::string>;
+
+	// Outbound bytes of one connection, in send order. Payloads stay in their shared
+	// buffers and the frame header or "\r\n" sits in a segment of its own, so nothing
+	// is concatenated before the socket: flush() hands up to MAX_SEND_SEGMENTS of them
+	// to one WSASend. Small messages are copied into the tail segment instead, several
+	// pushes queued behind a slow socket then leave in one segment. Not thread safe,
+	// the owner holds its send lock.
+	class Send_Queue
+	{
+	public:
+		enum class Flush_Result
+		{
+			DONE,			// Queue empty
+			WOULD_BLOCK,	// Non-blocking socket is full, flush again when writable
+			FAILED			// Socket error, the connection is gone
+		};
+
+	private:
+		struct Segment
+		{
+			Shared_Buffer shared;	// Set for payloads sent without a copy
+			std::string owned;		// Otherwise: headers, delimiters, coalesced small messages
+			size_t offset = 0;		// Bytes already sent
+
+			const std::string& bytes() const { return shared ? *shared : owned; }
+		};
+
+		std::deque<Segment> segments;
+		size_t queued_bytes = 0;
+
+	public:
+		void push_frame(Framing_Mode mode, const Frame_Header& header, const Shared_Buffer& payload);
+		void push_copy(const char* data, size_t size); // Already encoded bytes
+
+		// Sends until the queue is empty, the socket would block or fails; partial
+		// writes resume at the first unsent byte
+		Flush_Result flush(SOCKET socket);
+
+		bool empty() const { return segments.empty(); }
+		size_t size() const { return queued_bytes; }
+		void clear();
+
+	private:
+		void push_owned(const char* data, size_t size);
+		void consume(size_t bytes);
+	};
+}
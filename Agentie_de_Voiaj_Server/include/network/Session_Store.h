@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+#include "config.h"
+
+namespace SocketNetwork
+{
+	struct Session
+	{
+		int user_id = 0;
+		std::string username;
+		std::chrono::steady_clock::time_point expires_at;
+		std::chrono::steady_clock::time_point ends_at; // Login time plus the maximum lifetime
+	};
+
+	// Login sessions by token, so a client that reconnects sends RESUME_SESSION
+	// instead of its password. Split into shards by token hash; expired sessions
+	// are dropped when looked up and by a sweep of the shard every
+	// SESSION_SWEEP_EVERY logins, there is no timer thread. Sessions live in
+	// memory only, a server restart sends every client back to the login.
+	class Session_Store
+	{
+	private:
+		struct Shard
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string, Session> sessions;
+			int creates_since_sweep = 0;
+		};
+
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::chrono::milliseconds ttl;
+		std::chrono::milliseconds max_lifetime;
+		std::atomic<int> session_count{ 0 };
+
+	public:
+		explicit Session_Store(std::chrono::milliseconds ttl = std::chrono::minutes(Config::Security::SESSION_TTL_MINUTES),
+			size_t shard_count = Config::Security::SESSION_STORE_SHARDS,
+			std::chrono::milliseconds max_lifetime = std::chrono::hours(Config::Security::SESSION_MAX_LIFETIME_HOURS));
+
+		// Returns the new token, empty when no random bytes were available
+		std::string create(int user_id, const std::string& username);
+
+		// Fills session and extends its expiry, never past ends_at; false for unknown or expired tokens
+		bool resume(const std::string& token, Session& session);
+		void revoke(const std::string& token); // LOGOUT
+
+		int size() const { return session_count.load(); }
+
+	private:
+		Shard& shard_for(const std::string& token) const;
+		void sweep(Shard& shard, std::chrono::steady_clock::time_point now); // Caller holds shard.mutex
+	};
+}
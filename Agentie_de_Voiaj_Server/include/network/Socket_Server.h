@@ -7,7 +7,6 @@
 #include <mutex>
 #include <atomic>
 #include <functional>
-#include <map>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -15,6 +14,9 @@
 #include <ws2tcpip.h>
 
 #include "network/Network_Types.h"
+#include "network/Client_Registry.h"
+#include "network/Session_Store.h"
+#include "network/Frame_Codec.h"
 #include "database/Database_Manager.h"
 
 #pragma comment(lib, "ws2_32.lib")
@@ -25,6 +27,9 @@ class Protocol_Handler;
 namespace SocketNetwork
 {
 	class Client_Handler;
+	class Io_Reactor;
+	class Worker_Pool;
+	class Offer_Notifier;
 }
 
 namespace SocketNetwork
@@ -42,10 +47,14 @@ namespace SocketNetwork
 		std::thread accept_thread;
 		std::thread cleanup_thread;
 
-		std::map<SOCKET, std::shared_ptr<Client_Handler>> active_clients;
-		std::mutex clients_mutex;
+		// Declared before client_registry so they outlive the handlers that point at them
+		std::unique_ptr<Io_Reactor> io_reactor;
+		std::unique_ptr<Worker_Pool> worker_pool;
+		std::unique_ptr<Offer_Notifier> offer_notifier; // OFFER_UPDATE pushes, null when disabled or without a database
+
+		Client_Registry client_registry;
+		Session_Store session_store; // Outlives restarts, tokens stay valid across stop() and start()
 		std::mutex protocol_handler_mutex;
-		std::atomic<int> client_count;
 
 		std::atomic<int> total_connections;
 		std::atomic<int> total_messages_received;
@@ -70,11 +79,14 @@ namespace SocketNetwork
 		bool is_server_running() const;
 		bool is_server_initialized() const;
 		int get_active_client_count() const;
+		Session_Store& get_session_store() { return session_store; }
 		std::vector<Client_Info> get_active_clients() const;
 
 		void disconnect_client(SOCKET client_socket);
 		void disconnect_all_clients();
-		void broadcast_message(const std::string& message);
+		// header is used on binary framed connections; recipient_filter, when set, picks the clients
+		void broadcast_message(const std::string& message, const Frame_Header& header = Frame_Header(),
+			const std::function<bool(const Client_Handler&)>& recipient_filter = nullptr);
 		void send_message_to_user(int user_id, const std::string& message);
 		void send_message_to_client(SOCKET client_socket, const std::string& message);
 
@@ -100,11 +112,15 @@ namespace SocketNetwork
 		void handle_new_client(SOCKET client_socket, const std::string& client_address);
 		void remove_client(SOCKET client_socket);
 		Client_Info* get_client_info(SOCKET client_socket);
+		void bind_client_user(SOCKET client_socket, int user_id, int previous_user_id);
+		void unbind_client_user(SOCKET client_socket, int user_id);
 
 		std::string get_socket_address(SOCKET socket) const;
 		bool set_socket_options(SOCKET socket);
+		bool set_non_blocking(SOCKET socket);
 		std::string get_uptime() const;
 		void log_server_event(const std::string& message);
+		void log_latency_report();
 		void log_client_event(const Client_Info& client_info, const std::string& message);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <chrono>
+
+#include "network/Network_Types.h"
+
+namespace SocketNetwork
+{
+	enum class Request_Priority
+	{
+		HIGH,	// KEEPALIVE, authentication, stats - cheap and latency sensitive
+		NORMAL,	// Bookings and account changes
+		LOW		// Catalog reads, the largest responses
+	};
+
+	// Runs requests off the I/O threads. The queue is bounded: once full, try_submit()
+	// refuses and the caller answers "server busy" rather than letting it grow. Higher
+	// priorities are taken first, and a lower priority request that has waited longer
+	// than max_queue_wait goes ahead of them so nothing starves.
+	class Worker_Pool
+	{
+	public:
+		struct Options
+		{
+			int thread_count = Config::Server::WORKER_THREAD_COUNT;
+			size_t capacity = Config::Server::WORKER_QUEUE_CAPACITY;
+			size_t high_priority_reserve = Config::Server::WORKER_QUEUE_HIGH_PRIORITY_RESERVE; // Slots only HIGH may take
+			std::chrono::milliseconds max_queue_wait{ Config::Server::WORKER_MAX_QUEUE_WAIT_MS };
+		};
+
+		struct Stats
+		{
+			size_t queued = 0;
+			uint64_t completed = 0;
+			uint64_t rejected = 0;
+		};
+
+	private:
+		static constexpr size_t PRIORITY_COUNT = 3;
+
+		struct Task
+		{
+			std::function<void()> run;
+			std::chrono::steady_clock::time_point queued_at;
+		};
+
+		Options options;
+		std::vector<std::thread> workers;
+		std::deque<Task> queues[PRIORITY_COUNT];
+		size_t queued_count = 0;
+		bool is_stopping = false;
+		mutable std::mutex queue_mutex;
+		std::condition_variable queue_condition;
+
+		std::atomic<uint64_t> completed{ 0 };
+		std::atomic<uint64_t> rejected{ 0 };
+
+	public:
+		Worker_Pool();
+		explicit Worker_Pool(const Options& options);
+		~Worker_Pool();
+
+		Worker_Pool(const Worker_Pool&) = delete;
+		Worker_Pool& operator=(const Worker_Pool&) = delete;
+
+		bool start();
+		void stop(); // Queued tasks are discarded, running ones finish
+
+		// False when the queue is full or the pool stopped, the task is not run
+		bool try_submit(Request_Priority priority, std::function<void()> task);
+
+		Stats get_stats() const;
+		static Request_Priority priority_for(Message_Type type);
+
+	private:
+		void run_worker();
+		bool take_task(Task& task); // Caller holds queue_mutex, queued_count > 0
+	};
+}
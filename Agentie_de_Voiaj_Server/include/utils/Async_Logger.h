@@ -0,0 +1,118 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <cstdint>
+
+#include "utils/utils.h"
+#include "config.h"
+
+namespace Utils
+{
+	// Background writer behind Utils::Logger. A caller formats its record straight into a
+	// slot of a bounded lock-free MPSC ring (sequence-numbered slots, one CAS per record)
+	// and returns; a single thread drains the ring, writes whole batches to the console
+	// and the log file, and rotates the file by date and size. Memory is fixed at
+	// capacity * RECORD_BYTES whatever the load.
+	class Async_Logger
+	{
+	public:
+		enum class Overflow_Policy
+		{
+			DROP,	// Full ring: DEBUG/INFO records are dropped and counted, WARNING and above wait
+			BLOCK	// Full ring: every caller waits for a free slot
+		};
+
+		struct Options
+		{
+			size_t capacity = Config::Application::LOG_RING_CAPACITY; // Rounded up to a power of two
+			Overflow_Policy policy = Config::Application::LOG_DROP_ON_OVERLOAD ? Overflow_Policy::DROP : Overflow_Policy::BLOCK;
+			std::string directory = Config::Application::LOG_DIRECTORY;
+			long long max_file_bytes = Config::Application::MAX_LOG_FILE_BYTES;
+			int max_rotated_files = Config::Application::MAX_ROTATED_LOG_FILES;
+			int flush_interval_ms = Config::Application::LOG_FLUSH_INTERVAL_MS;
+			bool console_output = true;
+			bool file_output = true;
+		};
+
+		struct Stats
+		{
+			uint64_t written = 0;
+			uint64_t dropped = 0;
+			uint64_t batches = 0;
+			uint64_t rotations = 0;
+		};
+
+		static constexpr size_t RECORD_BYTES = 512; // Longer records are truncated
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence{ 0 };
+			uint32_t length = 0;
+			char text[RECORD_BYTES];
+		};
+
+		Options options;
+		std::unique_ptr<Slot[]> slots;
+		size_t mask;
+
+		alignas(64) std::atomic<uint64_t> enqueue_position{ 0 };
+		alignas(64) uint64_t dequeue_position = 0; // Writer thread only
+		std::atomic<uint64_t> written_position{ 0 };
+		std::atomic<uint64_t> dropped{ 0 };
+		uint64_t reported_dropped = 0;
+
+		std::atomic<bool> console_output;
+		std::atomic<bool> file_output;
+
+		std::atomic<bool> is_stopping{ false };
+		std::mutex wake_mutex;
+		std::condition_variable wake_condition;		// Writer sleeps between batches
+		std::condition_variable flushed_condition;	// flush() waits for written_position
+		std::thread writer;
+
+		// Writer thread state
+		std::string batch;
+		std::ofstream file;
+		std::string file_path;
+		long long file_bytes = 0;
+		Stats stats;
+		mutable std::mutex stats_mutex;
+
+	public:
+		Async_Logger();
+		explicit Async_Logger(const Options& options);
+		~Async_Logger(); // Writes out what is still queued
+
+		Async_Logger(const Async_Logger&) = delete;
+		Async_Logger& operator=(const Async_Logger&) = delete;
+
+		// Returns false when the record was dropped
+		bool log(Logger::Level level, const std::string& message);
+
+		// Blocks until every record logged before the call has been written
+		void flush();
+
+		void set_console_output(bool enabled) { console_output = enabled; }
+		void set_file_output(bool enabled) { file_output = enabled; }
+		Stats get_stats() const;
+
+	private:
+		bool try_enqueue(Logger::Level level, const std::string& message);
+		size_t format_record(char* out, Logger::Level level, const std::string& message);
+		void wake_writer();
+
+		void run_writer();
+		size_t drain_batch();
+		void write_batch();
+		void open_log_file();
+		void rotate_log_file();
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <chrono>
 #include <sstream>
@@ -66,7 +67,9 @@ namespace Utils
 		std::string hash_password(const std::string& password, const std::string & salt = "");
 		std::string generate_salt();
 		bool verify_password(const std::string& password, const std::string& hashed_password, const std::string& salt = "");
-		std::string generate_session_token();
+		bool constant_time_equals(const std::string& a, const std::string& b); // Time does not depend on where they differ
+		std::string to_hex(const unsigned char* data, size_t length); // Lower case
+		std::string generate_session_token(); // 64 hex characters, empty on failure
 		std::string md5_hash(const std::string& input);
 	}
 
@@ -115,6 +118,13 @@ namespace Utils
 		std::string level_to_string(Level level);
 		void initialize_logging();
 		void enable_file_logging(bool enabled);
+		void enable_console_logging(bool enabled);
+		// Hands records to a background writer (Utils::Async_Logger) instead of writing them
+		// on the calling thread. Switch it off only while no other thread is logging
+		void enable_async_logging(bool enabled);
+		void flush_logs();
+		void shutdown_logging(); // Writes out queued records and stops the writer
+		uint64_t get_dropped_log_count();
 		std::string get_log_filename();
 	}
 
@@ -123,8 +133,13 @@ namespace Utils
 	{
 		bool is_valid_json(const std::string& json_str);
 		std::string escape_json(const std::string& input);
-		std::string create_error_response(const std::string& error_message, int error_code = -1);
-		std::string create_success_response(const std::string& data = "", const std::string& message = "");
+		// Appends value as a quoted JSON string, byte for byte what nlohmann::json dumps.
+		// Invalid UTF-8 becomes U+FFFD (as with error_handler_t::replace) instead of throwing
+		void append_json_string(std::string& out, std::string_view value);
+		// A non-zero request_id is echoed so pipelined responses can be matched to their requests
+		std::string create_error_response(const std::string& error_message, int error_code = -1, uint32_t request_id = 0);
+		std::string create_success_response(const std::string& data = "", const std::string& message = "", bool data_is_json = false,
+			uint32_t request_id = 0);
 		std::string format_json(const std::string& json_str);
 	}
 
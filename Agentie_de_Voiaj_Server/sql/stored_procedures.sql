@@ -21,4 +21,86 @@ BEGIN
     GROUP BY d.Destination_ID, d.Name
     ORDER BY Total_Reservations DESC
 END
-GO
\ No newline at end of file
+GO
+
+----------------------------------------------------------------------------------
+
+-- The procedure is dropped first, the table type cannot go while something uses it
+IF EXISTS (
+    SELECT 1
+    FROM sys.objects
+    WHERE object_id = OBJECT_ID(N'sp_Book_Offer')
+      AND type = 'P'
+)
+    DROP PROCEDURE sp_Book_Offer;
+GO
+
+IF TYPE_ID(N'dbo.Reservation_Person_List') IS NOT NULL
+    DROP TYPE dbo.Reservation_Person_List;
+GO
+
+CREATE TYPE dbo.Reservation_Person_List AS TABLE
+(
+    Full_Name VARCHAR(100) NOT NULL,
+    CNP VARCHAR(15) NOT NULL,
+    Birth_Date DATE NOT NULL,
+    Person_Type VARCHAR(20) NOT NULL
+);
+GO
+
+-- Reserves the seats, creates the reservation and its travelers in one call.
+-- Returns one row: Reservation_ID (0 on failure) and Result, one of
+-- BOOKED, OFFER_NOT_FOUND, NOT_ENOUGH_SEATS, PERSON_COUNT_MISMATCH.
+CREATE PROCEDURE sp_Book_Offer
+    @User_ID INT,
+    @Offer_ID INT,
+    @Number_of_Persons INT,
+    @Persons dbo.Reservation_Person_List READONLY
+AS
+BEGIN
+    SET NOCOUNT ON;
+    SET XACT_ABORT ON;
+
+    DECLARE @Person_Rows INT = (SELECT COUNT(*) FROM @Persons);
+    IF @Person_Rows > 0 AND @Person_Rows <> @Number_of_Persons
+    BEGIN
+        SELECT 0 AS Reservation_ID, 'PERSON_COUNT_MISMATCH' AS Result;
+        RETURN;
+    END
+
+    DECLARE @Price_per_Person DECIMAL(10, 2);
+    DECLARE @Reservation_ID INT;
+
+    BEGIN TRANSACTION;
+
+    -- The guarded update takes the row lock and checks the seats in one statement
+    UPDATE Offers
+    SET Reserved_Seats = Reserved_Seats + @Number_of_Persons,
+        Date_Modified = GETDATE(),
+        @Price_per_Person = Price_per_Person
+    WHERE Offer_ID = @Offer_ID
+      AND Reserved_Seats + @Number_of_Persons <= Total_Seats;
+
+    IF @@ROWCOUNT = 0
+    BEGIN
+        ROLLBACK TRANSACTION;
+        IF EXISTS (SELECT 1 FROM Offers WHERE Offer_ID = @Offer_ID)
+            SELECT 0 AS Reservation_ID, 'NOT_ENOUGH_SEATS' AS Result;
+        ELSE
+            SELECT 0 AS Reservation_ID, 'OFFER_NOT_FOUND' AS Result;
+        RETURN;
+    END
+
+    INSERT INTO Reservations (User_ID, Offer_ID, Number_of_Persons, Total_Price, Status)
+    VALUES (@User_ID, @Offer_ID, @Number_of_Persons, @Price_per_Person * @Number_of_Persons, 'pending');
+    SET @Reservation_ID = CAST(SCOPE_IDENTITY() AS INT);
+
+    INSERT INTO Reservation_Persons (Reservation_ID, Full_Name, CNP, Birth_Date, Person_Type)
+    SELECT @Reservation_ID, Full_Name, CNP, Birth_Date, Person_Type
+    FROM @Persons;
+
+    COMMIT TRANSACTION;
+
+    SELECT @Reservation_ID AS Reservation_ID, 'BOOKED' AS Result;
+END
+GO
@@ -21,6 +21,7 @@ void signal_handler(int signal)
     {
         g_server->stop();
     }
+    Utils::Logger::shutdown_logging();
     exit(0);
 }
 
@@ -33,7 +34,8 @@ int main()
     std::cout << "Version: " << Config::Application::VERSION << std::endl;
     std::cout << "Debug Mode: " << (Config::Application::DEBUG_MODE ? "ON" : "OFF") << std::endl;
     std::cout << "Port: " << Config::Server::PORT << std::endl;
-    std::cout << "Max Connections: " << Config::Server::MAX_CONNECTIONS << std::endl;
+    std::cout << "I/O Mode: " << (Config::Server::USE_REACTOR ? "Reactor (" + std::to_string(Config::Server::IO_THREAD_COUNT) + " I/O threads)" : std::string("Thread per client")) << std::endl;
+    std::cout << "Max Connections: " << (Config::Server::USE_REACTOR ? Config::Server::MAX_REACTOR_CONNECTIONS : Config::Server::MAX_CONNECTIONS) << std::endl;
     std::cout << std::string(50, '=') << std::endl;
     
     // Setup signal handlers for graceful shutdown
@@ -145,7 +147,7 @@ int main()
         Server_Config config;
         config.ip_address = "0.0.0.0"; // Listen on all interfaces
         config.port = Config::Server::PORT;
-        config.max_clients = Config::Server::MAX_CONNECTIONS;
+        config.max_clients = config.io_mode == Io_Mode::REACTOR ? Config::Server::MAX_REACTOR_CONNECTIONS : Config::Server::MAX_CONNECTIONS;
         config.enable_logging = Config::Application::DEBUG_MODE;
         
         // Create and configure server
@@ -202,6 +204,32 @@ int main()
                 Utils::Logger::info("Messages received: " + std::to_string(stats.total_messages_received));
                 Utils::Logger::info("Messages sent: " + std::to_string(stats.total_messages_sent));
                 Utils::Logger::info("Uptime: " + stats.uptime);
+                Utils::Logger::info("Statement cache hit rate: " +
+                                    Utils::Conversion::double_to_string(stats.statement_cache_hit_rate * 100.0, 1) + "% (" +
+                                    std::to_string(stats.statement_cache_hits) + " hits, " +
+                                    std::to_string(stats.statement_cache_misses) + " prepares)");
+                if (connected)
+                {
+                    auto pool_stats = db_manager->get_pool_stats();
+                    Utils::Logger::info("DB pool: " + std::to_string(pool_stats.total_connections) + " open, " +
+                                        std::to_string(pool_stats.idle_connections) + " idle, " +
+                                        std::to_string(pool_stats.wait_count) + " waits, " +
+                                        std::to_string(pool_stats.timeout_count) + " timeouts");
+
+                    auto fetch_stats = db_manager->get_fetch_stats();
+                    Utils::Logger::info("DB fetch: " + std::to_string(fetch_stats.rows) + " rows, " +
+                                        Utils::Conversion::double_to_string(fetch_stats.per_row()) + " ODBC calls/row");
+
+                    auto catalog = db_manager->get_offer_catalog();
+                    if (catalog)
+                    {
+                        auto catalog_stats = catalog->get_stats();
+                        Utils::Logger::info("Offer catalog: " + std::to_string(catalog_stats.cached_offers) + " offers, " +
+                                            std::to_string(catalog_stats.hits) + " hits, " +
+                                            std::to_string(catalog_stats.delta_refreshes) + " delta refreshes, " +
+                                            std::to_string(catalog_stats.full_reloads) + " full reloads");
+                    }
+                }
                 stats_counter = 0;
             }
         }
@@ -210,10 +238,12 @@ int main()
     catch (const std::exception& e)
     {
         std::cerr << "FATAL ERROR: " << e.what() << std::endl;
+        Utils::Logger::shutdown_logging();
         return -1;
     }
     
     Utils::Logger::info("=== Server shutdown complete ===");
+    Utils::Logger::shutdown_logging();
     std::cout << "Server shutdown complete." << std::endl;
     return 0;
 }
@@ -0,0 +1,337 @@
+#include "database/Connection_Pool.h"
+#include "utils/utils.h"
+#include <algorithm>
+
+using namespace Utils::Exceptions;
+
+// ============================================================================
+// Connection_Pool::Lease
+// ============================================================================
+
+void Database::Connection_Pool::Lease::release()
+{
+    if (pool && connection)
+    {
+        pool->return_connection(std::move(connection));
+    }
+    pool = nullptr;
+}
+
+// ============================================================================
+// Connection_Pool Implementation
+// ============================================================================
+
+Database::Connection_Pool::Connection_Pool(SQLHENV henv, const std::string& connection_string, const Pool_Config& config)
+    : henv(henv), connection_string(connection_string), config(config)
+{
+    this->config.min_size = (std::max)(0, this->config.min_size);
+    this->config.max_size = (std::max)(1, (std::max)(this->config.min_size, this->config.max_size));
+}
+
+Database::Connection_Pool::~Connection_Pool()
+{
+    close();
+}
+
+bool Database::Connection_Pool::open()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (is_open)
+        {
+            return true;
+        }
+        is_open = true;
+    }
+
+    // Warm up min_size connections (at least one, so bad settings fail here and not on the first request)
+    int warm_count = (std::max)(1, config.min_size);
+    try
+    {
+        for (int i = 0; i < warm_count; i++)
+        {
+            std::unique_ptr<Pooled_Connection> connection = create_connection();
+
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            idle_connections.push_back(std::move(connection));
+            total_connections++;
+            peak_connections = (std::max)(peak_connections, total_connections);
+        }
+    }
+    catch (const DatabaseException&)
+    {
+        close();
+        throw;
+    }
+
+    Utils::Logger::info("[Database] Connection pool opened (" + std::to_string(warm_count) + " warm, max " +
+                        std::to_string(config.max_size) + ")");
+    return true;
+}
+
+void Database::Connection_Pool::close()
+{
+    std::vector<std::unique_ptr<Pooled_Connection>> to_close;
+    {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        if (!is_open && total_connections == 0)
+        {
+            return;
+        }
+
+        is_open = false;
+        pool_cv.notify_all();
+
+        // Leased connections are closed by return_connection() once the pool is closed,
+        // wait for them so no lease outlives the pool
+        while (total_connections > static_cast<int>(idle_connections.size()))
+        {
+            pool_cv.wait(lock);
+        }
+
+        to_close.swap(idle_connections);
+        total_connections = 0;
+    }
+
+    for (auto& connection : to_close)
+    {
+        destroy_connection(std::move(connection));
+    }
+}
+
+bool Database::Connection_Pool::is_pool_open() const
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return is_open;
+}
+
+Database::Connection_Pool::Lease Database::Connection_Pool::acquire()
+{
+    acquire_count++;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.acquire_timeout_ms);
+    const auto health_interval = std::chrono::seconds(config.health_check_interval_seconds);
+    bool has_waited = false;
+
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    while (true)
+    {
+        if (!is_open)
+        {
+            throw DatabaseException("Connection pool is closed");
+        }
+
+        if (!idle_connections.empty())
+        {
+            std::unique_ptr<Pooled_Connection> connection = std::move(idle_connections.back());
+            idle_connections.pop_back();
+            lock.unlock();
+
+            // Only connections that sat idle for a while are probed, a busy one
+            // would have failed its last query instead
+            auto now = std::chrono::steady_clock::now();
+            if (now - connection->last_checked >= health_interval)
+            {
+                connection->last_checked = now;
+                if (!is_connection_alive(connection->hdbc))
+                {
+                    broken_count++;
+                    destroy_connection(std::move(connection));
+
+                    lock.lock();
+                    total_connections--;
+                    continue;
+                }
+            }
+
+            return Lease(this, std::move(connection));
+        }
+
+        if (total_connections < config.max_size)
+        {
+            // Reserve the slot before connecting so concurrent acquires respect max_size
+            total_connections++;
+            peak_connections = (std::max)(peak_connections, total_connections);
+            lock.unlock();
+
+            try
+            {
+                return Lease(this, create_connection());
+            }
+            catch (...)
+            {
+                lock.lock();
+                total_connections--;
+                pool_cv.notify_one();
+                throw;
+            }
+        }
+
+        if (!has_waited)
+        {
+            wait_count++;
+            has_waited = true;
+        }
+
+        if (pool_cv.wait_until(lock, deadline) == std::cv_status::timeout &&
+            idle_connections.empty() && total_connections >= config.max_size)
+        {
+            timeout_count++;
+            throw DatabaseException("Timed out waiting for a free database connection (" +
+                                    std::to_string(config.max_size) + " in use)");
+        }
+    }
+}
+
+Database::Pool_Stats Database::Connection_Pool::get_stats() const
+{
+    Pool_Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        stats.total_connections = total_connections;
+        stats.idle_connections = static_cast<int>(idle_connections.size());
+        stats.peak_connections = peak_connections;
+    }
+    stats.acquire_count = acquire_count.load();
+    stats.wait_count = wait_count.load();
+    stats.timeout_count = timeout_count.load();
+    stats.evicted_count = evicted_count.load();
+    stats.broken_count = broken_count.load();
+    return stats;
+}
+
+bool Database::Connection_Pool::is_connection_alive(SQLHDBC hdbc)
+{
+    if (hdbc == SQL_NULL_HDBC)
+    {
+        return false;
+    }
+
+    SQLUINTEGER is_dead = SQL_CD_TRUE;
+    SQLRETURN ret = SQLGetConnectAttr(hdbc, SQL_ATTR_CONNECTION_DEAD, &is_dead, SQL_IS_UINTEGER, NULL);
+    return SQL_SUCCEEDED(ret) && is_dead == SQL_CD_FALSE;
+}
+
+std::unique_ptr<Database::Pooled_Connection> Database::Connection_Pool::create_connection()
+{
+    auto connection = std::make_unique<Pooled_Connection>();
+
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_DBC, henv, &connection->hdbc);
+    if (!SQL_SUCCEEDED(ret))
+    {
+        connection->hdbc = SQL_NULL_HDBC;
+        throw DatabaseException("Failed to allocate connection handle");
+    }
+
+    std::vector<char> conn_str(connection_string.begin(), connection_string.end());
+    conn_str.push_back('\0');
+    ret = SQLDriverConnectA(connection->hdbc, NULL,
+        reinterpret_cast<SQLCHAR*>(conn_str.data()), SQL_NTS,
+        NULL, 0, NULL, SQL_DRIVER_COMPLETE);
+
+    if (!SQL_SUCCEEDED(ret))
+    {
+        std::string error = get_connection_error(connection->hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, connection->hdbc);
+        connection->hdbc = SQL_NULL_HDBC;
+        throw DatabaseException("Connection failed: " + error);
+    }
+
+    connection->statements = std::make_unique<Statement_Cache>(connection->hdbc);
+    connection->last_used = std::chrono::steady_clock::now();
+    connection->last_checked = connection->last_used;
+    return connection;
+}
+
+void Database::Connection_Pool::destroy_connection(std::unique_ptr<Pooled_Connection> connection)
+{
+    if (connection && connection->hdbc != SQL_NULL_HDBC)
+    {
+        connection->statements.reset();
+
+        // SQLDisconnect refuses to close a connection with an open transaction
+        SQLEndTran(SQL_HANDLE_DBC, connection->hdbc, SQL_ROLLBACK);
+        SQLDisconnect(connection->hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, connection->hdbc);
+        connection->hdbc = SQL_NULL_HDBC;
+    }
+}
+
+void Database::Connection_Pool::return_connection(std::unique_ptr<Pooled_Connection> connection)
+{
+    std::unique_ptr<Pooled_Connection> to_close;
+    std::vector<std::unique_ptr<Pooled_Connection>> victims;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+
+        if (connection->is_broken || !is_open)
+        {
+            if (connection->is_broken)
+            {
+                broken_count++;
+            }
+            to_close = std::move(connection);
+            total_connections--;
+        }
+        else
+        {
+            connection->last_used = std::chrono::steady_clock::now();
+            idle_connections.push_back(std::move(connection));
+            victims = collect_idle_victims();
+        }
+
+        pool_cv.notify_all();
+    }
+
+    // Disconnecting is a network round trip, keep it outside the lock
+    destroy_connection(std::move(to_close));
+    for (auto& victim : victims)
+    {
+        destroy_connection(std::move(victim));
+    }
+}
+
+std::vector<std::unique_ptr<Database::Pooled_Connection>> Database::Connection_Pool::collect_idle_victims()
+{
+    // Caller holds pool_mutex. Idle connections are reused LIFO, so the front
+    // of the vector holds the ones that have been unused the longest
+    std::vector<std::unique_ptr<Pooled_Connection>> victims;
+    const auto cutoff = std::chrono::steady_clock::now() - std::chrono::seconds(config.idle_timeout_seconds);
+
+    size_t expired = 0;
+    while (expired < idle_connections.size() &&
+           total_connections - static_cast<int>(expired) > config.min_size &&
+           idle_connections[expired]->last_used < cutoff)
+    {
+        expired++;
+    }
+
+    for (size_t i = 0; i < expired; i++)
+    {
+        victims.push_back(std::move(idle_connections[i]));
+    }
+    idle_connections.erase(idle_connections.begin(), idle_connections.begin() + expired);
+    total_connections -= static_cast<int>(expired);
+    evicted_count += static_cast<long long>(expired);
+
+    return victims;
+}
+
+std::string Database::Connection_Pool::get_connection_error(SQLHDBC hdbc) const
+{
+    SQLCHAR sql_state[6];
+    SQLCHAR error_msg[1024];
+    SQLINTEGER native_error;
+    SQLSMALLINT msg_len;
+
+    SQLRETURN ret = SQLGetDiagRecA(SQL_HANDLE_DBC, hdbc, 1, sql_state, &native_error,
+        error_msg, sizeof(error_msg), &msg_len);
+
+    if (SQL_SUCCEEDED(ret))
+    {
+        return "SQL State: " + std::string(reinterpret_cast<char*>(sql_state)) +
+               ", Error: " + std::string(reinterpret_cast<char*>(error_msg));
+    }
+
+    return "Unknown SQL error";
+}
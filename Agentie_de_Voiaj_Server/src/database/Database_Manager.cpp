@@ -5,9 +5,17 @@
 
 using namespace Utils::Exceptions;
 
+namespace
+{
+    // Last ODBC error seen by the calling thread, queries no longer share one statement handle
+    thread_local std::string last_sql_error;
+}
+
 // Constructor
 Database::Database_Manager::Database_Manager() 
-    : henv(SQL_NULL_HENV), hdbc(SQL_NULL_HDBC), hstmt(SQL_NULL_HSTMT), is_connected(false), is_demo_mode(false)
+    : henv(SQL_NULL_HENV), active_transactions(0), statement_cache_hits(0), statement_cache_misses(0),
+      use_booking_procedure(Config::Database::USE_BOOKING_PROCEDURE), use_seat_counters(Config::Database::USE_SEAT_COUNTERS),
+      destinations_version(Offer_Catalog::next_version(0)), is_connected(false), is_demo_mode(false)
 {
     initialize_handles();
 }
@@ -15,7 +23,9 @@ Database::Database_Manager::Database_Manager()
 Database::Database_Manager::Database_Manager(const std::string& server, const std::string& database, 
     const std::string& username, const std::string& password)
     : server(server), database(database), username(username), password(password),
-    henv(SQL_NULL_HENV), hdbc(SQL_NULL_HDBC), hstmt(SQL_NULL_HSTMT), is_connected(false), is_demo_mode(false)
+    henv(SQL_NULL_HENV), active_transactions(0), statement_cache_hits(0), statement_cache_misses(0),
+    use_booking_procedure(Config::Database::USE_BOOKING_PROCEDURE), use_seat_counters(Config::Database::USE_SEAT_COUNTERS),
+    destinations_version(Offer_Catalog::next_version(0)), is_connected(false), is_demo_mode(false)
 {
     // Check if this is a dummy instance (demo mode)
     if (server == "dummy" && database == "dummy")
@@ -53,31 +63,14 @@ bool Database::Database_Manager::initialize_handles()
         return false;
     }
 
-    ret = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
-    if (!SQL_SUCCEEDED(ret))
-    {
-        log_error("initialize_handles", "Failed to allocate connection handle");
-        return false;
-    }
-
+    // Connection handles are owned by the pool, created on connect()
     return true;
 }
 
 // Cleanup ODBC handles
 void Database::Database_Manager::cleanup_handles()
 {
-    if (hstmt != SQL_NULL_HSTMT)
-    {
-        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
-        hstmt = SQL_NULL_HSTMT;
-    }
-
-    if (hdbc != SQL_NULL_HDBC)
-    {
-        SQLDisconnect(hdbc);
-        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
-        hdbc = SQL_NULL_HDBC;
-    }
+    connection_pool.reset();
 
     if (henv != SQL_NULL_HENV)
     {
@@ -128,25 +121,37 @@ bool Database::Database_Manager::connect()
         return false;
     }
 
-    std::vector<char> conn_str(connection_string.begin(), connection_string.end());
-    conn_str.push_back('\0');
-    SQLRETURN ret = SQLDriverConnectA(hdbc, NULL, 
-        reinterpret_cast<SQLCHAR*>(conn_str.data()), SQL_NTS,
-        NULL, 0, NULL, SQL_DRIVER_COMPLETE);
+    if (henv == SQL_NULL_HENV && !initialize_handles())
+    {
+        return false;
+    }
 
-    if (SQL_SUCCEEDED(ret))
+    auto pool = std::make_unique<Connection_Pool>(henv, connection_string, pool_config);
+    try
     {
-        is_connected = true;
-        Utils::Logger::info("Database connection successful to: " + server + "\\" + database);
-        return true;
+        pool->open();
     }
-    else
+    catch (const DatabaseException& e)
     {
-        std::string error = get_sql_error(SQL_HANDLE_DBC, hdbc);
-        std::string detailed_error = "Connection failed to " + server + "\\" + database + ": " + error;
+        std::string detailed_error = "Connection failed to " + server + "\\" + database + ": " + e.what();
+        last_sql_error = detailed_error;
         Utils::Logger::error(detailed_error);
         throw DatabaseException(detailed_error, WSAGetLastError());
     }
+
+    connection_pool = std::move(pool);
+    is_connected = true;
+
+    if (Config::Database::USE_OFFER_CATALOG)
+    {
+        offer_catalog = std::make_shared<Offer_Catalog>(this);
+    }
+    if (Config::Database::USE_SEAT_COUNTERS)
+    {
+        seat_counters = std::make_shared<Seat_Counters>(this);
+    }
+    Utils::Logger::info("Database connection successful to: " + server + "\\" + database);
+    return true;
 }
 
 bool Database::Database_Manager::connect(const std::string& server, const std::string& database,
@@ -165,29 +170,52 @@ bool Database::Database_Manager::disconnect()
         return true;
     }
 
-    SQLRETURN ret = SQLDisconnect(hdbc);
     is_connected = false;
+    offer_catalog.reset();
+    seat_counters.reset();
     
-    return SQL_SUCCEEDED(ret);
+    // Pinned transaction connections go back (and get rolled back) before the pool closes
+    {
+        std::lock_guard<std::mutex> transaction_lock(transaction_mutex);
+        transaction_connections.clear();
+        active_transactions = 0;
+    }
+    
+    if (connection_pool)
+    {
+        connection_pool->close();
+        connection_pool.reset();
+    }
+    
+    return true;
 }
 
 bool Database::Database_Manager::is_connection_alive() const
 {
-    if (!is_connected) return false;
+    if (!is_connected || !connection_pool) return false;
     
-    SQLRETURN ret = SQLGetConnectAttr(hdbc, SQL_ATTR_CONNECTION_DEAD, NULL, 0, NULL);
-    return SQL_SUCCEEDED(ret);
+    try
+    {
+        Connection_Pool::Lease lease = connection_pool->acquire();
+        return Connection_Pool::is_connection_alive(lease.get_hdbc());
+    }
+    catch (const DatabaseException&)
+    {
+        return false;
+    }
 }
 
 bool Database::Database_Manager::database_exists() const
 {
-    if (!is_connected) return false;
+    if (!is_connected || !connection_pool) return false;
     
     try
     {
+        Connection_Pool::Lease lease = connection_pool->acquire();
+        
         // Try to query the database to see if it exists
         SQLHSTMT temp_stmt;
-        SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &temp_stmt);
+        SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, lease.get_hdbc(), &temp_stmt);
         if (!SQL_SUCCEEDED(ret)) return false;
         
         // Simple query to test database access
@@ -224,24 +252,131 @@ std::string Database::Database_Manager::get_connection_string() const
     return connection_string;
 }
 
-// Query execution methods
-Database::Query_Result Database::Database_Manager::execute_query(const std::string& query)
+void Database::Database_Manager::set_pool_config(const Pool_Config& config)
 {
     std::lock_guard<std::mutex> lock(db_mutex);
+    pool_config = config; // Takes effect on the next connect()
+}
+
+Database::Pool_Stats Database::Database_Manager::get_pool_stats() const
+{
+    return connection_pool ? connection_pool->get_stats() : Pool_Stats();
+}
+
+Database::Fetch_Stats Database::Database_Manager::get_fetch_stats() const
+{
+    std::lock_guard<std::mutex> lock(fetch_stats_mutex);
+    return fetch_stats;
+}
+
+std::shared_ptr<Database::Offer_Catalog> Database::Database_Manager::get_offer_catalog()
+{
+    std::lock_guard<std::mutex> lock(db_mutex);
+    return offer_catalog;
+}
+
+std::shared_ptr<Database::Seat_Counters> Database::Database_Manager::get_seat_counters()
+{
+    std::lock_guard<std::mutex> lock(db_mutex);
+    return seat_counters;
+}
+
+void Database::Database_Manager::notify_offer_changed(int offer_id, Offer_Change change)
+{
+    auto catalog = get_offer_catalog();
+    if (catalog)
+    {
+        catalog->on_offer_changed(offer_id, change);
+    }
     
-    if (!is_connected)
+    std::vector<std::function<void(int, Offer_Change)>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(offer_listeners_mutex);
+        for (const auto& entry : offer_listeners)
+        {
+            listeners.push_back(entry.second);
+        }
+    }
+    for (const auto& listener : listeners)
+    {
+        listener(offer_id, change);
+    }
+}
+
+int Database::Database_Manager::add_offer_listener(std::function<void(int, Offer_Change)> listener)
+{
+    std::lock_guard<std::mutex> lock(offer_listeners_mutex);
+    int listener_id = next_offer_listener_id++;
+    offer_listeners.emplace_back(listener_id, std::move(listener));
+    return listener_id;
+}
+
+void Database::Database_Manager::remove_offer_listener(int listener_id)
+{
+    std::lock_guard<std::mutex> lock(offer_listeners_mutex);
+    offer_listeners.erase(std::remove_if(offer_listeners.begin(), offer_listeners.end(),
+        [listener_id](const std::pair<int, std::function<void(int, Offer_Change)>>& entry)
+        {
+            return entry.first == listener_id;
+        }), offer_listeners.end());
+}
+
+void Database::Database_Manager::on_destinations_changed()
+{
+    long long current = destinations_version.load();
+    while (!destinations_version.compare_exchange_weak(current, Offer_Catalog::next_version(current)))
+    {
+    }
+
+    // Offer rows carry the destination name and country, joined in: no Date_Modified delta for those
+    auto catalog = get_offer_catalog();
+    if (catalog)
+    {
+        catalog->invalidate();
+    }
+}
+
+Database::Statement_Cache_Stats Database::Database_Manager::get_statement_cache_stats() const
+{
+    Statement_Cache_Stats stats;
+    stats.hits = statement_cache_hits.load();
+    stats.misses = statement_cache_misses.load();
+    return stats;
+}
+
+void Database::Database_Manager::set_use_booking_procedure(bool enabled)
+{
+    use_booking_procedure = enabled;
+}
+
+void Database::Database_Manager::set_use_seat_counters(bool enabled)
+{
+    use_seat_counters = enabled;
+}
+
+// Query execution methods
+Database::Query_Result Database::Database_Manager::execute_query(const std::string& query)
+{
+    if (!is_connected || !connection_pool)
     {
         return Query_Result(Result_Type::ERROR_CONNECTION, "Not connected to database");
     }
 
-    if (hstmt != SQL_NULL_HSTMT)
+    // Inside a transaction the thread keeps its pinned connection,
+    // otherwise a connection is borrowed for this statement only
+    Connection_Pool::Lease borrowed;
+    Connection_Pool::Lease* lease = get_transaction_connection();
+    if (!lease)
     {
-        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        borrowed = connection_pool->acquire();
+        lease = &borrowed;
     }
 
-    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+    SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_STMT, lease->get_hdbc(), &hstmt);
     if (!SQL_SUCCEEDED(ret))
     {
+        lease->invalidate();
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to allocate statement handle");
     }
 
@@ -251,6 +386,14 @@ Database::Query_Result Database::Database_Manager::execute_query(const std::stri
     if (!SQL_SUCCEEDED(ret))
     {
         std::string error = get_sql_error(SQL_HANDLE_STMT, hstmt);
+        
+        // SQLSTATE class 08 is a connection failure, don't hand this connection out again
+        if (get_sql_state(SQL_HANDLE_STMT, hstmt).compare(0, 2, "08") == 0)
+        {
+            lease->invalidate();
+        }
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        last_sql_error = error;
         throw DatabaseException("Query execution failed: " + error, ret);
     }
 
@@ -258,14 +401,19 @@ Database::Query_Result Database::Database_Manager::execute_query(const std::stri
     std::string upper_query = query;
     std::transform(upper_query.begin(), upper_query.end(), upper_query.begin(), ::toupper);
     
-    if (upper_query.find("SELECT") == 0)
+    Query_Result result;
+    try
     {
-        return process_select_result();
+        result = upper_query.find("SELECT") == 0 ? process_select_result(lease->get_hdbc(), hstmt) : process_execution_result(hstmt);
     }
-    else
+    catch (...)
     {
-        return process_execution_result();
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        throw;
     }
+    
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::execute_select(const std::string& query)
@@ -289,60 +437,27 @@ Database::Query_Result Database::Database_Manager::execute_delete(const std::str
 }
 
 // Process SELECT result
-Database::Query_Result Database::Database_Manager::process_select_result()
+Database::Query_Result Database::Database_Manager::process_select_result(SQLHDBC hdbc, SQLHSTMT hstmt)
 {
     Query_Result result;
-    SQLSMALLINT columns;
-    SQLRETURN ret = SQLNumResultCols(hstmt, &columns);
-    
-    if (!SQL_SUCCEEDED(ret))
-    {
-        return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to get column count");
-    }
+    Row_Fetcher fetcher(hdbc, hstmt);
+    bool fetched = fetcher.fetch_all(result.data);
 
-    // Get column names
-    std::vector<std::string> column_names;
-    for (SQLSMALLINT i = 1; i <= columns; i++)
     {
-        SQLCHAR column_name[256];
-        SQLSMALLINT name_len;
-        ret = SQLColAttribute(hstmt, i, SQL_DESC_NAME, column_name, sizeof(column_name), &name_len, NULL);
-        if (SQL_SUCCEEDED(ret))
-        {
-            column_names.push_back(std::string(reinterpret_cast<char*>(column_name), name_len));
-        }
+        std::lock_guard<std::mutex> lock(fetch_stats_mutex);
+        fetch_stats.add(fetcher.get_stats());
     }
 
-    // Fetch rows
-    while (SQLFetch(hstmt) == SQL_SUCCESS)
+    if (!fetched)
     {
-        std::map<std::string, std::string> row;
-        
-        for (SQLSMALLINT i = 1; i <= columns; i++)
-        {
-            SQLCHAR data[1024];
-            SQLLEN indicator;
-            ret = SQLGetData(hstmt, i, SQL_C_CHAR, data, sizeof(data), &indicator);
-            
-            std::string value;
-            if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA)
-            {
-                value = std::string(reinterpret_cast<char*>(data));
-            }
-            
-            if (i - 1 < column_names.size())
-            {
-                row[column_names[i - 1]] = value;
-            }
-        }
-        result.data.push_back(row);
+        return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to fetch rows: " + get_sql_error(SQL_HANDLE_STMT, hstmt));
     }
 
     return result;
 }
 
 // Process non-SELECT result
-Database::Query_Result Database::Database_Manager::process_execution_result()
+Database::Query_Result Database::Database_Manager::process_execution_result(SQLHSTMT hstmt)
 {
     Database::Query_Result result;
     SQLLEN affected_rows;
@@ -385,9 +500,19 @@ std::string Database::Database_Manager::get_sql_error(SQLSMALLINT handle_type, S
     return "Unknown SQL error";
 }
 
+std::string Database::Database_Manager::get_sql_state(SQLSMALLINT handle_type, SQLHANDLE handle)
+{
+    SQLCHAR sql_state[6] = { 0 };
+    SQLINTEGER native_error;
+    SQLSMALLINT msg_len;
+    
+    SQLRETURN ret = SQLGetDiagRecA(handle_type, handle, 1, sql_state, &native_error, NULL, 0, &msg_len);
+    return SQL_SUCCEEDED(ret) ? std::string(reinterpret_cast<char*>(sql_state)) : std::string();
+}
+
 std::string Database::Database_Manager::get_last_error()
 {
-    return get_sql_error(SQL_HANDLE_STMT, hstmt);
+    return last_sql_error;
 }
 
 void Database::Database_Manager::log_error(const std::string& operation, const std::string& error)
@@ -412,32 +537,128 @@ bool Database::Database_Manager::validate_connection_params()
 }
 
 // Transaction methods
+// A transaction pins one pooled connection to the calling thread; every
+// execute_query() on that thread uses it until commit or rollback.
 bool Database::Database_Manager::begin_transaction()
 {
-    std::lock_guard<std::mutex> lock(db_mutex);
-    SQLRETURN ret = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
-    return SQL_SUCCEEDED(ret);
+    if (!is_connected || !connection_pool)
+    {
+        return false;
+    }
+    
+    // A transaction left open on this thread (not through Transaction_Scope),
+    // end it instead of leaking the pinned connection
+    if (get_transaction_connection())
+    {
+        Utils::Logger::warning("[Database] Rolling back unfinished transaction on this thread");
+        end_transaction(SQL_ROLLBACK);
+    }
+    
+    Connection_Pool::Lease lease;
+    try
+    {
+        lease = connection_pool->acquire();
+    }
+    catch (const DatabaseException& e)
+    {
+        log_error("begin_transaction", e.what());
+        return false;
+    }
+    
+    SQLRETURN ret = SQLSetConnectAttr(lease.get_hdbc(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+    if (!SQL_SUCCEEDED(ret))
+    {
+        lease.invalidate();
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(transaction_mutex);
+    transaction_connections[std::this_thread::get_id()] = std::move(lease);
+    active_transactions++;
+    return true;
 }
 
 bool Database::Database_Manager::commit_transaction()
 {
-    std::lock_guard<std::mutex> lock(db_mutex);
-    SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT);
-    SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
-    return SQL_SUCCEEDED(ret);
+    return end_transaction(SQL_COMMIT);
 }
 
 bool Database::Database_Manager::rollback_transaction()
 {
-    std::lock_guard<std::mutex> lock(db_mutex);
-    SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK);
-    SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+    return end_transaction(SQL_ROLLBACK);
+}
+
+Database::Connection_Pool::Lease* Database::Database_Manager::get_transaction_connection()
+{
+    // Skip the map lookup entirely in the common no-transaction case
+    if (active_transactions.load() == 0)
+    {
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(transaction_mutex);
+    auto it = transaction_connections.find(std::this_thread::get_id());
+    return it != transaction_connections.end() ? &it->second : nullptr;
+}
+
+bool Database::Database_Manager::end_transaction(SQLSMALLINT completion_type)
+{
+    Connection_Pool::Lease lease;
+    {
+        std::lock_guard<std::mutex> lock(transaction_mutex);
+        auto it = transaction_connections.find(std::this_thread::get_id());
+        if (it == transaction_connections.end())
+        {
+            return false;
+        }
+        lease = std::move(it->second);
+        transaction_connections.erase(it);
+        active_transactions--;
+    }
+    
+    SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, lease.get_hdbc(), completion_type);
+    SQLRETURN restore_ret = SQLSetConnectAttr(lease.get_hdbc(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+    
+    // Never return a connection to the pool with a transaction possibly still open
+    if (!SQL_SUCCEEDED(ret) || !SQL_SUCCEEDED(restore_ret))
+    {
+        lease.invalidate();
+    }
+    
     return SQL_SUCCEEDED(ret);
 }
 
+// ============================================================================
+// Transaction_Scope Implementation
+// ============================================================================
+
+Database::Transaction_Scope::Transaction_Scope(Database_Manager& manager)
+    : manager(manager), is_open(manager.begin_transaction())
+{
+}
+
+Database::Transaction_Scope::~Transaction_Scope()
+{
+    if (is_open)
+    {
+        manager.rollback_transaction();
+    }
+}
+
+bool Database::Transaction_Scope::commit()
+{
+    if (!is_open)
+    {
+        return false;
+    }
+    is_open = false;
+    return manager.commit_transaction();
+}
+
 Database::Query_Result Database::Database_Manager::execute_transaction(const std::vector<std::string>& queries)
 {
-    if (!begin_transaction())
+    Transaction_Scope transaction(*this);
+    if (!transaction.is_started())
     {
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to begin transaction");
     }
@@ -447,14 +668,12 @@ Database::Query_Result Database::Database_Manager::execute_transaction(const std
         Query_Result result = execute_query(query);
         if (!result.is_success())
         {
-            rollback_transaction();
             return result;
         }
     }
 
-    if (!commit_transaction())
+    if (!transaction.commit())
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to commit transaction");
     }
 
@@ -503,20 +722,38 @@ Database::Query_Result Database::Database_Manager::authenticate_user(const std::
         return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid username or password format");
     }
     
-    // First get the user's salt from database
-    std::string salt_query = "SELECT Password_Salt FROM Users WHERE Username = '" + escape_string(username) + "'";
-    Query_Result salt_result = execute_select(salt_query);
-    if (!salt_result.is_success() || salt_result.data.empty())
+    if (unknown_users.contains(username))
     {
         return Query_Result(Result_Type::DB_ERROR_NO_DATA, "Invalid username or password");
     }
-    
-    std::string stored_salt = salt_result.data[0]["Password_Salt"];
-    std::string hashed_password = hash_password(password, stored_salt);
-    
-    std::string query = "SELECT User_ID, Username, Email, First_Name, Last_Name, Phone FROM Users WHERE Username = '" 
-                       + escape_string(username) + "' AND Password_Hash = '" + escape_string(hashed_password) + "'";
-    return execute_select(query);
+
+    // One seek on IX_Users_Username, the hash is compared here instead of in a second query
+    Query_Result user_result = execute_prepared("SELECT User_ID AS ID, Username, Email, First_Name, Last_Name, Phone, "
+                                                "Password_Salt, Password_Hash FROM Users WHERE Username = ?", { username });
+    if (!user_result.is_success())
+    {
+        return user_result;
+    }
+    if (user_result.data.empty())
+    {
+        unknown_users.add(username);
+        return Query_Result(Result_Type::DB_ERROR_NO_DATA, "Invalid username or password");
+    }
+
+    auto row = user_result.data[0];
+    if (!Utils::Crypto::verify_password(password, row["Password_Hash"], row["Password_Salt"]))
+    {
+        return Query_Result(Result_Type::DB_ERROR_NO_DATA, "Invalid username or password");
+    }
+
+    // The row goes back to the client, the credentials stay here
+    std::map<std::string, std::string> user_data = row.to_map();
+    user_data.erase("Password_Salt");
+    user_data.erase("Password_Hash");
+
+    Query_Result result(Result_Type::SUCCESS, "Authentication successful");
+    result.data.push_back(user_data);
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::register_user(const User_Data& user_data)
@@ -581,13 +818,18 @@ Database::Query_Result Database::Database_Manager::register_user(const User_Data
           << escape_string(user_data.last_name) << "', '"
           << escape_string(user_data.phone_number) << "')";
     
-    return execute_insert(query.str());
+    Query_Result result = execute_insert(query.str());
+    if (result.is_success())
+    {
+        unknown_users.remove(user_data.username);
+    }
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::get_user_by_id(int user_id)
 {
-    std::string query = "SELECT User_ID, Username, Email, First_Name, Last_Name, Phone, Date_Created, Date_Modified FROM Users WHERE User_ID = " + std::to_string(user_id);
-    return execute_select(query);
+    return execute_prepared("SELECT User_ID, Username, Email, First_Name, Last_Name, Phone, Date_Created, Date_Modified "
+                            "FROM Users WHERE User_ID = ?", { user_id });
 }
 
 Database::Query_Result Database::Database_Manager::get_user_by_username(const std::string& username)
@@ -625,22 +867,16 @@ Database::Query_Result Database::Database_Manager::change_password(int user_id,
         return Query_Result(Result_Type::DB_ERROR_NO_DATA, "User not found");
     }
     
-    // Get current salt to verify old password
-    std::string current_salt_query = "SELECT Password_Salt FROM Users WHERE User_ID = " + std::to_string(user_id);
-    Query_Result salt_result = execute_select(current_salt_query);
-    if (!salt_result.is_success() || salt_result.data.empty())
+    // Salt and hash in one fetch, compared in constant time like a login
+    Query_Result credentials_result = execute_prepared("SELECT Password_Salt, Password_Hash FROM Users WHERE User_ID = ?",
+                                                       { user_id });
+    if (!credentials_result.is_success() || credentials_result.data.empty())
     {
         return Query_Result(Result_Type::DB_ERROR_NO_DATA, "User salt not found");
     }
     
-    std::string current_salt = salt_result.data[0]["Password_Salt"];
-    std::string old_hash = hash_password(old_password, current_salt);
-    
-    std::string verify_query = "SELECT User_ID FROM Users WHERE User_ID = " + std::to_string(user_id) + 
-                              " AND Password_Hash = '" + escape_string(old_hash) + "'";
-    Query_Result verify_result = execute_select(verify_query);
-    
-    if (!verify_result.is_success() || verify_result.data.empty())
+    auto credentials = credentials_result.data[0];
+    if (!Utils::Crypto::verify_password(old_password, credentials["Password_Hash"], credentials["Password_Salt"]))
     {
         return Query_Result(Result_Type::ERROR_EXECUTION, "Invalid old password");
     }
@@ -679,13 +915,13 @@ bool Database::Database_Manager::validate_cnp(const std::string& cnp)
 // Destination management
 Database::Query_Result Database::Database_Manager::get_all_destinations()
 {
-    std::string query = "SELECT Destination_ID, Name, Country, Description, Image_Path, Date_Created, Date_Modified FROM Destinations ORDER BY Name";
+    std::string query = "SELECT Destination_ID, Name, Country, Image_Path, Date_Created, Date_Modified, Description FROM Destinations ORDER BY Name";
     return execute_select(query);
 }
 
 Database::Query_Result Database::Database_Manager::get_destination_by_id(int destination_id)
 {
-    std::string query = "SELECT Destination_ID, Name, Country, Description, Image_Path, Date_Created, Date_Modified FROM Destinations WHERE Destination_ID = " + std::to_string(destination_id);
+    std::string query = "SELECT Destination_ID, Name, Country, Image_Path, Date_Created, Date_Modified, Description FROM Destinations WHERE Destination_ID = " + std::to_string(destination_id);
     return execute_select(query);
 }
 
@@ -698,7 +934,12 @@ Database::Query_Result Database::Database_Manager::add_destination(const Destina
           << escape_string(destination.description) << "', '"
           << escape_string(destination.image_path) << "')";
     
-    return execute_insert(query.str());
+    auto result = execute_insert(query.str());
+    if (result.is_success())
+    {
+        on_destinations_changed();
+    }
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::update_destination(const Destination_Data& destination)
@@ -712,13 +953,23 @@ Database::Query_Result Database::Database_Manager::update_destination(const Dest
           << "Date_Modified = GETDATE() "
           << "WHERE Destination_ID = " << destination.id;
     
-    return execute_update(query.str());
+    auto result = execute_update(query.str());
+    if (result.is_success())
+    {
+        on_destinations_changed();
+    }
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::delete_destination(int destination_id)
 {
     std::string query = "DELETE FROM Destinations WHERE Destination_ID = " + std::to_string(destination_id);
-    return execute_delete(query);
+    auto result = execute_delete(query);
+    if (result.is_success())
+    {
+        on_destinations_changed();
+    }
+    return result;
 }
 
 // Transport types management
@@ -870,8 +1121,9 @@ Database::Query_Result Database::Database_Manager::get_all_offers()
 {
     std::string query = "SELECT o.Offer_ID, o.Name, o.Destination_ID, o.Accommodation_ID, o.Types_of_Transport_ID, "
                        "o.Price_per_Person, o.Duration_Days, o.Departure_Date, o.Return_Date, o.Total_Seats, "
-                       "o.Reserved_Seats, o.Included_Services, o.Description, o.Status, o.Date_Created, o.Date_Modified, "
-                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name "
+                       "o.Reserved_Seats, o.Status, o.Date_Created, o.Date_Modified, "
+                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name, "
+                       "o.Included_Services, o.Description " // TEXT columns last so the rest can be bound
                        "FROM Offers o "
                        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
                        "LEFT JOIN Accommodations a ON o.Accommodation_ID = a.Accommodation_ID "
@@ -884,8 +1136,9 @@ Database::Query_Result Database::Database_Manager::get_available_offers()
 {
     std::string query = "SELECT o.Offer_ID, o.Name, o.Destination_ID, o.Accommodation_ID, o.Types_of_Transport_ID, "
                        "o.Price_per_Person, o.Duration_Days, o.Departure_Date, o.Return_Date, o.Total_Seats, "
-                       "o.Reserved_Seats, o.Included_Services, o.Description, o.Status, o.Date_Created, o.Date_Modified, "
-                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name "
+                       "o.Reserved_Seats, o.Status, o.Date_Created, o.Date_Modified, "
+                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name, "
+                       "o.Included_Services, o.Description " // TEXT columns last so the rest can be bound
                        "FROM Offers o "
                        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
                        "LEFT JOIN Accommodations a ON o.Accommodation_ID = a.Accommodation_ID "
@@ -899,74 +1152,100 @@ Database::Query_Result Database::Database_Manager::get_offer_by_id(int offer_id)
 {
     std::string query = "SELECT o.Offer_ID, o.Name, o.Destination_ID, o.Accommodation_ID, o.Types_of_Transport_ID, "
                        "o.Price_per_Person, o.Duration_Days, o.Departure_Date, o.Return_Date, o.Total_Seats, "
-                       "o.Reserved_Seats, o.Included_Services, o.Description, o.Status, o.Date_Created, o.Date_Modified, "
-                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name "
+                       "o.Reserved_Seats, o.Status, o.Date_Created, o.Date_Modified, "
+                       "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name, "
+                       "o.Included_Services, o.Description " // TEXT columns last so the rest can be bound
                        "FROM Offers o "
                        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
                        "LEFT JOIN Accommodations a ON o.Accommodation_ID = a.Accommodation_ID "
                        "LEFT JOIN Types_of_Transport t ON o.Types_of_Transport_ID = t.Transport_Type_ID "
-                       "WHERE o.Offer_ID = " + std::to_string(offer_id);
-    return execute_select(query);
+                       "WHERE o.Offer_ID = ?";
+    return execute_prepared(query, { offer_id });
 }
 
 Database::Query_Result Database::Database_Manager::search_offers(const std::string& destination, double min_price, double max_price,
     const std::string& start_date, const std::string& end_date)
 {
     // Validate search parameters
-    if (!Utils::Validation::is_valid_price_range(min_price, max_price))
+    Offer_Search_Criteria criteria;
+    criteria.min_price = min_price;
+    criteria.max_price = max_price;
+    criteria.start_date = start_date;
+    criteria.end_date = end_date;
+    Query_Result validation = validate_search_criteria(criteria);
+    if (!validation.is_success())
     {
-        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid price range");
-    }
-    
-    if (!start_date.empty() && !Utils::DateTime::is_valid_date(start_date))
-    {
-        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid start date format");
-    }
-    
-    if (!end_date.empty() && !Utils::DateTime::is_valid_date(end_date))
-    {
-        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid end date format");
+        return validation;
     }
     
     std::stringstream query;
     query << "SELECT o.Offer_ID, o.Name, o.Destination_ID, o.Accommodation_ID, o.Types_of_Transport_ID, "
           << "o.Price_per_Person, o.Duration_Days, o.Departure_Date, o.Return_Date, o.Total_Seats, "
-          << "o.Reserved_Seats, o.Included_Services, o.Description, o.Status, o.Date_Created, o.Date_Modified, "
-          << "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name "
+          << "o.Reserved_Seats, o.Status, o.Date_Created, o.Date_Modified, "
+          << "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name, "
+          << "o.Included_Services, o.Description " // TEXT columns last so the rest can be bound
           << "FROM Offers o "
           << "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
           << "LEFT JOIN Accommodations a ON o.Accommodation_ID = a.Accommodation_ID "
           << "LEFT JOIN Types_of_Transport t ON o.Types_of_Transport_ID = t.Transport_Type_ID "
           << "WHERE o.Status = 'active' AND o.Reserved_Seats < o.Total_Seats";
 
+    // Only the filter combination changes the SQL text, so each one is prepared once per connection
+    std::vector<Sql_Param> params;
     if (!Utils::String::is_empty(destination))
     {
-        query << " AND (d.Name LIKE '%" << escape_string(destination) << "%' OR d.Country LIKE '%" << escape_string(destination) << "%')";
+        query << " AND (d.Name LIKE ? OR d.Country LIKE ?)";
+        params.push_back("%" + destination + "%");
+        params.push_back("%" + destination + "%");
     }
     
     if (min_price > 0)
     {
-        query << " AND o.Price_per_Person >= " << Utils::Conversion::double_to_string(min_price);
+        query << " AND o.Price_per_Person >= ?";
+        params.push_back(min_price);
     }
     
     if (max_price > 0)
     {
-        query << " AND o.Price_per_Person <= " << Utils::Conversion::double_to_string(max_price);
+        query << " AND o.Price_per_Person <= ?";
+        params.push_back(max_price);
     }
     
     if (!Utils::String::is_empty(start_date))
     {
-        query << " AND o.Departure_Date >= '" << escape_string(start_date) << "'";
+        query << " AND o.Departure_Date >= ?";
+        params.push_back(start_date);
     }
     
     if (!Utils::String::is_empty(end_date))
     {
-        query << " AND o.Return_Date <= '" << escape_string(end_date) << "'";
+        query << " AND o.Return_Date <= ?";
+        params.push_back(end_date);
     }
     
     query << " ORDER BY o.Departure_Date";
     
-    return execute_select(query.str());
+    return execute_prepared(query.str(), params);
+}
+
+Database::Query_Result Database::Database_Manager::validate_search_criteria(const Offer_Search_Criteria& criteria)
+{
+    if (!Utils::Validation::is_valid_price_range(criteria.min_price, criteria.max_price))
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid price range");
+    }
+    
+    if (!criteria.start_date.empty() && !Utils::DateTime::is_valid_date(criteria.start_date))
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid start date format");
+    }
+    
+    if (!criteria.end_date.empty() && !Utils::DateTime::is_valid_date(criteria.end_date))
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Invalid end date format");
+    }
+    
+    return Query_Result();
 }
 
 Database::Query_Result Database::Database_Manager::add_offer(const Offer_Data& offer)
@@ -989,7 +1268,12 @@ Database::Query_Result Database::Database_Manager::add_offer(const Offer_Data& o
           << escape_string(offer.description) << "', '"
           << escape_string(offer.status) << "')";
     
-    return execute_insert(query.str());
+    Query_Result result = execute_insert(query.str());
+    if (result.is_success())
+    {
+        notify_offer_changed(0, Offer_Change::MODIFIED);
+    }
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::update_offer(const Offer_Data& offer)
@@ -1012,40 +1296,148 @@ Database::Query_Result Database::Database_Manager::update_offer(const Offer_Data
           << "Date_Modified = GETDATE() "
           << "WHERE Offer_ID = " << offer.id;
     
-    return execute_update(query.str());
+    Query_Result result = execute_update(query.str());
+    if (result.is_success())
+    {
+        // Total_Seats may have changed
+        if (auto counters = get_seat_counters())
+        {
+            counters->reconcile_offer(offer.id);
+        }
+        notify_offer_changed(offer.id, Offer_Change::MODIFIED);
+    }
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::delete_offer(int offer_id)
 {
     std::string query = "DELETE FROM Offers WHERE Offer_ID = " + std::to_string(offer_id);
-    return execute_delete(query);
+    Query_Result result = execute_delete(query);
+    if (result.is_success())
+    {
+        if (auto counters = get_seat_counters())
+        {
+            counters->forget(offer_id);
+        }
+        notify_offer_changed(offer_id, Offer_Change::DELETED);
+    }
+    return result;
 }
 
 // Reservation management
-Database::Query_Result Database::Database_Manager::book_offer(int user_id, int offer_id, int person_count)
+Database::Query_Result Database::Database_Manager::book_offer(int user_id, int offer_id, int person_count,
+    const std::vector<Reservation_Person_Data>& persons)
 {
     // Validate parameters
     if (!Utils::Validation::is_valid_person_count(person_count))
     {
         return Database::Query_Result(Database::Result_Type::ERROR_CONSTRAINT, "Invalid person count");
     }
-    
+    if (!persons.empty() && static_cast<int>(persons.size()) != person_count)
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Traveler details must be given for every person");
+    }
+
+    // A sold out offer is refused here, before the booking waits on the offer's row lock
+    auto counters = use_seat_counters ? get_seat_counters() : nullptr;
+    Seat_Hold hold = counters ? counters->try_hold(offer_id, person_count) : Seat_Hold::UNKNOWN;
+    if (hold == Seat_Hold::SOLD_OUT)
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Not enough available seats");
+    }
+
+    Query_Result result;
+    try
+    {
+        result = use_booking_procedure ? book_offer_with_procedure(user_id, offer_id, person_count, persons)
+                                       : book_offer_in_transaction(user_id, offer_id, person_count, persons);
+    }
+    catch (...)
+    {
+        if (hold == Seat_Hold::HELD)
+        {
+            counters->release(offer_id, person_count);
+        }
+        throw;
+    }
+
+    if (hold == Seat_Hold::HELD && !result.is_success())
+    {
+        // Refused by the database although the counter had room: the counter drifted high
+        if (result.type == Result_Type::ERROR_CONSTRAINT || result.type == Result_Type::DB_ERROR_NO_DATA)
+        {
+            counters->reconcile_offer(offer_id);
+        }
+        else
+        {
+            counters->release(offer_id, person_count);
+        }
+    }
+    return result;
+}
+
+Database::Query_Result Database::Database_Manager::book_offer_with_procedure(int user_id, int offer_id, int person_count,
+    const std::vector<Reservation_Person_Data>& persons)
+{
+    // Column sizes follow dbo.Reservation_Person_List
+    auto person_table = std::make_shared<Sql_Table>();
+    person_table->columns = { { SQL_VARCHAR, 100 }, { SQL_VARCHAR, 15 }, { SQL_TYPE_DATE, 10 }, { SQL_VARCHAR, 20 } };
+    person_table->rows.reserve(persons.size());
+    for (const auto& person : persons)
+    {
+        person_table->rows.push_back({ person.full_name, person.cnp, person.birth_date, person.person_type });
+    }
+
+    // Seats, reservation and travelers are written by one call, the lock is held for a single round trip
+    Query_Result result = execute_prepared("{CALL sp_Book_Offer(?, ?, ?, ?)}",
+                                           { user_id, offer_id, person_count, Sql_Param(std::move(person_table)) });
+    if (!result.is_success())
+    {
+        return result;
+    }
+    if (result.data.empty())
+    {
+        return Query_Result(Result_Type::ERROR_EXECUTION, "Booking procedure returned no result");
+    }
+
+    std::string outcome = result.data[0]["Result"];
+    if (outcome == "BOOKED")
+    {
+        notify_offer_changed(offer_id, Offer_Change::MODIFIED);
+        result.message = "Booking created successfully";
+        return result;
+    }
+    if (outcome == "OFFER_NOT_FOUND")
+    {
+        return Query_Result(Result_Type::DB_ERROR_NO_DATA, "Offer not found");
+    }
+    if (outcome == "NOT_ENOUGH_SEATS")
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Not enough available seats");
+    }
+    if (outcome == "PERSON_COUNT_MISMATCH")
+    {
+        return Query_Result(Result_Type::ERROR_CONSTRAINT, "Traveler details must be given for every person");
+    }
+    return Query_Result(Result_Type::ERROR_EXECUTION, "Unexpected booking result: " + outcome);
+}
+
+Database::Query_Result Database::Database_Manager::book_offer_in_transaction(int user_id, int offer_id, int person_count,
+    const std::vector<Reservation_Person_Data>& persons)
+{
     // Begin transaction FIRST to ensure atomic operation
-    if (!begin_transaction())
+    Transaction_Scope transaction(*this);
+    if (!transaction.is_started())
     {
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to begin transaction");
     }
     
     // ATOMICALLY check availability and reserve seats with row locking
     // Use SELECT FOR UPDATE to lock the row until transaction commits
-    std::stringstream lock_query;
-    lock_query << "SELECT Total_Seats, Reserved_Seats, Price_per_Person "
-               << "FROM Offers WITH (UPDLOCK, ROWLOCK) WHERE Offer_ID = " << offer_id;
-    
-    Query_Result offer_result = execute_query(lock_query.str());
+    Query_Result offer_result = execute_prepared("SELECT Total_Seats, Reserved_Seats, Price_per_Person "
+                                                 "FROM Offers WITH (UPDLOCK, ROWLOCK) WHERE Offer_ID = ?", { offer_id });
     if (!offer_result.is_success() || offer_result.data.empty())
     {
-        rollback_transaction();
         return Query_Result(Result_Type::DB_ERROR_NO_DATA, "Offer not found");
     }
     
@@ -1057,7 +1449,6 @@ Database::Query_Result Database::Database_Manager::book_offer(int user_id, int o
     // Check seat availability within the locked transaction
     if (person_count > available_seats)
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_CONSTRAINT, "Not enough available seats");
     }
     
@@ -1065,44 +1456,49 @@ Database::Query_Result Database::Database_Manager::book_offer(int user_id, int o
     double total_price = price_per_person * person_count;
     
     // Insert reservation first
-    std::stringstream insert_query;
-    insert_query << "INSERT INTO Reservations (User_ID, Offer_ID, Number_of_Persons, Total_Price, Status) VALUES ("
-                 << user_id << ", " << offer_id << ", " << person_count << ", " << total_price << ", 'pending')";
-    
-    Query_Result insert_result = execute_query(insert_query.str());
-    if (!insert_result.is_success())
+    Query_Result insert_result = execute_prepared("INSERT INTO Reservations (User_ID, Offer_ID, Number_of_Persons, Total_Price, Status) "
+                                                  "OUTPUT INSERTED.Reservation_ID "
+                                                  "VALUES (?, ?, ?, ?, 'pending')", { user_id, offer_id, person_count, total_price });
+    if (!insert_result.is_success() || insert_result.data.empty())
+    {
+        return insert_result.is_success() ? Query_Result(Result_Type::ERROR_EXECUTION, "Reservation was not created") : insert_result;
+    }
+    int reservation_id = Utils::Conversion::string_to_int(insert_result.data[0]["Reservation_ID"]);
+
+    for (const auto& person : persons)
     {
-        rollback_transaction();
-        return insert_result;
+        Query_Result person_result = execute_prepared("INSERT INTO Reservation_Persons (Reservation_ID, Full_Name, CNP, Birth_Date, Person_Type) "
+                                                      "VALUES (?, ?, ?, ?, ?)",
+                                                      { reservation_id, person.full_name, person.cnp, person.birth_date, person.person_type });
+        if (!person_result.is_success())
+        {
+            return person_result;
+        }
     }
     
     // Update offer reserved seats with constraint check in SQL
-    std::stringstream update_query;
-    update_query << "UPDATE Offers SET Reserved_Seats = Reserved_Seats + " << person_count 
-                 << " WHERE Offer_ID = " << offer_id 
-                 << " AND Reserved_Seats + " << person_count << " <= Total_Seats";
-    
-    Query_Result update_result = execute_query(update_query.str());
+    Query_Result update_result = execute_prepared("UPDATE Offers SET Reserved_Seats = Reserved_Seats + ?, Date_Modified = GETDATE() "
+                                                  "WHERE Offer_ID = ? AND Reserved_Seats + ? <= Total_Seats",
+                                                  { person_count, offer_id, person_count });
     if (!update_result.is_success())
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to update reserved seats");
     }
     
     // Verify the update affected a row (seat constraint was satisfied)
     if (update_result.affected_rows == 0)
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_CONSTRAINT, "Not enough available seats - concurrent booking detected");
     }
     
-    if (!commit_transaction())
+    if (!transaction.commit())
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to commit transaction");
     }
     
-    return Query_Result(Result_Type::SUCCESS, "Booking created successfully");
+    notify_offer_changed(offer_id, Offer_Change::MODIFIED);
+    insert_result.message = "Booking created successfully";
+    return insert_result;
 }
 
 Database::Query_Result Database::Database_Manager::get_user_reservations(int user_id)
@@ -1113,8 +1509,8 @@ Database::Query_Result Database::Database_Manager::get_user_reservations(int use
                        "FROM Reservations r "
                        "LEFT JOIN Offers o ON r.Offer_ID = o.Offer_ID "
                        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
-                       "WHERE r.User_ID = " + std::to_string(user_id) + " ORDER BY r.Reservation_Date DESC";
-    return execute_select(query);
+                       "WHERE r.User_ID = ? ORDER BY r.Reservation_Date DESC";
+    return execute_prepared(query, { user_id });
 }
 
 Database::Query_Result Database::Database_Manager::get_offer_reservations(int offer_id)
@@ -1138,8 +1534,8 @@ Database::Query_Result Database::Database_Manager::get_reservation_by_id(int res
                        "LEFT JOIN Offers o ON r.Offer_ID = o.Offer_ID "
                        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
                        "LEFT JOIN Users u ON r.User_ID = u.User_ID "
-                       "WHERE r.Reservation_ID = " + std::to_string(reservation_id);
-    return execute_select(query);
+                       "WHERE r.Reservation_ID = ?";
+    return execute_prepared(query, { reservation_id });
 }
 
 Database::Query_Result Database::Database_Manager::cancel_reservation(int reservation_id)
@@ -1162,38 +1558,39 @@ Database::Query_Result Database::Database_Manager::cancel_reservation(int reserv
     }
     
     // Begin transaction
-    if (!begin_transaction())
+    Transaction_Scope transaction(*this);
+    if (!transaction.is_started())
     {
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to begin transaction");
     }
     
     // Update reservation status
-    std::string update_reservation_query = "UPDATE Reservations SET Status = 'cancelled' WHERE Reservation_ID = " + std::to_string(reservation_id);
-    Query_Result update_result = execute_query(update_reservation_query);
+    Query_Result update_result = execute_prepared("UPDATE Reservations SET Status = 'cancelled' WHERE Reservation_ID = ?",
+                                                  { reservation_id });
     if (!update_result.is_success())
     {
-        rollback_transaction();
         return update_result;
     }
     
     // Update offer available seats
-    std::stringstream update_offer_query;
-    update_offer_query << "UPDATE Offers SET Reserved_Seats = Reserved_Seats - " << person_count 
-                      << " WHERE Offer_ID = " << offer_id;
-    
-    Query_Result seats_result = execute_query(update_offer_query.str());
+    Query_Result seats_result = execute_prepared("UPDATE Offers SET Reserved_Seats = Reserved_Seats - ?, Date_Modified = GETDATE() "
+                                                 "WHERE Offer_ID = ?",
+                                                 { person_count, offer_id });
     if (!seats_result.is_success())
     {
-        rollback_transaction();
         return seats_result;
     }
     
-    if (!commit_transaction())
+    if (!transaction.commit())
     {
-        rollback_transaction();
         return Query_Result(Result_Type::ERROR_EXECUTION, "Failed to commit transaction");
     }
     
+    if (auto counters = get_seat_counters())
+    {
+        counters->release(offer_id, person_count);
+    }
+    notify_offer_changed(offer_id, Offer_Change::MODIFIED);
     return Query_Result(Result_Type::SUCCESS, "Reservation cancelled successfully");
 }
 
@@ -1306,19 +1703,77 @@ Database::Query_Result Database::Database_Manager::get_booking_statistics()
 }
 
 // Additional utility methods
-Database::Query_Result Database::Database_Manager::execute_prepared(const std::string& query, const std::vector<std::pair<std::string, std::string>>& params)
+Database::Query_Result Database::Database_Manager::execute_prepared(const std::string& query, const std::vector<Sql_Param>& params)
 {
-    // Basic implementation - for production, use proper prepared statements
-    std::string prepared_query = query;
-    for (const auto& param : params)
+    if (!is_connected || !connection_pool)
     {
-        size_t pos = prepared_query.find(param.first);
-        if (pos != std::string::npos)
+        return Query_Result(Result_Type::ERROR_CONNECTION, "Not connected to database");
+    }
+
+    Connection_Pool::Lease borrowed;
+    Connection_Pool::Lease* lease = get_transaction_connection();
+    if (!lease)
+    {
+        borrowed = connection_pool->acquire();
+        lease = &borrowed;
+    }
+
+    Statement_Cache* statements = lease->get_statement_cache();
+    bool was_cached = false;
+    std::string error;
+    SQLHSTMT hstmt = statements->acquire(query, was_cached, error);
+    if (hstmt == SQL_NULL_HSTMT)
+    {
+        last_sql_error = error;
+        throw DatabaseException("Query preparation failed: " + error);
+    }
+    (was_cached ? statement_cache_hits : statement_cache_misses)++;
+
+    Param_Buffers buffers;
+    if (!Statement_Cache::bind_parameters(hstmt, params, buffers))
+    {
+        error = get_sql_error(SQL_HANDLE_STMT, hstmt);
+        statements->discard(query);
+        last_sql_error = error;
+        throw DatabaseException("Parameter binding failed: " + error);
+    }
+
+    SQLRETURN ret = SQLExecute(hstmt);
+    if (!SQL_SUCCEEDED(ret) && ret != SQL_NO_DATA)
+    {
+        error = get_sql_error(SQL_HANDLE_STMT, hstmt);
+
+        // SQLSTATE class 08 is a connection failure, don't hand this connection out again
+        if (get_sql_state(SQL_HANDLE_STMT, hstmt).compare(0, 2, "08") == 0)
         {
-            prepared_query.replace(pos, param.first.length(), escape_string(param.second));
+            lease->invalidate();
         }
+
+        // The statement may be stale (schema change), prepare it again next time
+        statements->discard(query);
+        last_sql_error = error;
+        throw DatabaseException("Query execution failed: " + error, ret);
     }
-    return execute_query(prepared_query);
+
+    // Prepared statements report their shape, no need to sniff the SQL text
+    SQLSMALLINT columns = 0;
+    SQLNumResultCols(hstmt, &columns);
+
+    Query_Result result;
+    try
+    {
+        result = columns > 0 ? process_select_result(lease->get_hdbc(), hstmt) : process_execution_result(hstmt);
+    }
+    catch (...)
+    {
+        statements->discard(query);
+        throw;
+    }
+
+    // Keep the statement prepared, only close its cursor and drop the parameter buffers
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    return result;
 }
 
 Database::Query_Result Database::Database_Manager::execute_stored_procedure(const std::string& procedure_name, const std::vector<std::string>& params)
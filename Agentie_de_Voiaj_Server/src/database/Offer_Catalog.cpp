@@ -0,0 +1,496 @@
+#include "database/Offer_Catalog.h"
+#include "database/Database_Manager.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include <cstdlib>
+
+using namespace Utils::Exceptions;
+
+namespace
+{
+    // Same joined row as get_available_offers(), without the availability filter:
+    // the catalog applies it itself so seat and status changes can hide an offer
+    const std::string CATALOG_QUERY =
+        "SELECT o.Offer_ID, o.Name, o.Destination_ID, o.Accommodation_ID, o.Types_of_Transport_ID, "
+        "o.Price_per_Person, o.Duration_Days, o.Departure_Date, o.Return_Date, o.Total_Seats, "
+        "o.Reserved_Seats, o.Status, o.Date_Created, o.Date_Modified, "
+        "d.Name as Destination_Name, d.Country, a.Name as Accommodation_Name, t.Name as Transport_Name, "
+        "o.Included_Services, o.Description "
+        "FROM Offers o "
+        "LEFT JOIN Destinations d ON o.Destination_ID = d.Destination_ID "
+        "LEFT JOIN Accommodations a ON o.Accommodation_ID = a.Accommodation_ID "
+        "LEFT JOIN Types_of_Transport t ON o.Types_of_Transport_ID = t.Transport_Type_ID ";
+
+    long long steady_now_ms()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+// ============================================================================
+// Offer_Catalog Implementation
+// ============================================================================
+
+Database::Offer_Catalog::Offer_Catalog(Database_Manager* db_manager)
+    : db_manager(db_manager), is_stale(true), next_refresh_ms(0), cached_offers(0),
+    hits(0), searches(0), delta_refreshes(0), full_reloads(0), rows_refreshed(0)
+{
+}
+
+std::shared_ptr<const Database::Offer_Catalog_Snapshot> Database::Offer_Catalog::get_snapshot()
+{
+    std::shared_ptr<const Offer_Catalog_Snapshot> current;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        current = snapshot;
+    }
+
+    const std::string today = Utils::DateTime::get_current_date();
+    if (!needs_refresh(current.get(), today))
+    {
+        hits++;
+        return current;
+    }
+
+    // After a booking the next read must see it, so staleness waits for the refresh;
+    // a timed refresh is only opportunistic and readers keep the current snapshot meanwhile
+    bool must_wait = !current || is_stale.load() || current->built_for_date != today;
+    std::unique_lock<std::mutex> refresh_lock(refresh_mutex, std::defer_lock);
+    if (must_wait)
+    {
+        refresh_lock.lock();
+    }
+    else if (!refresh_lock.try_lock())
+    {
+        hits++;
+        return current;
+    }
+
+    // Another request may have refreshed while this one waited for the lock
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        current = snapshot;
+    }
+    if (!needs_refresh(current.get(), today))
+    {
+        hits++;
+        return current;
+    }
+
+    try
+    {
+        refresh(today);
+    }
+    catch (const DatabaseException& e)
+    {
+        if (!current)
+        {
+            throw;
+        }
+        Utils::Logger::warning("[Catalog] Refresh failed, serving the previous snapshot: " + std::string(e.what()));
+        return current;
+    }
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    return snapshot;
+}
+
+std::string Database::Offer_Catalog::search(const Offer_Search_Criteria& criteria, size_t* match_count)
+{
+    auto current = get_snapshot();
+    searches++;
+    return current->search_index->search(criteria, match_count);
+}
+
+void Database::Offer_Catalog::on_offer_changed(int offer_id, Offer_Change change)
+{
+    if (change == Offer_Change::DELETED)
+    {
+        std::lock_guard<std::mutex> lock(deleted_mutex);
+        deleted_offers.insert(offer_id);
+    }
+    is_stale = true;
+}
+
+void Database::Offer_Catalog::invalidate()
+{
+    // Forces a full reload, for changes the Date_Modified delta cannot see
+    std::lock_guard<std::mutex> lock(refresh_mutex);
+    is_loaded = false;
+    is_stale = true;
+}
+
+Database::Offer_Catalog_Stats Database::Offer_Catalog::get_stats() const
+{
+    Offer_Catalog_Stats stats;
+    stats.hits = hits.load();
+    stats.searches = searches.load();
+    stats.delta_refreshes = delta_refreshes.load();
+    stats.full_reloads = full_reloads.load();
+    stats.rows_refreshed = rows_refreshed.load();
+    stats.cached_offers = cached_offers.load();
+    return stats;
+}
+
+bool Database::Offer_Catalog::needs_refresh(const Offer_Catalog_Snapshot* current, const std::string& today) const
+{
+    return !current || is_stale.load() || current->built_for_date != today || steady_now_ms() >= next_refresh_ms.load();
+}
+
+void Database::Offer_Catalog::refresh(const std::string& today)
+{
+    // Caller holds refresh_mutex
+    const auto now = std::chrono::steady_clock::now();
+    const bool is_full = !is_loaded || watermark.empty() ||
+        now - last_full_reload >= std::chrono::seconds(Config::Database::OFFER_CATALOG_FULL_RELOAD_SECONDS);
+
+    // Cleared before querying, a change committed during the query marks it stale again
+    is_stale = false;
+
+    Query_Result result;
+    try
+    {
+        if (is_full)
+        {
+            result = db_manager->execute_select(CATALOG_QUERY);
+        }
+        else
+        {
+            // The overlap catches rows whose transaction committed after a later
+            // Date_Modified was already seen; re-applying an unchanged row is a no-op
+            result = db_manager->execute_prepared(CATALOG_QUERY +
+                "WHERE o.Date_Modified >= DATEADD(second, -" +
+                std::to_string(Config::Database::OFFER_CATALOG_DELTA_OVERLAP_SECONDS) + ", ?)", { watermark });
+        }
+    }
+    catch (...)
+    {
+        is_stale = true;
+        throw;
+    }
+
+    if (!result.is_success())
+    {
+        is_stale = true;
+        throw DatabaseException("Offer catalog refresh failed: " + result.message);
+    }
+
+    bool is_changed = false;
+    if (is_full)
+    {
+        entries.clear();
+        watermark.clear();
+        is_loaded = true;
+        last_full_reload = now;
+        is_changed = true;
+        full_reloads++;
+
+        std::lock_guard<std::mutex> lock(deleted_mutex);
+        deleted_offers.clear();
+    }
+    else
+    {
+        delta_refreshes++;
+
+        std::set<int> deleted;
+        {
+            std::lock_guard<std::mutex> lock(deleted_mutex);
+            deleted.swap(deleted_offers);
+        }
+        for (int offer_id : deleted)
+        {
+            is_changed = entries.erase(offer_id) > 0 || is_changed;
+        }
+    }
+
+    is_changed = apply_rows(result.data) || is_changed;
+    rows_refreshed += static_cast<long long>(result.data.size());
+    cached_offers = entries.size();
+    next_refresh_ms = steady_now_ms() + Config::Database::OFFER_CATALOG_REFRESH_SECONDS * 1000LL;
+
+    std::shared_ptr<const Offer_Catalog_Snapshot> current;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        current = snapshot;
+    }
+    if (is_changed || !current || current->built_for_date != today)
+    {
+        rebuild_snapshot(today);
+    }
+}
+
+bool Database::Offer_Catalog::apply_rows(const Result_Set& rows)
+{
+    if (rows.empty())
+    {
+        return false;
+    }
+
+    const size_t id_column = rows.find_column("Offer_ID");
+    const size_t status_column = rows.find_column("Status");
+    const size_t departure_column = rows.find_column("Departure_Date");
+    const size_t total_column = rows.find_column("Total_Seats");
+    const size_t reserved_column = rows.find_column("Reserved_Seats");
+    const size_t modified_column = rows.find_column("Date_Modified");
+    const size_t return_column = rows.find_column("Return_Date");
+    const size_t price_column = rows.find_column("Price_per_Person");
+    const size_t destination_column = rows.find_column("Destination_Name");
+    const size_t country_column = rows.find_column("Country");
+    if (id_column == Result_Set::npos)
+    {
+        return false;
+    }
+
+    bool is_changed = false;
+    const std::vector<size_t> key_order = rows.json_key_order();
+    for (const auto& row : rows)
+    {
+        // Same shape as Protocol_Handler's rows: every value as a string, NULL as ""
+        std::string row_json;
+        row.append_json(row_json, key_order);
+
+        if (modified_column != Result_Set::npos && !row.is_null(modified_column))
+        {
+            std::string modified = to_iso_timestamp(row.get_string(modified_column));
+            if (modified > watermark)
+            {
+                watermark = modified;
+            }
+        }
+
+        int offer_id = static_cast<int>(row.get_int(id_column));
+        auto it = entries.find(offer_id);
+        if (it != entries.end() && *it->second.row_json == row_json)
+        {
+            continue;
+        }
+
+        Catalog_Entry& entry = entries[offer_id];
+        entry.row_json = std::make_shared<const std::string>(std::move(row_json));
+        entry.status = status_column != Result_Set::npos ? row.get_string(status_column) : "";
+        entry.departure_date = departure_column != Result_Set::npos ? row.get_string(departure_column) : "";
+        entry.return_date = return_column != Result_Set::npos ? row.get_string(return_column) : "";
+        entry.destination_name = destination_column != Result_Set::npos ? row.get_string(destination_column) : "";
+        entry.country = country_column != Result_Set::npos ? row.get_string(country_column) : "";
+        entry.price = price_column != Result_Set::npos ? std::strtod(row.get_string(price_column).c_str(), nullptr) : 0.0;
+        entry.total_seats = total_column != Result_Set::npos ? static_cast<int>(row.get_int(total_column)) : 0;
+        entry.reserved_seats = reserved_column != Result_Set::npos ? static_cast<int>(row.get_int(reserved_column)) : 0;
+        is_changed = true;
+    }
+
+    return is_changed;
+}
+
+void Database::Offer_Catalog::rebuild_snapshot(const std::string& today)
+{
+    // GET_OFFERS uses the same filter and order as get_available_offers(): active, seats left,
+    // departing after today. SEARCH_OFFERS matches search_offers(), which has no departure filter.
+    std::vector<std::pair<int, const Catalog_Entry*>> available;
+    std::vector<Indexed_Offer> searchable;
+    for (const auto& pair : entries)
+    {
+        const Catalog_Entry& entry = pair.second;
+        if (entry.status != "active" || entry.reserved_seats >= entry.total_seats)
+        {
+            continue;
+        }
+
+        Indexed_Offer offer;
+        offer.offer_id = pair.first;
+        offer.price = entry.price;
+        offer.departure_date = entry.departure_date;
+        offer.return_date = entry.return_date;
+        offer.destination_name = entry.destination_name;
+        offer.country = entry.country;
+        offer.row_json = entry.row_json;
+        searchable.push_back(std::move(offer));
+
+        if (entry.departure_date > today)
+        {
+            available.emplace_back(pair.first, &entry);
+        }
+    }
+    std::stable_sort(available.begin(), available.end(),
+        [](const std::pair<int, const Catalog_Entry*>& a, const std::pair<int, const Catalog_Entry*>& b) {
+            return a.second->departure_date < b.second->departure_date;
+        });
+
+    auto next = std::make_shared<Offer_Catalog_Snapshot>();
+    std::string offers_json = "[";
+    next->offers.reserve(available.size());
+    for (size_t i = 0; i < available.size(); i++)
+    {
+        if (i > 0)
+        {
+            offers_json += ',';
+        }
+        offers_json += *available[i].second->row_json;
+
+        Versioned_Offer row;
+        row.offer_id = available[i].first;
+        row.row_json = available[i].second->row_json;
+        next->offers.push_back(std::move(row));
+    }
+    offers_json += ']';
+
+    next->offer_count = available.size();
+    next->offers_json = std::move(offers_json);
+    next->built_for_date = today;
+    next->search_index = std::make_shared<const Offer_Index>(std::move(searchable));
+
+    // Only this thread replaces the snapshot (refresh_mutex), readers just copy the pointer
+    std::shared_ptr<const Offer_Catalog_Snapshot> previous;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        previous = snapshot;
+    }
+    carry_versions(previous.get(), *next);
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshot = std::move(next);
+}
+
+std::string Database::Offer_Catalog::build_changes_since(const Offer_Catalog_Snapshot& snapshot, long long known_version)
+{
+    std::string json = "{\"version\":" + std::to_string(snapshot.version);
+    if (known_version == snapshot.version)
+    {
+        return json + ",\"not_modified\":true}";
+    }
+
+    // A version from an earlier run is below base_version, one from a later run above version
+    if (known_version >= snapshot.base_version && known_version < snapshot.version)
+    {
+        std::vector<const Versioned_Offer*> changed;
+        for (const auto& row : snapshot.offers)
+        {
+            if (row.changed_version > known_version)
+            {
+                changed.push_back(&row);
+            }
+        }
+
+        if (changed.size() * 2 <= snapshot.offers.size())
+        {
+            json += ",\"changed\":[";
+            for (size_t i = 0; i < changed.size(); i++)
+            {
+                if (i > 0)
+                {
+                    json += ',';
+                }
+                json += *changed[i]->row_json;
+            }
+
+            json += "],\"removed\":[";
+            bool is_first = true;
+            for (const auto& pair : snapshot.removed)
+            {
+                if (pair.second > known_version)
+                {
+                    if (!is_first)
+                    {
+                        json += ',';
+                    }
+                    json += std::to_string(pair.first);
+                    is_first = false;
+                }
+            }
+            return json + "]}";
+        }
+    }
+
+    return json + ",\"offers\":" + snapshot.offers_json + "}";
+}
+
+void Database::Offer_Catalog::carry_versions(const Offer_Catalog_Snapshot* previous, Offer_Catalog_Snapshot& next)
+{
+    const long long candidate = next_version(previous ? previous->version : 0);
+
+    std::unordered_map<int, const Versioned_Offer*> previous_rows;
+    if (previous)
+    {
+        previous_rows.reserve(previous->offers.size());
+        for (const auto& row : previous->offers)
+        {
+            previous_rows.emplace(row.offer_id, &row);
+        }
+        next.removed = previous->removed;
+        next.base_version = previous->base_version;
+    }
+    else
+    {
+        next.base_version = candidate;
+    }
+
+    // Rows are compared by content, a full reload gives every entry a new string
+    size_t changed = 0;
+    for (auto& row : next.offers)
+    {
+        auto it = previous_rows.find(row.offer_id);
+        if (it != previous_rows.end() &&
+            (it->second->row_json == row.row_json || *it->second->row_json == *row.row_json))
+        {
+            row.changed_version = it->second->changed_version;
+        }
+        else
+        {
+            row.changed_version = candidate;
+            changed++;
+        }
+        if (it != previous_rows.end())
+        {
+            previous_rows.erase(it);
+        }
+        next.removed.erase(row.offer_id); // Back in the list, sent as changed
+    }
+
+    // Whatever is left was sold out, deleted or has departed
+    for (const auto& pair : previous_rows)
+    {
+        next.removed[pair.first] = candidate;
+    }
+
+    // Same rows as before: clients holding the previous version are still current
+    next.version = previous && changed == 0 && previous_rows.empty() ? previous->version : candidate;
+
+    if (next.removed.size() > static_cast<size_t>(Config::Database::OFFER_CATALOG_MAX_REMOVED))
+    {
+        std::vector<std::pair<long long, int>> by_version;
+        by_version.reserve(next.removed.size());
+        for (const auto& pair : next.removed)
+        {
+            by_version.emplace_back(pair.second, pair.first);
+        }
+        std::sort(by_version.begin(), by_version.end());
+
+        // A client older than the last dropped removal could miss it, it gets the full list instead
+        size_t drop = next.removed.size() - Config::Database::OFFER_CATALOG_MAX_REMOVED;
+        for (size_t i = 0; i < drop; i++)
+        {
+            next.removed.erase(by_version[i].second);
+        }
+        next.base_version = (std::max)(next.base_version, by_version[drop - 1].first);
+    }
+}
+
+long long Database::Offer_Catalog::next_version(long long previous)
+{
+    long long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return (std::max)(previous + 1, now_ms);
+}
+
+std::string Database::Offer_Catalog::to_iso_timestamp(const std::string& sql_timestamp)
+{
+    // "YYYY-MM-DD HH:MM:SS.mmm" -> "YYYY-MM-DDTHH:MM:SS.mmm", unambiguous under any SET DATEFORMAT
+    std::string iso = sql_timestamp;
+    if (iso.size() > 10 && iso[10] == ' ')
+    {
+        iso[10] = 'T';
+    }
+    return iso;
+}
@@ -0,0 +1,309 @@
+#include "database/Offer_Index.h"
+#include <algorithm>
+#include <map>
+
+// ============================================================================
+// Offer_Bitmap Implementation
+// ============================================================================
+
+Database::Offer_Bitmap::Offer_Bitmap(size_t bit_count, bool is_set)
+    : words((bit_count + 63) / 64, 0), bit_count(bit_count)
+{
+    if (is_set)
+    {
+        set_range(0, bit_count);
+    }
+}
+
+void Database::Offer_Bitmap::set_range(size_t first, size_t last)
+{
+    if (first >= last)
+    {
+        return;
+    }
+
+    size_t first_word = first >> 6;
+    size_t last_word = (last - 1) >> 6;
+    uint64_t first_mask = ~uint64_t(0) << (first & 63);
+    uint64_t last_mask = ~uint64_t(0) >> (63 - ((last - 1) & 63));
+
+    if (first_word == last_word)
+    {
+        words[first_word] |= first_mask & last_mask;
+        return;
+    }
+
+    words[first_word] |= first_mask;
+    for (size_t w = first_word + 1; w < last_word; w++)
+    {
+        words[w] = ~uint64_t(0);
+    }
+    words[last_word] |= last_mask;
+}
+
+Database::Offer_Bitmap& Database::Offer_Bitmap::operator&=(const Offer_Bitmap& other)
+{
+    for (size_t w = 0; w < words.size(); w++)
+    {
+        words[w] &= w < other.words.size() ? other.words[w] : 0;
+    }
+    return *this;
+}
+
+Database::Offer_Bitmap& Database::Offer_Bitmap::operator|=(const Offer_Bitmap& other)
+{
+    for (size_t w = 0; w < words.size() && w < other.words.size(); w++)
+    {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+size_t Database::Offer_Bitmap::count() const
+{
+    size_t total = 0;
+    for (uint64_t word : words)
+    {
+        while (word)
+        {
+            word &= word - 1;
+            total++;
+        }
+    }
+    return total;
+}
+
+// ============================================================================
+// Offer_Index Implementation
+// ============================================================================
+
+Database::Offer_Index::Offer_Index(std::vector<Indexed_Offer> input)
+    : offers(std::move(input))
+{
+    // Stable, so offers departing the same day keep the order they were given in
+    std::stable_sort(offers.begin(), offers.end(), [](const Indexed_Offer& a, const Indexed_Offer& b) {
+        return a.departure_date < b.departure_date;
+    });
+
+    // Destinations repeat across offers, so the text index is built over distinct pairs
+    std::map<std::pair<std::string, std::string>, uint32_t> destination_ids;
+    for (uint32_t doc = 0; doc < offers.size(); doc++)
+    {
+        auto key = std::make_pair(to_lower_ascii(offers[doc].destination_name), to_lower_ascii(offers[doc].country));
+        auto it = destination_ids.find(key);
+        if (it == destination_ids.end())
+        {
+            it = destination_ids.emplace(key, static_cast<uint32_t>(destinations.size())).first;
+            destinations.push_back({ key.first, key.second, {} });
+        }
+        destinations[it->second].offers.push_back(doc);
+    }
+
+    for (uint32_t id = 0; id < destinations.size(); id++)
+    {
+        for (const std::string* text : { &destinations[id].name, &destinations[id].country })
+        {
+            for (size_t i = 0; i + 3 <= text->size(); i++)
+            {
+                std::vector<uint32_t>& postings = trigrams[trigram_key(text->data() + i)];
+                if (postings.empty() || postings.back() != id)
+                {
+                    postings.push_back(id);
+                }
+            }
+        }
+    }
+
+    by_price.resize(offers.size());
+    by_return_date.resize(offers.size());
+    for (uint32_t doc = 0; doc < offers.size(); doc++)
+    {
+        by_price[doc] = doc;
+        by_return_date[doc] = doc;
+    }
+    std::sort(by_price.begin(), by_price.end(), [this](uint32_t a, uint32_t b) {
+        return offers[a].price < offers[b].price;
+    });
+    std::sort(by_return_date.begin(), by_return_date.end(), [this](uint32_t a, uint32_t b) {
+        return offers[a].return_date < offers[b].return_date;
+    });
+
+    sorted_prices.reserve(offers.size());
+    for (uint32_t doc : by_price)
+    {
+        sorted_prices.push_back(offers[doc].price);
+    }
+    sorted_return_dates.reserve(offers.size());
+    for (uint32_t doc : by_return_date)
+    {
+        sorted_return_dates.push_back(offers[doc].return_date);
+    }
+}
+
+bool Database::Offer_Index::can_answer(const Offer_Search_Criteria& criteria)
+{
+    return criteria.destination.find_first_of("%_[") == std::string::npos;
+}
+
+Database::Offer_Bitmap Database::Offer_Index::match(const Offer_Search_Criteria& criteria) const
+{
+    // Departure_Date >= start_date is a suffix of the document order
+    size_t first = 0;
+    if (!criteria.start_date.empty())
+    {
+        first = std::lower_bound(offers.begin(), offers.end(), criteria.start_date,
+            [](const Indexed_Offer& offer, const std::string& date) { return offer.departure_date < date; }) - offers.begin();
+    }
+    Offer_Bitmap result(offers.size());
+    result.set_range(first, offers.size());
+
+    if (criteria.min_price > 0 || criteria.max_price > 0)
+    {
+        auto low = criteria.min_price > 0 ?
+            std::lower_bound(sorted_prices.begin(), sorted_prices.end(), criteria.min_price) : sorted_prices.begin();
+        auto high = criteria.max_price > 0 ?
+            std::upper_bound(sorted_prices.begin(), sorted_prices.end(), criteria.max_price) : sorted_prices.end();
+
+        Offer_Bitmap in_range(offers.size());
+        for (auto it = low; it < high; ++it)
+        {
+            in_range.set(by_price[it - sorted_prices.begin()]);
+        }
+        result &= in_range;
+    }
+
+    if (!criteria.end_date.empty())
+    {
+        // Dates are YYYY-MM-DD, so string order is date order
+        size_t count = std::upper_bound(sorted_return_dates.begin(), sorted_return_dates.end(), criteria.end_date) -
+            sorted_return_dates.begin();
+
+        Offer_Bitmap in_range(offers.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            in_range.set(by_return_date[i]);
+        }
+        result &= in_range;
+    }
+
+    if (!criteria.destination.empty())
+    {
+        result &= match_destination(criteria.destination);
+    }
+
+    return result;
+}
+
+std::string Database::Offer_Index::search(const Offer_Search_Criteria& criteria, size_t* match_count) const
+{
+    Offer_Bitmap matches = match(criteria);
+
+    // Rows are serialized once by the catalog, a search only splices them
+    size_t bytes = 2;
+    matches.for_each([&](size_t doc) { bytes += offers[doc].row_json->size() + 1; });
+
+    std::string json;
+    json.reserve(bytes);
+    json += '[';
+    size_t count = 0;
+    matches.for_each([&](size_t doc) {
+        if (count++ > 0)
+        {
+            json += ',';
+        }
+        json += *offers[doc].row_json;
+    });
+    json += ']';
+
+    if (match_count)
+    {
+        *match_count = count;
+    }
+    return json;
+}
+
+Database::Offer_Bitmap Database::Offer_Index::match_destination(const std::string& text) const
+{
+    const std::string needle = to_lower_ascii(text);
+    Offer_Bitmap result(offers.size());
+
+    // Every trigram of the needle must occur in the destination; the shortest
+    // posting list drives the intersection. Shorter needles check every destination.
+    std::vector<uint32_t> candidates;
+    bool is_filtered = needle.size() >= 3;
+    if (is_filtered)
+    {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (size_t i = 0; i + 3 <= needle.size(); i++)
+        {
+            auto it = trigrams.find(trigram_key(needle.data() + i));
+            if (it == trigrams.end())
+            {
+                return result;
+            }
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) {
+            return a->size() < b->size();
+        });
+
+        candidates = *lists.front();
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+        {
+            std::vector<uint32_t> next;
+            std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                std::back_inserter(next));
+            candidates.swap(next);
+        }
+    }
+
+    auto add_if_contains = [&](uint32_t id) {
+        const Destination_Entry& destination = destinations[id];
+        // Trigrams can come from name and country separately, LIKE matches within one of them
+        if (destination.name.find(needle) != std::string::npos || destination.country.find(needle) != std::string::npos)
+        {
+            for (uint32_t doc : destination.offers)
+            {
+                result.set(doc);
+            }
+        }
+    };
+
+    if (is_filtered)
+    {
+        for (uint32_t id : candidates)
+        {
+            add_if_contains(id);
+        }
+    }
+    else
+    {
+        for (uint32_t id = 0; id < destinations.size(); id++)
+        {
+            add_if_contains(id);
+        }
+    }
+
+    return result;
+}
+
+std::string Database::Offer_Index::to_lower_ascii(const std::string& text)
+{
+    // Matches the case-insensitive default collation for ASCII; other bytes compare exactly
+    std::string lower = text;
+    for (char& c : lower)
+    {
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return lower;
+}
+
+uint32_t Database::Offer_Index::trigram_key(const char* text)
+{
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+        static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
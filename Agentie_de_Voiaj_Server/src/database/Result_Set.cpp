@@ -0,0 +1,541 @@
+#include "database/Result_Set.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+// ============================================================================
+// Result_Set Implementation
+// ============================================================================
+
+size_t Database::Result_Set::add_column(const std::string& name, Column_Type type, int scale)
+{
+    Column column;
+    column.name = name;
+    column.type = type;
+    column.scale = scale;
+    column.string_offsets.push_back(0);
+
+    size_t index = columns.size();
+    columns.push_back(std::move(column));
+
+    // First occurrence wins for duplicate names, like the map rows did with operator[]
+    column_index.emplace(name, index);
+
+    // Columns added after rows exist (push_back of a wider row) are NULL for those rows
+    for (size_t row = 0; row < row_count; row++)
+    {
+        append_null(index);
+    }
+
+    return index;
+}
+
+size_t Database::Result_Set::find_column(const std::string& name) const
+{
+    auto it = column_index.find(name);
+    return it != column_index.end() ? it->second : npos;
+}
+
+const Database::Result_Set::Column* Database::Result_Set::find_column_ptr(const std::string& name) const
+{
+    size_t index = find_column(name);
+    return index != npos ? &columns[index] : nullptr;
+}
+
+void Database::Result_Set::reserve(size_t rows)
+{
+    for (auto& column : columns)
+    {
+        switch (column.type)
+        {
+        case Column_Type::INT:
+            column.int_values.reserve(rows);
+            break;
+        case Column_Type::DOUBLE:
+            column.double_values.reserve(rows);
+            break;
+        case Column_Type::DATE:
+        case Column_Type::TIMESTAMP:
+            column.date_values.reserve(rows);
+            break;
+        case Column_Type::STRING:
+            column.string_offsets.reserve(rows + 1);
+            break;
+        }
+        column.null_bits.reserve((rows + 63) / 64);
+    }
+}
+
+void Database::Result_Set::mark_null(Column& column, size_t row, bool is_null)
+{
+    size_t word = row / 64;
+    if (word >= column.null_bits.size())
+    {
+        column.null_bits.resize(word + 1, 0);
+    }
+
+    if (is_null)
+    {
+        column.null_bits[word] |= (uint64_t(1) << (row % 64));
+    }
+}
+
+void Database::Result_Set::append_int(size_t column, int64_t value)
+{
+    Column& target = columns[column];
+    switch (target.type)
+    {
+    case Column_Type::INT:
+        target.int_values.push_back(value);
+        break;
+    case Column_Type::DOUBLE:
+        target.double_values.push_back(static_cast<double>(value));
+        break;
+    case Column_Type::STRING:
+    {
+        std::string text = std::to_string(value);
+        append_string(column, text.data(), text.size());
+        return;
+    }
+    default:
+        append_null(column);
+        return;
+    }
+    mark_null(target, target.value_count++, false);
+}
+
+void Database::Result_Set::append_double(size_t column, double value)
+{
+    Column& target = columns[column];
+    switch (target.type)
+    {
+    case Column_Type::DOUBLE:
+        target.double_values.push_back(value);
+        break;
+    case Column_Type::INT:
+        target.int_values.push_back(static_cast<int64_t>(value));
+        break;
+    case Column_Type::STRING:
+    {
+        char buffer[64];
+        int length = snprintf(buffer, sizeof(buffer), "%.15g", value);
+        append_string(column, buffer, static_cast<size_t>(length));
+        return;
+    }
+    default:
+        append_null(column);
+        return;
+    }
+    mark_null(target, target.value_count++, false);
+}
+
+void Database::Result_Set::append_date(size_t column, const SQL_TIMESTAMP_STRUCT& value)
+{
+    Column& target = columns[column];
+    if (target.type == Column_Type::STRING)
+    {
+        std::string text = format_date(value, Column_Type::TIMESTAMP, 0);
+        append_string(column, text.data(), text.size());
+        return;
+    }
+    if (target.type != Column_Type::DATE && target.type != Column_Type::TIMESTAMP)
+    {
+        append_null(column);
+        return;
+    }
+
+    target.date_values.push_back(value);
+    mark_null(target, target.value_count++, false);
+}
+
+void Database::Result_Set::append_string(size_t column, const char* value, size_t length)
+{
+    Column& target = columns[column];
+    switch (target.type)
+    {
+    case Column_Type::STRING:
+        target.string_arena.append(value, length);
+        target.string_offsets.push_back(static_cast<uint32_t>(target.string_arena.size()));
+        break;
+    case Column_Type::INT:
+        target.int_values.push_back(std::strtoll(std::string(value, length).c_str(), nullptr, 10));
+        break;
+    case Column_Type::DOUBLE:
+        target.double_values.push_back(std::strtod(std::string(value, length).c_str(), nullptr));
+        break;
+    default:
+        append_null(column);
+        return;
+    }
+    mark_null(target, target.value_count++, false);
+}
+
+void Database::Result_Set::append_null(size_t column)
+{
+    Column& target = columns[column];
+
+    // NULLs still take a slot so row i is always element i of the value buffer
+    switch (target.type)
+    {
+    case Column_Type::INT:
+        target.int_values.push_back(0);
+        break;
+    case Column_Type::DOUBLE:
+        target.double_values.push_back(0.0);
+        break;
+    case Column_Type::DATE:
+    case Column_Type::TIMESTAMP:
+        target.date_values.push_back(SQL_TIMESTAMP_STRUCT{});
+        break;
+    case Column_Type::STRING:
+        target.string_offsets.push_back(static_cast<uint32_t>(target.string_arena.size()));
+        break;
+    }
+    mark_null(target, target.value_count++, true);
+}
+
+void Database::Result_Set::end_row()
+{
+    row_count++;
+
+    // Columns the caller did not fill for this row are NULL
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        while (columns[i].value_count < row_count)
+        {
+            append_null(i);
+        }
+    }
+}
+
+void Database::Result_Set::push_back(const std::map<std::string, std::string>& row)
+{
+    for (const auto& pair : row)
+    {
+        if (find_column(pair.first) == npos)
+        {
+            add_column(pair.first, Column_Type::STRING);
+        }
+    }
+
+    for (const auto& pair : row)
+    {
+        append_string(find_column(pair.first), pair.second.data(), pair.second.size());
+    }
+    end_row();
+}
+
+void Database::Result_Set::clear()
+{
+    columns.clear();
+    column_index.clear();
+    row_count = 0;
+}
+
+std::string Database::Result_Set::format_date(const SQL_TIMESTAMP_STRUCT& value, Column_Type type, int scale)
+{
+    char buffer[48];
+    if (type == Column_Type::DATE)
+    {
+        snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u",
+                 static_cast<int>(value.year), static_cast<unsigned>(value.month), static_cast<unsigned>(value.day));
+        return buffer;
+    }
+
+    int length = snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02u:%02u:%02u",
+                          static_cast<int>(value.year), static_cast<unsigned>(value.month), static_cast<unsigned>(value.day),
+                          static_cast<unsigned>(value.hour), static_cast<unsigned>(value.minute), static_cast<unsigned>(value.second));
+
+    // fraction is in nanoseconds, the driver prints as many digits as the column scale (DATETIME = 3)
+    if (scale > 0)
+    {
+        char fraction[16];
+        snprintf(fraction, sizeof(fraction), "%09u", static_cast<unsigned>(value.fraction));
+        snprintf(buffer + length, sizeof(buffer) - length, ".%.*s", scale > 9 ? 9 : scale, fraction);
+    }
+    return buffer;
+}
+
+std::vector<size_t> Database::Result_Set::json_key_order() const
+{
+    std::vector<size_t> order(columns.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return columns[a].name < columns[b].name;
+    });
+
+    // Equal names are adjacent and in column order, keep the last of each run
+    std::vector<size_t> unique_order;
+    unique_order.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (i + 1 < order.size() && columns[order[i]].name == columns[order[i + 1]].name)
+        {
+            continue;
+        }
+        unique_order.push_back(order[i]);
+    }
+    return unique_order;
+}
+
+void Database::Result_Set::append_json(std::string& out) const
+{
+    if (row_count == 0)
+    {
+        out += "[]";
+        return;
+    }
+
+    // Quoted keys are escaped once for the whole result
+    std::vector<size_t> key_order = json_key_order();
+    std::vector<std::string> key_prefixes;
+    key_prefixes.reserve(key_order.size());
+    size_t row_estimate = 2;
+    for (size_t column : key_order)
+    {
+        std::string prefix;
+        Utils::JSON::append_json_string(prefix, columns[column].name);
+        prefix += ':';
+        row_estimate += prefix.size() + 8;
+        key_prefixes.push_back(std::move(prefix));
+    }
+    out.reserve(out.size() + row_count * row_estimate);
+
+    out += '[';
+    for (size_t row = 0; row < row_count; row++)
+    {
+        if (row > 0)
+        {
+            out += ',';
+        }
+        out += '{';
+        for (size_t k = 0; k < key_order.size(); k++)
+        {
+            if (k > 0)
+            {
+                out += ',';
+            }
+            out += key_prefixes[k];
+            append_json_value(out, row, key_order[k]);
+        }
+        out += '}';
+    }
+    out += ']';
+}
+
+void Database::Result_Set::append_json_value(std::string& out, size_t row, size_t column) const
+{
+    const Row_View view(this, row);
+    if (view.is_null(column))
+    {
+        out += "\"\"";
+        return;
+    }
+
+    const Column& source = columns[column];
+    switch (source.type)
+    {
+    case Column_Type::STRING:
+        Utils::JSON::append_json_string(out, view.get_string_view(column));
+        break;
+    case Column_Type::INT:
+    {
+        // Digits never need escaping
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), source.int_values[row]);
+        out += '"';
+        out.append(buffer, result.ptr);
+        out += '"';
+        break;
+    }
+    default:
+        Utils::JSON::append_json_string(out, view.get_string(column));
+        break;
+    }
+}
+
+// ============================================================================
+// Result_Set::Row_View
+// ============================================================================
+
+bool Database::Result_Set::Row_View::is_null(size_t column) const
+{
+    const Column& source = result_set->columns[column];
+    return (source.null_bits[row / 64] >> (row % 64)) & 1;
+}
+
+int64_t Database::Result_Set::Row_View::get_int(size_t column) const
+{
+    if (is_null(column))
+    {
+        return 0;
+    }
+
+    const Column& source = result_set->columns[column];
+    switch (source.type)
+    {
+    case Column_Type::INT:
+        return source.int_values[row];
+    case Column_Type::DOUBLE:
+        return static_cast<int64_t>(source.double_values[row]);
+    case Column_Type::STRING:
+        return std::strtoll(std::string(get_string_view(column)).c_str(), nullptr, 10);
+    default:
+        return 0;
+    }
+}
+
+double Database::Result_Set::Row_View::get_double(size_t column) const
+{
+    if (is_null(column))
+    {
+        return 0.0;
+    }
+
+    const Column& source = result_set->columns[column];
+    switch (source.type)
+    {
+    case Column_Type::DOUBLE:
+        return source.double_values[row];
+    case Column_Type::INT:
+        return static_cast<double>(source.int_values[row]);
+    case Column_Type::STRING:
+        return std::strtod(std::string(get_string_view(column)).c_str(), nullptr);
+    default:
+        return 0.0;
+    }
+}
+
+SQL_TIMESTAMP_STRUCT Database::Result_Set::Row_View::get_date(size_t column) const
+{
+    const Column& source = result_set->columns[column];
+    if (is_null(column) || (source.type != Column_Type::DATE && source.type != Column_Type::TIMESTAMP))
+    {
+        return SQL_TIMESTAMP_STRUCT{};
+    }
+    return source.date_values[row];
+}
+
+std::string_view Database::Result_Set::Row_View::get_string_view(size_t column) const
+{
+    const Column& source = result_set->columns[column];
+    if (source.type != Column_Type::STRING)
+    {
+        return std::string_view();
+    }
+
+    uint32_t begin = source.string_offsets[row];
+    uint32_t end = source.string_offsets[row + 1];
+    return std::string_view(source.string_arena.data() + begin, end - begin);
+}
+
+std::string Database::Result_Set::Row_View::get_string(size_t column) const
+{
+    if (is_null(column))
+    {
+        return "";
+    }
+
+    const Column& source = result_set->columns[column];
+    switch (source.type)
+    {
+    case Column_Type::INT:
+        return std::to_string(source.int_values[row]);
+    case Column_Type::DOUBLE:
+    {
+        // DECIMAL/NUMERIC keep their scale ("299.99", "0.00") the way SQL_C_CHAR returned them
+        char buffer[64];
+        if (source.scale > 0)
+        {
+            snprintf(buffer, sizeof(buffer), "%.*f", source.scale, source.double_values[row]);
+        }
+        else
+        {
+            snprintf(buffer, sizeof(buffer), "%.15g", source.double_values[row]);
+        }
+        return buffer;
+    }
+    case Column_Type::DATE:
+    case Column_Type::TIMESTAMP:
+        return format_date(source.date_values[row], source.type, source.scale);
+    case Column_Type::STRING:
+        return std::string(get_string_view(column));
+    }
+    return "";
+}
+
+bool Database::Result_Set::Row_View::is_null(const std::string& name) const
+{
+    size_t column = result_set->find_column(name);
+    return column == npos || is_null(column);
+}
+
+int64_t Database::Result_Set::Row_View::get_int(const std::string& name) const
+{
+    size_t column = result_set->find_column(name);
+    return column != npos ? get_int(column) : 0;
+}
+
+double Database::Result_Set::Row_View::get_double(const std::string& name) const
+{
+    size_t column = result_set->find_column(name);
+    return column != npos ? get_double(column) : 0.0;
+}
+
+std::string Database::Result_Set::Row_View::get_string(const std::string& name) const
+{
+    size_t column = result_set->find_column(name);
+    return column != npos ? get_string(column) : "";
+}
+
+std::string Database::Result_Set::Row_View::operator[](const std::string& name) const
+{
+    return get_string(name);
+}
+
+std::string Database::Result_Set::Row_View::at(const std::string& name) const
+{
+    size_t column = result_set->find_column(name);
+    if (column == npos)
+    {
+        throw std::out_of_range("Result_Set: unknown column " + name);
+    }
+    return get_string(column);
+}
+
+std::map<std::string, std::string> Database::Result_Set::Row_View::to_map() const
+{
+    std::map<std::string, std::string> row_map;
+    for (size_t i = 0; i < result_set->columns.size(); i++)
+    {
+        row_map.emplace(result_set->columns[i].name, get_string(i));
+    }
+    return row_map;
+}
+
+void Database::Result_Set::Row_View::append_json(std::string& out) const
+{
+    append_json(out, result_set->json_key_order());
+}
+
+void Database::Result_Set::Row_View::append_json(std::string& out, const std::vector<size_t>& key_order) const
+{
+    out += '{';
+    for (size_t k = 0; k < key_order.size(); k++)
+    {
+        if (k > 0)
+        {
+            out += ',';
+        }
+        Utils::JSON::append_json_string(out, result_set->columns[key_order[k]].name);
+        out += ':';
+        result_set->append_json_value(out, row, key_order[k]);
+    }
+    out += '}';
+}
@@ -0,0 +1,385 @@
+#include "database/Row_Fetcher.h"
+#include <cstring>
+
+// ============================================================================
+// Row_Fetcher Implementation
+// ============================================================================
+
+Database::Row_Fetcher::Row_Fetcher(SQLHDBC hdbc, SQLHSTMT hstmt, int block_rows)
+    : hdbc(hdbc), hstmt(hstmt), block_rows(block_rows > 0 ? static_cast<SQLULEN>(block_rows) : 1)
+{
+}
+
+Database::Row_Fetcher::~Row_Fetcher()
+{
+    // Leave the statement as SQLExecDirect found it, it may be reused for another query
+    SQLFreeStmt(hstmt, SQL_UNBIND);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(1)), 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, NULL, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, NULL, 0);
+}
+
+bool Database::Row_Fetcher::fetch_all(Result_Set& rows)
+{
+    if (!describe_columns(rows) || !bind_columns())
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        rows_fetched = 0;
+        SQLRETURN ret = SQLFetch(hstmt);
+        stats.fetch_calls++;
+
+        if (ret == SQL_NO_DATA)
+        {
+            return true;
+        }
+        if (!SQL_SUCCEEDED(ret))
+        {
+            return false;
+        }
+
+        rows.reserve(rows.size() + rows_fetched);
+        for (SQLULEN row = 0; row < rows_fetched; row++)
+        {
+            if (row_status[row] == SQL_ROW_ERROR)
+            {
+                return false;
+            }
+            if (row_status[row] == SQL_ROW_NOROW)
+            {
+                continue;
+            }
+
+            // Unbound columns are read through the cursor, which has to point at this row of the block
+            bool is_positioned = block_rows == 1;
+            for (size_t column = 0; column < bindings.size(); column++)
+            {
+                if (bindings[column].is_bound)
+                {
+                    append_bound_value(rows, column, row);
+                    continue;
+                }
+
+                if (!is_positioned)
+                {
+                    stats.set_pos_calls++;
+                    if (!SQL_SUCCEEDED(SQLSetPos(hstmt, static_cast<SQLSETPOSIROW>(row + 1), SQL_POSITION, SQL_LOCK_NO_CHANGE)))
+                    {
+                        return false;
+                    }
+                    is_positioned = true;
+                }
+
+                if (!append_unbound_value(rows, column))
+                {
+                    return false;
+                }
+            }
+
+            rows.end_row();
+            stats.rows++;
+        }
+    }
+}
+
+bool Database::Row_Fetcher::describe_columns(Result_Set& rows)
+{
+    SQLSMALLINT columns = 0;
+    if (!SQL_SUCCEEDED(SQLNumResultCols(hstmt, &columns)))
+    {
+        return false;
+    }
+
+    bindings.assign(columns, Column_Binding());
+    for (SQLSMALLINT i = 1; i <= columns; i++)
+    {
+        SQLCHAR column_name[256];
+        SQLSMALLINT name_len = 0;
+        SQLRETURN ret = SQLColAttribute(hstmt, i, SQL_DESC_NAME, column_name, sizeof(column_name), &name_len, NULL);
+        std::string name = SQL_SUCCEEDED(ret) ? std::string(reinterpret_cast<char*>(column_name), name_len) : "";
+
+        SQLLEN sql_type = SQL_VARCHAR;
+        SQLLEN scale = 0;
+        SQLLEN display_size = 0;
+        SQLColAttribute(hstmt, i, SQL_DESC_CONCISE_TYPE, NULL, 0, NULL, &sql_type);
+        SQLColAttribute(hstmt, i, SQL_DESC_SCALE, NULL, 0, NULL, &scale);
+        SQLColAttribute(hstmt, i, SQL_DESC_DISPLAY_SIZE, NULL, 0, NULL, &display_size);
+
+        Column_Binding& binding = bindings[i - 1];
+        switch (sql_type)
+        {
+        case SQL_INTEGER:
+        case SQL_SMALLINT:
+        case SQL_TINYINT:
+        case SQL_BIGINT:
+        case SQL_BIT:
+            binding.type = Column_Type::INT;
+            binding.c_type = SQL_C_SBIGINT;
+            binding.element_size = sizeof(SQLBIGINT);
+            break;
+        case SQL_DECIMAL:
+        case SQL_NUMERIC:
+        case SQL_FLOAT:
+        case SQL_REAL:
+        case SQL_DOUBLE:
+            binding.type = Column_Type::DOUBLE;
+            binding.c_type = SQL_C_DOUBLE;
+            binding.element_size = sizeof(double);
+            break;
+        case SQL_TYPE_DATE:
+        case SQL_TYPE_TIMESTAMP:
+            // DATE converts to SQL_C_TYPE_TIMESTAMP with a zero time part
+            binding.type = sql_type == SQL_TYPE_DATE ? Column_Type::DATE : Column_Type::TIMESTAMP;
+            binding.c_type = SQL_C_TYPE_TIMESTAMP;
+            binding.element_size = sizeof(SQL_TIMESTAMP_STRUCT);
+            break;
+        case SQL_LONGVARCHAR:
+        case SQL_WLONGVARCHAR:
+        case SQL_LONGVARBINARY:
+            binding.element_size = 0; // TEXT/NTEXT/IMAGE, always read with SQLGetData
+            break;
+        default:
+        {
+            // Wide columns come back in the client code page, leave room for multi-byte characters
+            bool is_wide = sql_type == SQL_WCHAR || sql_type == SQL_WVARCHAR;
+            SQLLEN max_bytes = display_size * (is_wide ? 4 : 1) + 1;
+            binding.element_size = display_size > 0 && max_bytes <= Config::Database::FETCH_MAX_BOUND_COLUMN_BYTES
+                ? max_bytes
+                : 0; // VARCHAR(MAX) reports no size
+            break;
+        }
+        }
+
+        rows.add_column(name, binding.type, static_cast<int>(scale));
+    }
+
+    return true;
+}
+
+bool Database::Row_Fetcher::bind_columns()
+{
+    bool has_long_columns = false;
+    for (const auto& binding : bindings)
+    {
+        has_long_columns = has_long_columns || binding.element_size == 0;
+    }
+
+    // Without SQL_GD_ANY_COLUMN, SQLGetData only works on columns after the last bound one,
+    // and without SQL_GD_BLOCK it cannot be mixed with block cursors at all. The offer
+    // queries select their TEXT columns last so the first restriction costs nothing.
+    bool any_column = true;
+    if (has_long_columns)
+    {
+        SQLUINTEGER extensions = 0;
+        SQLGetInfo(hdbc, SQL_GETDATA_EXTENSIONS, &extensions, sizeof(extensions), NULL);
+        any_column = (extensions & SQL_GD_ANY_COLUMN) != 0;
+        if (!(extensions & SQL_GD_BLOCK))
+        {
+            block_rows = 1;
+        }
+    }
+
+    bool past_long_column = false;
+    for (auto& binding : bindings)
+    {
+        past_long_column = past_long_column || binding.element_size == 0;
+        binding.is_bound = binding.element_size > 0 && (any_column || !past_long_column);
+    }
+
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(SQL_BIND_BY_COLUMN)), 0);
+    SQLRETURN ret = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(block_rows), 0);
+    if (ret == SQL_SUCCESS_WITH_INFO || !SQL_SUCCEEDED(ret))
+    {
+        // The driver may substitute a smaller block (01S02), size the buffers for what it accepted
+        SQLULEN accepted = 1;
+        if (SQL_SUCCEEDED(SQLGetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &accepted, 0, NULL)) && accepted > 0)
+        {
+            block_rows = accepted;
+        }
+        else
+        {
+            block_rows = 1;
+        }
+    }
+
+    row_status.assign(block_rows, SQL_ROW_SUCCESS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, row_status.data(), 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rows_fetched, 0);
+
+    for (size_t i = 0; i < bindings.size(); i++)
+    {
+        Column_Binding& binding = bindings[i];
+        if (!binding.is_bound)
+        {
+            continue;
+        }
+
+        binding.buffer.assign(static_cast<size_t>(binding.element_size) * block_rows, 0);
+        binding.indicators.assign(block_rows, SQL_NULL_DATA);
+        ret = SQLBindCol(hstmt, static_cast<SQLUSMALLINT>(i + 1), binding.c_type,
+                         binding.buffer.data(), binding.element_size, binding.indicators.data());
+        if (!SQL_SUCCEEDED(ret))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Database::Row_Fetcher::append_bound_value(Result_Set& rows, size_t column, SQLULEN row)
+{
+    const Column_Binding& binding = bindings[column];
+    SQLLEN indicator = binding.indicators[row];
+    if (indicator == SQL_NULL_DATA)
+    {
+        rows.append_null(column);
+        return true;
+    }
+
+    const char* value = binding.buffer.data() + static_cast<size_t>(binding.element_size) * row;
+    switch (binding.type)
+    {
+    case Column_Type::INT:
+    {
+        SQLBIGINT number;
+        std::memcpy(&number, value, sizeof(number));
+        rows.append_int(column, number);
+        break;
+    }
+    case Column_Type::DOUBLE:
+    {
+        double number;
+        std::memcpy(&number, value, sizeof(number));
+        rows.append_double(column, number);
+        break;
+    }
+    case Column_Type::DATE:
+    case Column_Type::TIMESTAMP:
+    {
+        SQL_TIMESTAMP_STRUCT timestamp;
+        std::memcpy(&timestamp, value, sizeof(timestamp));
+        rows.append_date(column, timestamp);
+        break;
+    }
+    case Column_Type::STRING:
+    {
+        // Buffers are sized from the column's display size, a longer value can only be truncated
+        size_t length = (indicator == SQL_NO_TOTAL || indicator >= binding.element_size)
+            ? static_cast<size_t>(binding.element_size - 1)
+            : static_cast<size_t>(indicator);
+        rows.append_string(column, value, length);
+        break;
+    }
+    }
+    return true;
+}
+
+bool Database::Row_Fetcher::append_unbound_value(Result_Set& rows, size_t column)
+{
+    const Column_Binding& binding = bindings[column];
+    SQLUSMALLINT odbc_column = static_cast<SQLUSMALLINT>(column + 1);
+    SQLLEN indicator = SQL_NULL_DATA;
+    SQLRETURN ret;
+
+    switch (binding.type)
+    {
+    case Column_Type::INT:
+    {
+        SQLBIGINT value = 0;
+        stats.get_data_calls++;
+        ret = SQLGetData(hstmt, odbc_column, SQL_C_SBIGINT, &value, sizeof(value), &indicator);
+        if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA)
+        {
+            rows.append_int(column, value);
+            return true;
+        }
+        break;
+    }
+    case Column_Type::DOUBLE:
+    {
+        double value = 0.0;
+        stats.get_data_calls++;
+        ret = SQLGetData(hstmt, odbc_column, SQL_C_DOUBLE, &value, sizeof(value), &indicator);
+        if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA)
+        {
+            rows.append_double(column, value);
+            return true;
+        }
+        break;
+    }
+    case Column_Type::DATE:
+    case Column_Type::TIMESTAMP:
+    {
+        SQL_TIMESTAMP_STRUCT value = {};
+        stats.get_data_calls++;
+        ret = SQLGetData(hstmt, odbc_column, SQL_C_TYPE_TIMESTAMP, &value, sizeof(value), &indicator);
+        if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA)
+        {
+            rows.append_date(column, value);
+            return true;
+        }
+        break;
+    }
+    case Column_Type::STRING:
+    {
+        bool is_null = true;
+        if (!read_long_text(odbc_column, is_null))
+        {
+            return false;
+        }
+        if (!is_null)
+        {
+            rows.append_string(column, text_buffer.data(), text_buffer.size());
+            return true;
+        }
+        break;
+    }
+    }
+
+    rows.append_null(column);
+    return true;
+}
+
+bool Database::Row_Fetcher::read_long_text(SQLUSMALLINT column, bool& is_null)
+{
+    // TEXT columns are unbounded, read them in chunks instead of truncating at a fixed buffer
+    text_buffer.clear();
+    is_null = false;
+
+    char chunk[4096];
+    while (true)
+    {
+        SQLLEN indicator = 0;
+        stats.get_data_calls++;
+        SQLRETURN ret = SQLGetData(hstmt, column, SQL_C_CHAR, chunk, sizeof(chunk), &indicator);
+
+        if (ret == SQL_NO_DATA)
+        {
+            return true;
+        }
+        if (!SQL_SUCCEEDED(ret))
+        {
+            return false;
+        }
+        if (indicator == SQL_NULL_DATA)
+        {
+            is_null = true;
+            return true;
+        }
+
+        // SQL_SUCCESS_WITH_INFO means the chunk was filled (minus the terminator) and more data follows
+        size_t length = (indicator == SQL_NO_TOTAL || indicator >= static_cast<SQLLEN>(sizeof(chunk)))
+            ? sizeof(chunk) - 1
+            : static_cast<size_t>(indicator);
+        text_buffer.append(chunk, length);
+
+        if (ret == SQL_SUCCESS)
+        {
+            return true;
+        }
+    }
+}
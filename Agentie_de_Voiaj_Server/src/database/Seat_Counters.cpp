@@ -0,0 +1,202 @@
+#include "database/Seat_Counters.h"
+#include "database/Database_Manager.h"
+#include "utils/utils.h"
+
+namespace
+{
+    long long steady_now_ms()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+// ============================================================================
+// Seat_Counters Implementation
+// ============================================================================
+
+Database::Seat_Counters::Seat_Counters(Database_Manager* db_manager)
+    : db_manager(db_manager), next_reconcile_ms(0),
+    held(0), rejected(0), unknown(0), reconciliations(0), corrections(0)
+{
+}
+
+Database::Seat_Hold Database::Seat_Counters::try_hold(int offer_id, int seats)
+{
+    if (db_manager && steady_now_ms() >= next_reconcile_ms.load())
+    {
+        reconcile();
+    }
+
+    std::shared_lock<std::shared_mutex> lock(counters_mutex);
+    std::atomic<int>* counter = find_counter(offer_id);
+    if (!counter)
+    {
+        unknown++;
+        return Seat_Hold::UNKNOWN;
+    }
+
+    int available = counter->load();
+    do
+    {
+        if (available < seats)
+        {
+            rejected++;
+            return Seat_Hold::SOLD_OUT;
+        }
+    } while (!counter->compare_exchange_weak(available, available - seats));
+
+    held++;
+    return Seat_Hold::HELD;
+}
+
+void Database::Seat_Counters::release(int offer_id, int seats)
+{
+    std::shared_lock<std::shared_mutex> lock(counters_mutex);
+    std::atomic<int>* counter = find_counter(offer_id);
+    if (counter)
+    {
+        *counter += seats;
+    }
+}
+
+void Database::Seat_Counters::set_available(int offer_id, int available_seats)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(counters_mutex);
+        std::atomic<int>* counter = find_counter(offer_id);
+        if (counter)
+        {
+            *counter = available_seats;
+            return;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(counters_mutex);
+    auto& counter = counters[offer_id];
+    if (!counter)
+    {
+        counter = std::make_unique<std::atomic<int>>(0);
+    }
+    *counter = available_seats;
+}
+
+void Database::Seat_Counters::forget(int offer_id)
+{
+    std::unique_lock<std::shared_mutex> lock(counters_mutex);
+    counters.erase(offer_id);
+}
+
+bool Database::Seat_Counters::reconcile()
+{
+    std::unique_lock<std::mutex> reconcile_lock(reconcile_mutex, std::try_to_lock);
+    if (!reconcile_lock.owns_lock() || !db_manager)
+    {
+        return false;
+    }
+
+    // Pushed forward before the query, a failing database is not asked again by every booking
+    next_reconcile_ms = steady_now_ms() + Config::Database::SEAT_COUNTER_RECONCILE_SECONDS * 1000LL;
+
+    Query_Result result;
+    try
+    {
+        result = db_manager->execute_prepared("SELECT Offer_ID, Total_Seats - Reserved_Seats AS Available_Seats FROM Offers", {});
+    }
+    catch (const std::exception& e)
+    {
+        Utils::Logger::warning("Seat counter reload failed: " + std::string(e.what()));
+        return false;
+    }
+    if (!result.is_success())
+    {
+        Utils::Logger::warning("Seat counter reload failed: " + result.message);
+        return false;
+    }
+
+    // Holds taken before the query and confirmed later are already in the row, holds
+    // still in flight are forgotten: both leave the counter high, never low
+    std::unordered_map<int, int> loaded;
+    loaded.reserve(result.data.size());
+    for (size_t i = 0; i < result.data.size(); i++)
+    {
+        auto row = result.data[i];
+        loaded[Utils::Conversion::string_to_int(row["Offer_ID"])] = Utils::Conversion::string_to_int(row["Available_Seats"]);
+    }
+
+    long long corrected = 0;
+    {
+        std::unique_lock<std::shared_mutex> lock(counters_mutex);
+        for (auto it = counters.begin(); it != counters.end();)
+        {
+            it = loaded.count(it->first) ? std::next(it) : counters.erase(it);
+        }
+        for (const auto& entry : loaded)
+        {
+            auto& counter = counters[entry.first];
+            if (!counter)
+            {
+                counter = std::make_unique<std::atomic<int>>(entry.second);
+            }
+            else if (counter->exchange(entry.second) != entry.second)
+            {
+                corrected++;
+            }
+        }
+    }
+
+    reconciliations++;
+    corrections += corrected;
+    return true;
+}
+
+void Database::Seat_Counters::reconcile_offer(int offer_id)
+{
+    if (!db_manager)
+    {
+        return;
+    }
+
+    try
+    {
+        auto result = db_manager->execute_prepared("SELECT Total_Seats - Reserved_Seats AS Available_Seats "
+                                                   "FROM Offers WHERE Offer_ID = ?", { offer_id });
+        if (!result.is_success())
+        {
+            return;
+        }
+        if (result.data.empty())
+        {
+            forget(offer_id);
+            return;
+        }
+        set_available(offer_id, Utils::Conversion::string_to_int(result.data[0]["Available_Seats"]));
+        corrections++;
+    }
+    catch (const std::exception& e)
+    {
+        Utils::Logger::warning("Seat counter reload failed for offer " + Utils::Conversion::int_to_string(offer_id) +
+                               ": " + std::string(e.what()));
+    }
+}
+
+Database::Seat_Counter_Stats Database::Seat_Counters::get_stats() const
+{
+    Seat_Counter_Stats stats;
+    stats.held = held.load();
+    stats.rejected = rejected.load();
+    stats.unknown = unknown.load();
+    stats.reconciliations = reconciliations.load();
+    stats.corrections = corrections.load();
+    {
+        std::shared_lock<std::shared_mutex> lock(counters_mutex);
+        stats.tracked_offers = counters.size();
+    }
+    return stats;
+}
+
+std::atomic<int>* Database::Seat_Counters::find_counter(int offer_id) const
+{
+    auto it = counters.find(offer_id);
+    return it != counters.end() ? it->second.get() : nullptr;
+}
@@ -0,0 +1,230 @@
+#include "database/Statement_Cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+// From msodbcsql.h, which comes with the SQL Server driver SDK rather than the Windows SDK
+#ifndef SQL_SS_TABLE
+#define SQL_SS_TABLE (-153)
+#endif
+#ifndef SQL_SOPT_SS_PARAM_FOCUS
+#define SQL_SOPT_SS_PARAM_FOCUS 1236
+#endif
+
+// ============================================================================
+// Statement_Cache Implementation
+// ============================================================================
+
+Database::Statement_Cache::Statement_Cache(SQLHDBC hdbc, size_t capacity)
+    : hdbc(hdbc), capacity(capacity > 0 ? capacity : 1)
+{
+}
+
+Database::Statement_Cache::~Statement_Cache()
+{
+    clear();
+}
+
+SQLHSTMT Database::Statement_Cache::acquire(const std::string& sql, bool& was_cached, std::string& error)
+{
+    auto it = index.find(sql);
+    if (it != index.end())
+    {
+        statements.splice(statements.begin(), statements, it->second);
+        was_cached = true;
+        return statements.front().hstmt;
+    }
+
+    was_cached = false;
+
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+    if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)))
+    {
+        error = "Failed to allocate statement handle";
+        return SQL_NULL_HSTMT;
+    }
+
+    std::vector<char> sql_text(sql.begin(), sql.end());
+    sql_text.push_back('\0');
+    if (!SQL_SUCCEEDED(SQLPrepareA(hstmt, reinterpret_cast<SQLCHAR*>(sql_text.data()), SQL_NTS)))
+    {
+        error = get_statement_error(hstmt);
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        return SQL_NULL_HSTMT;
+    }
+
+    if (statements.size() >= capacity)
+    {
+        index.erase(statements.back().sql);
+        SQLFreeHandle(SQL_HANDLE_STMT, statements.back().hstmt);
+        statements.pop_back();
+    }
+
+    statements.push_front(Cached_Statement{ sql, hstmt });
+    index[sql] = statements.begin();
+    return hstmt;
+}
+
+void Database::Statement_Cache::discard(const std::string& sql)
+{
+    auto it = index.find(sql);
+    if (it == index.end())
+    {
+        return;
+    }
+
+    SQLFreeHandle(SQL_HANDLE_STMT, it->second->hstmt);
+    statements.erase(it->second);
+    index.erase(it);
+}
+
+void Database::Statement_Cache::clear()
+{
+    for (auto& statement : statements)
+    {
+        SQLFreeHandle(SQL_HANDLE_STMT, statement.hstmt);
+    }
+    statements.clear();
+    index.clear();
+}
+
+bool Database::Statement_Cache::bind_parameters(SQLHSTMT hstmt, const std::vector<Sql_Param>& params, Param_Buffers& buffers)
+{
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    std::vector<SQLLEN>& indicators = buffers.indicators;
+    indicators.assign(params.size(), 0);
+    buffers.table_values.clear();
+    buffers.table_lengths.clear();
+
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        const Sql_Param& param = params[i];
+        SQLUSMALLINT number = static_cast<SQLUSMALLINT>(i + 1);
+        SQLPOINTER value = NULL;
+        SQLRETURN ret;
+
+        switch (param.type)
+        {
+        case Param_Type::INT:
+            value = const_cast<int*>(&param.int_value);
+            ret = SQLBindParameter(hstmt, number, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                   0, 0, value, 0, NULL);
+            break;
+        case Param_Type::DOUBLE:
+            // Money columns are DECIMAL, a fixed DECIMAL(18,4) keeps the comparison on the column's type
+            value = const_cast<double*>(&param.double_value);
+            ret = SQLBindParameter(hstmt, number, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DECIMAL,
+                                   18, 4, value, 0, NULL);
+            break;
+        case Param_Type::STRING:
+        {
+            // One declared size for every value, otherwise SQL Server caches a plan per parameter length
+            SQLULEN declared_size = param.string_value.size() <= 8000 ? 8000 : param.string_value.size();
+            SQLSMALLINT sql_type = param.string_value.size() <= 8000 ? SQL_VARCHAR : SQL_LONGVARCHAR;
+            indicators[i] = static_cast<SQLLEN>(param.string_value.size());
+            value = const_cast<char*>(param.string_value.data());
+            ret = SQLBindParameter(hstmt, number, SQL_PARAM_INPUT, SQL_C_CHAR, sql_type,
+                                   declared_size, 0, value, indicators[i], &indicators[i]);
+            break;
+        }
+        case Param_Type::TABLE:
+            if (!param.table_value)
+            {
+                return false;
+            }
+            ret = bind_table(hstmt, number, *param.table_value, indicators[i], buffers);
+            break;
+        case Param_Type::NULL_VALUE:
+        default:
+            indicators[i] = SQL_NULL_DATA;
+            ret = SQLBindParameter(hstmt, number, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                                   1, 0, NULL, 0, &indicators[i]);
+            break;
+        }
+
+        if (!SQL_SUCCEEDED(ret))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+SQLRETURN Database::Statement_Cache::bind_table(SQLHSTMT hstmt, SQLUSMALLINT number, const Sql_Table& table,
+    SQLLEN& row_count, Param_Buffers& buffers)
+{
+    // An empty table is sent as the parameter's default, the columns still need a binding
+    size_t capacity = std::max<size_t>(1, table.rows.size());
+    row_count = table.rows.empty() ? SQL_DEFAULT_PARAM : static_cast<SQLLEN>(table.rows.size());
+
+    SQLRETURN ret = SQLBindParameter(hstmt, number, SQL_PARAM_INPUT, SQL_C_DEFAULT, SQL_SS_TABLE,
+                                     static_cast<SQLULEN>(capacity), 0, NULL, 0, &row_count);
+    if (!SQL_SUCCEEDED(ret))
+    {
+        return ret;
+    }
+
+    // Following bindings describe the table's columns until the focus goes back to 0
+    ret = SQLSetStmtAttr(hstmt, SQL_SOPT_SS_PARAM_FOCUS, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(number)), SQL_IS_INTEGER);
+    if (!SQL_SUCCEEDED(ret))
+    {
+        return ret;
+    }
+
+    for (size_t column = 0; column < table.columns.size(); column++)
+    {
+        const Sql_Table_Column& definition = table.columns[column];
+        size_t width = static_cast<size_t>(definition.size) + 1;
+
+        buffers.table_values.emplace_back(capacity * width, '\0');
+        buffers.table_lengths.emplace_back(capacity, SQL_NULL_DATA);
+        std::vector<char>& values = buffers.table_values.back();
+        std::vector<SQLLEN>& lengths = buffers.table_lengths.back();
+
+        for (size_t row = 0; row < table.rows.size(); row++)
+        {
+            if (column >= table.rows[row].size())
+            {
+                continue; // Missing values go as NULL
+            }
+
+            const std::string& value = table.rows[row][column];
+            if (value.size() >= width)
+            {
+                return SQL_ERROR; // Would be truncated
+            }
+            std::memcpy(values.data() + row * width, value.data(), value.size());
+            lengths[row] = static_cast<SQLLEN>(value.size());
+        }
+
+        ret = SQLBindParameter(hstmt, static_cast<SQLUSMALLINT>(column + 1), SQL_PARAM_INPUT, SQL_C_CHAR,
+                               definition.sql_type, definition.size, 0, values.data(),
+                               static_cast<SQLLEN>(width), lengths.data());
+        if (!SQL_SUCCEEDED(ret))
+        {
+            return ret;
+        }
+    }
+
+    return SQLSetStmtAttr(hstmt, SQL_SOPT_SS_PARAM_FOCUS, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(0)), SQL_IS_INTEGER);
+}
+
+std::string Database::Statement_Cache::get_statement_error(SQLHSTMT hstmt)
+{
+    SQLCHAR sql_state[6];
+    SQLCHAR error_msg[1024];
+    SQLINTEGER native_error;
+    SQLSMALLINT msg_len;
+
+    SQLRETURN ret = SQLGetDiagRecA(SQL_HANDLE_STMT, hstmt, 1, sql_state, &native_error,
+        error_msg, sizeof(error_msg), &msg_len);
+
+    if (SQL_SUCCEEDED(ret))
+    {
+        return "SQL State: " + std::string(reinterpret_cast<char*>(sql_state)) +
+               ", Error: " + std::string(reinterpret_cast<char*>(error_msg));
+    }
+
+    return "Unknown SQL error";
+}
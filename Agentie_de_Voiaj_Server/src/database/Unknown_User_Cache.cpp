@@ -0,0 +1,76 @@
+#include "database/Unknown_User_Cache.h"
+
+#include <algorithm>
+#include <cctype>
+
+// ============================================================================
+// Unknown_User_Cache Implementation
+// ============================================================================
+
+Database::Unknown_User_Cache::Unknown_User_Cache(std::chrono::milliseconds ttl, size_t max_entries)
+    : ttl(ttl), max_entries(std::max<size_t>(1, max_entries)), hits(0)
+{
+}
+
+bool Database::Unknown_User_Cache::contains(const std::string& username)
+{
+    std::string key = to_key(username);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = expiry_by_username.find(key);
+    if (it == expiry_by_username.end())
+    {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() >= it->second)
+    {
+        expiry_by_username.erase(it);
+        return false;
+    }
+    hits++;
+    return true;
+}
+
+void Database::Unknown_User_Cache::add(const std::string& username)
+{
+    std::string key = to_key(username);
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Full: expired names go first, and when every entry is live the cache starts over
+    // rather than growing with an attacker's dictionary
+    if (expiry_by_username.size() >= max_entries)
+    {
+        for (auto it = expiry_by_username.begin(); it != expiry_by_username.end();)
+        {
+            it = now >= it->second ? expiry_by_username.erase(it) : std::next(it);
+        }
+        if (expiry_by_username.size() >= max_entries)
+        {
+            expiry_by_username.clear();
+        }
+    }
+    expiry_by_username[key] = now + ttl;
+}
+
+void Database::Unknown_User_Cache::remove(const std::string& username)
+{
+    std::string key = to_key(username);
+    std::lock_guard<std::mutex> lock(mutex);
+    expiry_by_username.erase(key);
+}
+
+size_t Database::Unknown_User_Cache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return expiry_by_username.size();
+}
+
+std::string Database::Unknown_User_Cache::to_key(const std::string& username)
+{
+    std::string key = username;
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c)
+    {
+        return static_cast<char>(std::tolower(c));
+    });
+    return key;
+}
@@ -1,6 +1,9 @@
 ﻿#include "network/Client_Handler.h"
 #include "network/Protocol_Handler.h"
 #include "network/Socket_Server.h"
+#include "network/Io_Reactor.h"
+#include "network/Latency_Metrics.h"
+#include "network/Worker_Pool.h"
 #include <iostream>
 #include <chrono>
 
@@ -17,7 +20,8 @@ SocketNetwork::Client_Handler::Client_Handler(SOCKET socket, const SocketNetwork
     std::shared_ptr<Database::Database_Manager> db_manager,
     Protocol_Handler* protocol_handler, SocketNetwork::Socket_Server* server)
     : client_socket(socket), client_info(info), db_manager(db_manager),
-      protocol_handler(protocol_handler), server(server), is_running(false)
+      protocol_handler(protocol_handler), server(server), is_running(false),
+      decoder(static_cast<size_t>(Config::JSON::MAX_JSON_SIZE))
 {
     last_activity = std::chrono::steady_clock::now();
 }
@@ -35,7 +39,12 @@ void SocketNetwork::Client_Handler::start_handling()
     }
     
     is_running = true;
-    handler_thread = std::thread(&Client_Handler::handle_client_loop, this);
+
+    // In reactor mode the I/O loop drives this handler, no dedicated thread
+    if (!reactor)
+    {
+        handler_thread = std::thread(&Client_Handler::handle_client_loop, this);
+    }
 }
 
 void SocketNetwork::Client_Handler::stop_handling()
@@ -47,6 +56,18 @@ void SocketNetwork::Client_Handler::stop_handling()
     
     is_running = false;
     
+    // The socket may still sit in the reactor's poll set, so only shut it down
+    // and let the loop drop it; SocketRAII closes it with the last reference
+    if (reactor)
+    {
+        if (client_socket.is_valid())
+        {
+            shutdown(client_socket, SD_BOTH);
+        }
+        reactor->wake(reactor_loop);
+        return;
+    }
+    
     // Închide socket-ul pentru a forța ieșirea din recv()
     if (client_socket.is_valid())
     {
@@ -105,30 +126,128 @@ bool SocketNetwork::Client_Handler::is_client_running() const
     return is_running.load();
 }
 
-bool SocketNetwork::Client_Handler::send_message(const std::string& message)
+void SocketNetwork::Client_Handler::attach_reactor(Io_Reactor* io_reactor, int loop_index)
+{
+    reactor = io_reactor;
+    reactor_loop = loop_index;
+}
+
+void SocketNetwork::Client_Handler::attach_worker_pool(Worker_Pool* pool)
+{
+    worker_pool = pool;
+}
+
+bool SocketNetwork::Client_Handler::on_readable()
+{
+    char buffer[Config::Server::BUFFER_SIZE];
+    bool peer_closed = false;
+    
+    // Bounded drain: a chatty client cannot starve the other sockets of this loop,
+    // anything left is reported again by the next (level-triggered) poll
+    for (int reads = 0; reads < Config::Server::MAX_READS_PER_EVENT; reads++)
+    {
+        int bytes_received = recv(client_socket, buffer, sizeof(buffer), 0);
+        
+        if (bytes_received > 0)
+        {
+            decoder.append(buffer, static_cast<size_t>(bytes_received));
+            continue;
+        }
+        
+        if (bytes_received == 0)
+        {
+            peer_closed = true;
+            break;
+        }
+        
+        int error = WSAGetLastError();
+        if (error == WSAEWOULDBLOCK)
+        {
+            break;
+        }
+        if (error != WSAEINTR)
+        {
+            return false;
+        }
+    }
+    
+    Frame frame;
+    while (true)
+    {
+        Frame_Decoder::Result result = decoder.next(frame);
+        if (result == Frame_Decoder::Result::NEED_MORE)
+        {
+            break;
+        }
+        if (result == Frame_Decoder::Result::TOO_LARGE)
+        {
+            send_error_response("Message too large");
+            return false;
+        }
+        
+        messages_received++;
+        update_last_activity();
+        
+        if (!process_message(frame) || !is_running.load())
+        {
+            return false;
+        }
+    }
+    
+    return !peer_closed;
+}
+
+bool SocketNetwork::Client_Handler::on_writable()
+{
+    std::lock_guard<std::mutex> lock(send_mutex);
+    
+    // Everything queued since the last event leaves in as few WSASend calls as possible
+    Send_Queue::Flush_Result result = send_queue.flush(client_socket);
+    if (result != Send_Queue::Flush_Result::DONE)
+    {
+        return result == Send_Queue::Flush_Result::WOULD_BLOCK;
+    }
+    
+    has_output = false;
+    return true;
+}
+
+bool SocketNetwork::Client_Handler::has_pending_output() const
+{
+    return has_output.load();
+}
+
+bool SocketNetwork::Client_Handler::send_message(const std::string& message, const Frame_Header& header)
+{
+    return send_shared_message(std::make_shared<const std::string>(message), header);
+}
+
+bool SocketNetwork::Client_Handler::send_shared_message(const Shared_Buffer& message, const Frame_Header& header)
 {
     std::lock_guard<std::mutex> lock(send_mutex);
     
     // Recheck socket validity inside the lock
-    if (!is_socket_valid())
+    if (!is_socket_valid() || !message)
     {
         return false;
     }
     
     try 
     {
-        std::string full_message = message + "\r\n";
-        int bytes_sent = send(client_socket, full_message.c_str(), 
-                             static_cast<int>(full_message.length()), 0);
-        
-        if (bytes_sent == SOCKET_ERROR)
+        // The header or delimiter goes out as a separate buffer, the payload is not copied;
+        // a compressed payload is this connection's own, so a large broadcast stops being shared
+        Shared_Buffer payload = message;
+        Frame_Header frame_header = header;
+        if (compressor && output_framing == Framing_Mode::BINARY)
         {
-            return false;
+            if (const std::string* packed = compressor->compress(message->data(), message->size()))
+            {
+                payload = std::make_shared<const std::string>(*packed);
+                frame_header.flags |= FRAME_FLAG_COMPRESSED;
+            }
         }
-        
-        messages_sent++;
-        update_last_activity();
-        return true;
+        send_queue.push_frame(output_framing, frame_header, payload);
+        return flush_output();
     }
     catch (const std::exception&)
     {
@@ -136,34 +255,194 @@ bool SocketNetwork::Client_Handler::send_message(const std::string& message)
     }
 }
 
-std::string SocketNetwork::Client_Handler::receive_message()
+bool SocketNetwork::Client_Handler::send_response(const Response& response, const Frame_Header& header)
 {
+    std::lock_guard<std::mutex> lock(send_mutex);
+    
     if (!is_socket_valid())
     {
-        return "";
+        return false;
     }
     
-    char buffer[Config::Server::BUFFER_SIZE];
-    int bytes_received = recv(client_socket, buffer, sizeof(buffer) - 1, 0);
-    
-    if (bytes_received <= 0)
+    try 
     {
-        return "";
+        // Serialized in one pass into the connection's reusable buffer
+        auto started = std::chrono::steady_clock::now();
+        const std::string& wire_message = compress_frame(response_writer.write(response, output_framing, header));
+        Latency_Metrics::record(from_wire_type(header.message_type), Latency_Phase::SERIALIZE,
+            std::chrono::steady_clock::now() - started);
+        return send_encoded(wire_message);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+const std::string& SocketNetwork::Client_Handler::compress_frame(const std::string& wire_message)
+{
+    if (!compressor || output_framing != Framing_Mode::BINARY || wire_message.size() <= FRAME_HEADER_SIZE)
+    {
+        return wire_message;
+    }
+
+    const std::string* packed = compressor->compress(wire_message.data() + FRAME_HEADER_SIZE,
+                                                     wire_message.size() - FRAME_HEADER_SIZE);
+    if (!packed)
+    {
+        return wire_message;
+    }
+
+    Frame_Header header = read_frame_header(wire_message.data());
+    header.length = static_cast<uint32_t>(packed->size());
+    header.flags |= FRAME_FLAG_COMPRESSED;
+    compressed_frame.resize(FRAME_HEADER_SIZE);
+    write_frame_header(&compressed_frame[0], header);
+    compressed_frame.append(*packed);
+    return compressed_frame;
+}
+
+bool SocketNetwork::Client_Handler::send_encoded(const std::string& full_message)
+{
+    // Sent straight from the writer's reused buffer when nothing is queued ahead of
+    // it; only the part the socket does not take is copied into the queue
+    size_t offset = 0;
+    if (send_queue.empty())
+    {
+        while (offset < full_message.size())
+        {
+            int bytes_sent = send(client_socket, full_message.data() + offset,
+                                  static_cast<int>(full_message.size() - offset), 0);
+            if (bytes_sent == SOCKET_ERROR)
+            {
+                int error = WSAGetLastError();
+                if (error == WSAEWOULDBLOCK)
+                {
+                    break;
+                }
+                if (error != WSAEINTR)
+                {
+                    return false;
+                }
+                continue;
+            }
+            offset += bytes_sent;
+        }
     }
     
-    buffer[bytes_received] = '\0';
-    std::string message(buffer);
+    send_queue.push_copy(full_message.data() + offset, full_message.size() - offset);
+    return flush_output();
+}
+
+bool SocketNetwork::Client_Handler::flush_output()
+{
+    // While on_writable() is due the socket is full: the message waits in the queue
+    // and goes out with the others in the same WSASend
+    if (!send_queue.empty() && !has_output.load())
+    {
+        Send_Queue::Flush_Result result = send_queue.flush(client_socket);
+        if (result == Send_Queue::Flush_Result::FAILED ||
+            (result == Send_Queue::Flush_Result::WOULD_BLOCK && !reactor))
+        {
+            return false;
+        }
+    }
     
-    // Remove trailing \r\n
-    while (!message.empty() && (message.back() == '\r' || message.back() == '\n'))
+    if (!send_queue.empty())
     {
-        message.pop_back();
+        if (send_queue.size() > static_cast<size_t>(Config::Server::MAX_PENDING_OUTPUT_BYTES))
+        {
+            shutdown(client_socket, SD_BOTH);
+            return false;
+        }
+        
+        if (!has_output.exchange(true))
+        {
+            reactor->wake(reactor_loop);
+        }
     }
     
-    messages_received++;
+    messages_sent++;
     update_last_activity();
+    return true;
+}
+
+std::string SocketNetwork::Client_Handler::receive_message()
+{
+    Frame frame;
+    return receive_frame(frame) ? frame.payload : "";
+}
+
+bool SocketNetwork::Client_Handler::receive_frame(Frame& frame)
+{
+    // Thread-per-client mode: blocks until the reassembly buffer holds a whole message
+    char buffer[Config::Server::BUFFER_SIZE];
+    while (is_socket_valid())
+    {
+        Frame_Decoder::Result result = decoder.next(frame);
+        if (result == Frame_Decoder::Result::FRAME)
+        {
+            messages_received++;
+            update_last_activity();
+            return true;
+        }
+        if (result == Frame_Decoder::Result::TOO_LARGE)
+        {
+            send_error_response("Message too large");
+            return false;
+        }
+        
+        int bytes_received = recv(client_socket, buffer, sizeof(buffer), 0);
+        if (bytes_received > 0)
+        {
+            decoder.append(buffer, static_cast<size_t>(bytes_received));
+            continue;
+        }
+        if (bytes_received == SOCKET_ERROR && WSAGetLastError() == WSAETIMEDOUT)
+        {
+            continue; // Timeout is normal, keep listening
+        }
+        return false; // Client disconnected or error
+    }
+    return false;
+}
+
+void SocketNetwork::Client_Handler::request_framing(Framing_Mode mode)
+{
+    requested_framing = mode;
+    has_framing_request = true;
+}
+
+void SocketNetwork::Client_Handler::request_compression(bool use_dictionary)
+{
+    requested_dictionary = use_dictionary;
+    has_compression_request = true;
+}
+
+void SocketNetwork::Client_Handler::apply_requested_framing()
+{
+    if (!has_framing_request && !has_compression_request)
+    {
+        return;
+    }
     
-    return message;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex);
+        if (has_framing_request)
+        {
+            output_framing = requested_framing;
+        }
+        if (has_compression_request)
+        {
+            compressor = std::make_unique<Payload_Compressor>(requested_dictionary);
+        }
+    }
+    if (has_framing_request)
+    {
+        decoder.set_mode(requested_framing);
+    }
+    has_framing_request = false;
+    has_compression_request = false;
 }
 
 const SocketNetwork::Client_Info& SocketNetwork::Client_Handler::get_client_info() const
@@ -171,27 +450,76 @@ const SocketNetwork::Client_Info& SocketNetwork::Client_Handler::get_client_info
     return client_info;
 }
 
+SocketNetwork::Client_Info SocketNetwork::Client_Handler::get_client_snapshot() const
+{
+    std::lock_guard<std::mutex> lock(session_mutex);
+    return client_info;
+}
+
+int SocketNetwork::Client_Handler::get_user_id() const
+{
+    std::lock_guard<std::mutex> lock(session_mutex);
+    return client_info.user_id;
+}
+
 void SocketNetwork::Client_Handler::update_last_activity()
 {
+    std::string now_text = Utils::DateTime::get_current_date_time();
+    std::lock_guard<std::mutex> lock(session_mutex);
     last_activity = std::chrono::steady_clock::now();
-    client_info.last_activity_time = Utils::DateTime::get_current_date_time();
+    client_info.last_activity_time = std::move(now_text);
 }
 
 bool SocketNetwork::Client_Handler::is_authenticated() const
 {
+    std::lock_guard<std::mutex> lock(session_mutex);
     return client_info.is_authenticated;
 }
 
 void SocketNetwork::Client_Handler::set_authenticated(int user_id, const std::string& username)
 {
-    client_info.is_authenticated = true;
-    client_info.user_id = user_id;
-    client_info.username = username;
+    SOCKET socket;
+    int previous_user_id;
+    {
+        std::lock_guard<std::mutex> lock(session_mutex);
+        socket = client_info.socket;
+        previous_user_id = client_info.user_id;
+        client_info.is_authenticated = true;
+        client_info.user_id = user_id;
+        client_info.username = username;
+    }
+
+    // Lets pushes for this user find the connection
+    if (server)
+    {
+        server->bind_client_user(socket, user_id, previous_user_id);
+    }
+}
+
+void SocketNetwork::Client_Handler::clear_authentication()
+{
+    SOCKET socket;
+    int previous_user_id;
+    {
+        std::lock_guard<std::mutex> lock(session_mutex);
+        socket = client_info.socket;
+        previous_user_id = client_info.user_id;
+        client_info.is_authenticated = false;
+        client_info.user_id = 0;
+        client_info.username.clear();
+    }
+
+    // No more pushes meant for that user
+    if (server && previous_user_id != 0)
+    {
+        server->unbind_client_user(socket, previous_user_id);
+    }
 }
 
 std::chrono::milliseconds SocketNetwork::Client_Handler::get_idle_time() const
 {
     auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(session_mutex);
     return std::chrono::duration_cast<std::chrono::milliseconds>(now - last_activity);
 }
 
@@ -203,19 +531,13 @@ void SocketNetwork::Client_Handler::handle_client_loop()
         {
             try 
             {
-                std::string message = receive_message();
-                
-                if (message.empty())
+                Frame frame;
+                if (!receive_frame(frame))
                 {
-                    int error = WSAGetLastError();
-                    if (error == WSAETIMEDOUT || error == 0)
-                    {
-                        continue; // Timeout is normal, continue listening
-                    }
                     break; // Client disconnected or error
                 }
                 
-                if (!process_message(message))
+                if (!process_message(frame))
                 {
                     break; // Error processing message
                 }
@@ -255,45 +577,167 @@ void SocketNetwork::Client_Handler::handle_client_loop()
     handle_disconnection();
 }
 
-bool SocketNetwork::Client_Handler::process_message(const std::string& message)
+bool SocketNetwork::Client_Handler::process_message(const Frame& frame)
 {
     if (!protocol_handler)
     {
-        send_error_response(Config::ErrorMessages::SERVER_ERROR);
+        send_error_response(Config::ErrorMessages::SERVER_ERROR, frame.header);
         return false;
     }
     
     try 
     {
-        auto parsed_message = protocol_handler->parse_message(message);
+        // Only responses are compressed, requests are small
+        if (frame.header.flags & FRAME_FLAG_COMPRESSED)
+        {
+            send_error_response("Compressed requests are not supported", frame.header);
+            return true;
+        }
+        
+        // Binary frames name the message type in the header, the payload need not
+        auto started = std::chrono::steady_clock::now();
+        auto parsed_message = protocol_handler->parse_message(frame.payload, from_wire_type(frame.header.message_type),
+            frame.header.request_id);
+        Latency_Metrics::record(parsed_message.type, Latency_Phase::PARSE, std::chrono::steady_clock::now() - started);
+        
+        Frame_Header reply;
+        reply.message_type = frame.header.message_type;
+        reply.flags = FRAME_FLAG_RESPONSE;
+        reply.request_id = parsed_message.request_id;
         
         if (!parsed_message.is_valid)
         {
-            send_error_response(parsed_message.error_message);
+            send_error_response(parsed_message.error_message, reply);
             return true; // Continue handling other messages
         }
         
-        auto response = protocol_handler->process_message(parsed_message, this);
+        // HELLO decides how the next frame is decoded, so it completes before reading on
+        Message_Type type = parsed_message.type;
+        if (!worker_pool || type == Message_Type::HELLO)
+        {
+            bool is_sent = execute_request(parsed_message, reply, started);
+            
+            // A HELLO response still goes out in the old framing, everything after it in the new one
+            apply_requested_framing();
+            return is_sent;
+        }
         
-        std::string response_str;
-        if (response.success)
+        // The I/O thread goes back to reading
+        bool is_queued;
+        if (reply.request_id == 0)
         {
-            response_str = Utils::JSON::create_success_response(response.data, response.message);
+            is_queued = queue_untagged_request(std::move(parsed_message), reply, started);
         }
-        else 
+        else
         {
-            response_str = Utils::JSON::create_error_response(response.message, response.error_code);
+            // The response carries the request id and may overtake responses to earlier requests
+            auto self = shared_from_this();
+            is_queued = worker_pool->try_submit(Worker_Pool::priority_for(type),
+                [self, parsed_message = std::move(parsed_message), reply, started]()
+                {
+                    self->execute_request(parsed_message, reply, started);
+                });
         }
         
-        return send_message(response_str);
+        if (!is_queued)
+        {
+            reply.message_type = to_wire_type(type);
+            reply.flags |= FRAME_FLAG_ERROR;
+            Response busy(false, Config::ErrorMessages::SERVER_BUSY, "", Config::Server::SERVER_BUSY_ERROR_CODE);
+            busy.request_id = reply.request_id;
+            send_response(busy, reply);
+        }
+        return true;
     }
     catch (const std::exception& e)
     {
-        send_error_response("Message processing error: " + std::string(e.what()));
+        send_error_response("Message processing error: " + std::string(e.what()), frame.header);
         return true;
     }
 }
 
+bool SocketNetwork::Client_Handler::execute_request(const Parsed_Message& parsed_message, Frame_Header reply,
+    std::chrono::steady_clock::time_point started)
+{
+    if (!is_running.load())
+    {
+        return false; // Disconnected while the request was queued
+    }
+    
+    try 
+    {
+        auto handler_started = std::chrono::steady_clock::now();
+        auto response = protocol_handler->process_message(parsed_message, this);
+        Latency_Metrics::record(parsed_message.type, Latency_Phase::DATABASE, std::chrono::steady_clock::now() - handler_started);
+        response.request_id = parsed_message.request_id;
+        reply.message_type = to_wire_type(parsed_message.type);
+        if (!response.success)
+        {
+            reply.flags |= FRAME_FLAG_ERROR;
+        }
+        
+        // TOTAL includes the time spent queued for a worker
+        bool is_sent = send_response(response, reply);
+        Latency_Metrics::record(parsed_message.type, Latency_Phase::TOTAL, std::chrono::steady_clock::now() - started);
+        return is_sent;
+    }
+    catch (const std::exception& e)
+    {
+        send_error_response("Message processing error: " + std::string(e.what()), reply);
+        return true;
+    }
+}
+
+bool SocketNetwork::Client_Handler::queue_untagged_request(Parsed_Message&& parsed_message, const Frame_Header& reply,
+    std::chrono::steady_clock::time_point started)
+{
+    Request_Priority priority = Worker_Pool::priority_for(parsed_message.type);
+    {
+        std::lock_guard<std::mutex> lock(untagged_mutex);
+        if (untagged_requests.size() >= static_cast<size_t>(Config::Server::MAX_UNTAGGED_REQUESTS))
+        {
+            return false;
+        }
+        untagged_requests.push_back({ std::move(parsed_message), reply, started });
+        if (is_untagged_running)
+        {
+            return true; // The running worker takes it after the ones before it
+        }
+        is_untagged_running = true;
+    }
+    
+    auto self = shared_from_this();
+    if (worker_pool->try_submit(priority, [self]() { self->run_untagged_requests(); }))
+    {
+        return true;
+    }
+    
+    // Nothing was running, so the queue holds only this request
+    std::lock_guard<std::mutex> lock(untagged_mutex);
+    untagged_requests.clear();
+    is_untagged_running = false;
+    return false;
+}
+
+void SocketNetwork::Client_Handler::run_untagged_requests()
+{
+    while (true)
+    {
+        Untagged_Request request;
+        {
+            std::lock_guard<std::mutex> lock(untagged_mutex);
+            if (untagged_requests.empty())
+            {
+                is_untagged_running = false;
+                return;
+            }
+            request = std::move(untagged_requests.front());
+            untagged_requests.pop_front();
+        }
+        execute_request(request.message, request.reply, request.started);
+    }
+}
+
 void SocketNetwork::Client_Handler::handle_disconnection()
 {
     is_running = false;
@@ -309,10 +753,16 @@ bool SocketNetwork::Client_Handler::is_socket_valid() const
     return client_socket.is_valid() && is_running.load();
 }
 
-void SocketNetwork::Client_Handler::send_error_response(const std::string& error_message)
+void SocketNetwork::Client_Handler::send_error_response(const std::string& error_message, const Frame_Header& request)
 {
-    std::string response = Utils::JSON::create_error_response(error_message);
-    send_message(response);
+    Frame_Header reply;
+    reply.message_type = request.message_type;
+    reply.flags = FRAME_FLAG_RESPONSE | FRAME_FLAG_ERROR;
+    reply.request_id = request.request_id;
+    
+    Response response(false, error_message, "", -1);
+    response.request_id = request.request_id;
+    send_response(response, reply);
 }
 
 void SocketNetwork::Client_Handler::send_success_response(const std::string& data, const std::string& message)
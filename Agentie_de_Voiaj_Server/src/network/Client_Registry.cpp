@@ -0,0 +1,206 @@
+#include "network/Client_Registry.h"
+#include "network/Client_Handler.h"
+
+#include <algorithm>
+
+// ============================================================================
+// Client_Registry Implementation
+// ============================================================================
+
+SocketNetwork::Client_Registry::Client_Registry(size_t shard_count)
+{
+    shard_count = std::max<size_t>(1, shard_count);
+    for (size_t i = 0; i < shard_count; i++)
+    {
+        client_shards.push_back(std::make_unique<Client_Shard>());
+        user_shards.push_back(std::make_unique<User_Shard>());
+    }
+}
+
+bool SocketNetwork::Client_Registry::add(SOCKET socket, Client_Ptr client)
+{
+    Client_Shard& shard = client_shard(socket);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    bool is_added = shard.clients.emplace(socket, std::move(client)).second;
+    if (is_added)
+    {
+        client_count++;
+    }
+    return is_added;
+}
+
+SocketNetwork::Client_Registry::Client_Ptr SocketNetwork::Client_Registry::remove(SOCKET socket)
+{
+    Client_Ptr client;
+    {
+        Client_Shard& shard = client_shard(socket);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.clients.find(socket);
+        if (it == shard.clients.end())
+        {
+            return nullptr;
+        }
+        client = std::move(it->second);
+        shard.clients.erase(it);
+        client_count--;
+    }
+
+    if (client)
+    {
+        int user_id = client->get_user_id();
+        if (user_id != 0)
+        {
+            unbind_user(socket, user_id);
+        }
+    }
+    return client;
+}
+
+SocketNetwork::Client_Registry::Client_Ptr SocketNetwork::Client_Registry::find(SOCKET socket) const
+{
+    Client_Shard& shard = client_shard(socket);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.clients.find(socket);
+    return it != shard.clients.end() ? it->second : nullptr;
+}
+
+void SocketNetwork::Client_Registry::bind_user(SOCKET socket, int user_id, int previous_user_id)
+{
+    if (previous_user_id != 0 && previous_user_id != user_id)
+    {
+        unbind_user(socket, previous_user_id);
+    }
+
+    User_Shard& shard = user_shard(user_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& sockets = shard.sockets[user_id];
+    if (std::find(sockets.begin(), sockets.end(), socket) == sockets.end())
+    {
+        sockets.push_back(socket);
+    }
+}
+
+std::vector<SocketNetwork::Client_Registry::Client_Ptr> SocketNetwork::Client_Registry::find_by_user(int user_id)
+{
+    std::vector<SOCKET> sockets;
+    {
+        User_Shard& shard = user_shard(user_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sockets.find(user_id);
+        if (it == shard.sockets.end())
+        {
+            return {};
+        }
+        sockets = it->second;
+    }
+
+    // A login racing a disconnect can leave a stale socket behind, it is dropped here
+    std::vector<Client_Ptr> clients;
+    for (SOCKET socket : sockets)
+    {
+        Client_Ptr client = find(socket);
+        if (client && client->get_user_id() == user_id)
+        {
+            clients.push_back(std::move(client));
+        }
+        else
+        {
+            unbind_user(socket, user_id);
+        }
+    }
+    return clients;
+}
+
+std::vector<SocketNetwork::Client_Registry::Client_Ptr> SocketNetwork::Client_Registry::snapshot() const
+{
+    std::vector<Client_Ptr> clients;
+    clients.reserve(static_cast<size_t>(std::max(0, client_count.load())));
+    for (const auto& shard : client_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& entry : shard->clients)
+        {
+            clients.push_back(entry.second);
+        }
+    }
+    return clients;
+}
+
+std::vector<SocketNetwork::Client_Registry::Client_Ptr> SocketNetwork::Client_Registry::remove_if(
+    const std::function<bool(const Client_Ptr&)>& predicate)
+{
+    std::vector<SOCKET> matching;
+    for (const auto& shard : client_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& entry : shard->clients)
+        {
+            if (predicate(entry.second))
+            {
+                matching.push_back(entry.first);
+            }
+        }
+    }
+
+    std::vector<Client_Ptr> removed;
+    for (SOCKET socket : matching)
+    {
+        Client_Ptr client = remove(socket);
+        if (client)
+        {
+            removed.push_back(std::move(client));
+        }
+    }
+    return removed;
+}
+
+std::vector<SocketNetwork::Client_Registry::Client_Ptr> SocketNetwork::Client_Registry::clear()
+{
+    std::vector<Client_Ptr> removed;
+    for (const auto& shard : client_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto& entry : shard->clients)
+        {
+            removed.push_back(std::move(entry.second));
+        }
+        client_count -= static_cast<int>(shard->clients.size());
+        shard->clients.clear();
+    }
+    for (const auto& shard : user_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->sockets.clear();
+    }
+    return removed;
+}
+
+SocketNetwork::Client_Registry::Client_Shard& SocketNetwork::Client_Registry::client_shard(SOCKET socket) const
+{
+    // Socket handles are multiples of 4 on Windows, drop the low bits before picking a shard
+    size_t key = static_cast<size_t>(socket) >> 2;
+    return *client_shards[key % client_shards.size()];
+}
+
+SocketNetwork::Client_Registry::User_Shard& SocketNetwork::Client_Registry::user_shard(int user_id) const
+{
+    return *user_shards[static_cast<size_t>(static_cast<unsigned int>(user_id)) % user_shards.size()];
+}
+
+void SocketNetwork::Client_Registry::unbind_user(SOCKET socket, int user_id)
+{
+    User_Shard& shard = user_shard(user_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sockets.find(user_id);
+    if (it == shard.sockets.end())
+    {
+        return;
+    }
+
+    auto& sockets = it->second;
+    sockets.erase(std::remove(sockets.begin(), sockets.end(), socket), sockets.end());
+    if (sockets.empty())
+    {
+        shard.sockets.erase(it);
+    }
+}
@@ -0,0 +1,224 @@
+#include "network/Frame_Codec.h"
+
+namespace
+{
+    void write_u32(char* out, uint32_t value)
+    {
+        out[0] = static_cast<char>((value >> 24) & 0xFF);
+        out[1] = static_cast<char>((value >> 16) & 0xFF);
+        out[2] = static_cast<char>((value >> 8) & 0xFF);
+        out[3] = static_cast<char>(value & 0xFF);
+    }
+
+    void write_u16(char* out, uint16_t value)
+    {
+        out[0] = static_cast<char>((value >> 8) & 0xFF);
+        out[1] = static_cast<char>(value & 0xFF);
+    }
+
+    uint32_t read_u32(const char* in)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+            (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    }
+
+    uint16_t read_u16(const char* in)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+        return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+    }
+}
+
+// ============================================================================
+// Frame_Decoder Implementation
+// ============================================================================
+
+SocketNetwork::Frame_Decoder::Frame_Decoder(size_t max_payload_bytes)
+    : max_payload_bytes(max_payload_bytes)
+{
+}
+
+void SocketNetwork::Frame_Decoder::append(const char* data, size_t size)
+{
+    buffer.append(data, size);
+}
+
+SocketNetwork::Frame_Decoder::Result SocketNetwork::Frame_Decoder::next(Frame& frame)
+{
+    if (mode == Framing_Mode::BINARY)
+    {
+        if (buffered() < FRAME_HEADER_SIZE)
+        {
+            compact();
+            return Result::NEED_MORE;
+        }
+
+        Frame_Header header = read_frame_header(buffer.data() + read_offset);
+        if (header.length > max_payload_bytes)
+        {
+            return Result::TOO_LARGE;
+        }
+        if (buffered() < FRAME_HEADER_SIZE + header.length)
+        {
+            compact();
+            return Result::NEED_MORE;
+        }
+
+        frame.header = header;
+        frame.payload.assign(buffer, read_offset + FRAME_HEADER_SIZE, header.length);
+        read_offset += FRAME_HEADER_SIZE + header.length;
+        scan_offset = read_offset;
+        return Result::FRAME;
+    }
+
+    // Text lines: blank lines (keepalive CRLFs) are skipped
+    while (true)
+    {
+        size_t newline = buffer.find('\n', scan_offset);
+        if (newline == std::string::npos)
+        {
+            scan_offset = buffer.size();
+            if (buffered() > max_payload_bytes)
+            {
+                return Result::TOO_LARGE;
+            }
+            compact();
+            return Result::NEED_MORE;
+        }
+
+        size_t end = newline;
+        if (end > read_offset && buffer[end - 1] == '\r')
+        {
+            end--;
+        }
+        size_t start = read_offset;
+        read_offset = newline + 1;
+        scan_offset = read_offset;
+
+        if (end > start)
+        {
+            frame.header = Frame_Header();
+            frame.header.length = static_cast<uint32_t>(end - start);
+            frame.payload.assign(buffer, start, end - start);
+            return Result::FRAME;
+        }
+    }
+}
+
+void SocketNetwork::Frame_Decoder::set_mode(Framing_Mode new_mode)
+{
+    mode = new_mode;
+    scan_offset = read_offset;
+}
+
+void SocketNetwork::Frame_Decoder::clear()
+{
+    buffer.clear();
+    read_offset = 0;
+    scan_offset = 0;
+}
+
+void SocketNetwork::Frame_Decoder::compact()
+{
+    // Consumed bytes are dropped only when waiting for more, never once per message
+    if (read_offset == 0)
+    {
+        return;
+    }
+    buffer.erase(0, read_offset);
+    scan_offset -= read_offset;
+    read_offset = 0;
+}
+
+// ============================================================================
+// Frame encoding
+// ============================================================================
+
+std::string SocketNetwork::encode_frame(Framing_Mode mode, const Frame_Header& header, const std::string& payload)
+{
+    std::string out;
+    if (mode == Framing_Mode::BINARY)
+    {
+        Frame_Header wire_header = header;
+        wire_header.length = static_cast<uint32_t>(payload.size());
+
+        out.resize(FRAME_HEADER_SIZE);
+        write_frame_header(&out[0], wire_header);
+        out += payload;
+        return out;
+    }
+
+    out.reserve(payload.size() + 2);
+    out += payload;
+    out += "\r\n";
+    return out;
+}
+
+void SocketNetwork::write_frame_header(char* out, const Frame_Header& header)
+{
+    write_u32(out, header.length);
+    write_u16(out + 4, header.message_type);
+    write_u16(out + 6, header.flags);
+    write_u32(out + 8, header.request_id);
+}
+
+SocketNetwork::Frame_Header SocketNetwork::read_frame_header(const char* in)
+{
+    Frame_Header header;
+    header.length = read_u32(in);
+    header.message_type = read_u16(in + 4);
+    header.flags = read_u16(in + 6);
+    header.request_id = read_u32(in + 8);
+    return header;
+}
+
+uint16_t SocketNetwork::to_wire_type(Message_Type type)
+{
+    switch (type)
+    {
+        case Message_Type::AUTHENTICATION: return 1;
+        case Message_Type::REGISTRATION: return 2;
+        case Message_Type::GET_DESTINATIONS: return 3;
+        case Message_Type::GET_OFFERS: return 4;
+        case Message_Type::SEARCH_OFFERS: return 5;
+        case Message_Type::BOOK_OFFER: return 6;
+        case Message_Type::GET_USER_RESERVATIONS: return 7;
+        case Message_Type::CANCEL_RESERVATION: return 8;
+        case Message_Type::GET_USER_INFO: return 9;
+        case Message_Type::UPDATE_USER_INFO: return 10;
+        case Message_Type::KEEPALIVE: return 11;
+        case Message_Type::HELLO: return 12;
+        case Message_Type::GET_SERVER_STATS: return 13;
+        case Message_Type::SUBSCRIBE_OFFERS: return 14;
+        case Message_Type::OFFER_UPDATE: return 15;
+        case Message_Type::RESUME_SESSION: return 16;
+        case Message_Type::LOGOUT: return 17;
+        default: return 0;
+    }
+}
+
+SocketNetwork::Message_Type SocketNetwork::from_wire_type(uint16_t code)
+{
+    switch (code)
+    {
+        case 1: return Message_Type::AUTHENTICATION;
+        case 2: return Message_Type::REGISTRATION;
+        case 3: return Message_Type::GET_DESTINATIONS;
+        case 4: return Message_Type::GET_OFFERS;
+        case 5: return Message_Type::SEARCH_OFFERS;
+        case 6: return Message_Type::BOOK_OFFER;
+        case 7: return Message_Type::GET_USER_RESERVATIONS;
+        case 8: return Message_Type::CANCEL_RESERVATION;
+        case 9: return Message_Type::GET_USER_INFO;
+        case 10: return Message_Type::UPDATE_USER_INFO;
+        case 11: return Message_Type::KEEPALIVE;
+        case 12: return Message_Type::HELLO;
+        case 13: return Message_Type::GET_SERVER_STATS;
+        case 14: return Message_Type::SUBSCRIBE_OFFERS;
+        case 15: return Message_Type::OFFER_UPDATE;
+        case 16: return Message_Type::RESUME_SESSION;
+        case 17: return Message_Type::LOGOUT;
+        default: return Message_Type::UNKNOWN;
+    }
+}
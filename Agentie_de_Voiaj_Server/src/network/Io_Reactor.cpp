@@ -0,0 +1,310 @@
+#include "network/Io_Reactor.h"
+#include "network/Client_Handler.h"
+#include "network/Socket_Server.h"
+#include <chrono>
+#include <ws2tcpip.h>
+
+// ============================================================================
+// Io_Reactor Implementation
+// ============================================================================
+
+SocketNetwork::Io_Reactor::Io_Reactor(Socket_Server* server, int thread_count)
+    : server(server), is_running(false)
+{
+    if (thread_count < 1)
+    {
+        thread_count = 1;
+    }
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        loops.push_back(std::make_unique<Io_Loop>());
+    }
+}
+
+SocketNetwork::Io_Reactor::~Io_Reactor()
+{
+    stop();
+}
+
+bool SocketNetwork::Io_Reactor::start()
+{
+    if (is_running.load())
+    {
+        return true;
+    }
+
+    for (auto& loop : loops)
+    {
+        if (!create_wake_socket(*loop))
+        {
+            Utils::Logger::error("[REACTOR] Failed to create wake-up socket: " +
+                                 Utils::Conversion::int_to_string(WSAGetLastError()));
+            return false;
+        }
+    }
+
+    is_running = true;
+
+    try
+    {
+        for (int i = 0; i < static_cast<int>(loops.size()); i++)
+        {
+            loops[i]->thread = std::thread(&Io_Reactor::run_loop, this, i);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Utils::Logger::error("[REACTOR] Failed to start I/O threads: " + std::string(e.what()));
+        stop();
+        return false;
+    }
+
+    Utils::Logger::info("[REACTOR] Started with " +
+                        Utils::Conversion::int_to_string(static_cast<int>(loops.size())) + " I/O threads");
+    return true;
+}
+
+void SocketNetwork::Io_Reactor::stop()
+{
+    if (!is_running.exchange(false))
+    {
+        return;
+    }
+
+    for (int i = 0; i < static_cast<int>(loops.size()); i++)
+    {
+        wake(i);
+    }
+
+    for (auto& loop : loops)
+    {
+        if (loop->thread.joinable())
+        {
+            loop->thread.join();
+        }
+    }
+
+    Utils::Logger::info("[REACTOR] Stopped");
+}
+
+bool SocketNetwork::Io_Reactor::is_reactor_running() const
+{
+    return is_running.load();
+}
+
+bool SocketNetwork::Io_Reactor::add_client(std::shared_ptr<Client_Handler> client)
+{
+    if (!client || !is_running.load())
+    {
+        return false;
+    }
+
+    // Least loaded loop keeps the poll sets balanced when clients come and go
+    int target = 0;
+    for (int i = 1; i < static_cast<int>(loops.size()); i++)
+    {
+        if (loops[i]->client_count.load() < loops[target]->client_count.load())
+        {
+            target = i;
+        }
+    }
+
+    client->attach_reactor(this, target);
+    client->start_handling();
+
+    Io_Loop& loop = *loops[target];
+    {
+        std::lock_guard<std::mutex> lock(loop.pending_mutex);
+        loop.pending_clients.push_back(std::move(client));
+    }
+    loop.client_count++;
+
+    wake(target);
+    return true;
+}
+
+void SocketNetwork::Io_Reactor::wake(int loop_index)
+{
+    if (loop_index < 0 || loop_index >= static_cast<int>(loops.size()))
+    {
+        return;
+    }
+
+    Io_Loop& loop = *loops[loop_index];
+    if (!loop.wake_pending.exchange(true) && loop.wake_socket.is_valid())
+    {
+        char signal = 1;
+        send(loop.wake_socket, &signal, 1, 0);
+    }
+}
+
+int SocketNetwork::Io_Reactor::get_thread_count() const
+{
+    return static_cast<int>(loops.size());
+}
+
+void SocketNetwork::Io_Reactor::run_loop(int loop_index)
+{
+    Io_Loop& loop = *loops[loop_index];
+
+    WSAPOLLFD wake_fd;
+    wake_fd.fd = loop.wake_socket;
+    wake_fd.events = POLLRDNORM;
+    wake_fd.revents = 0;
+    loop.poll_fds.assign(1, wake_fd);
+
+    while (is_running.load())
+    {
+        adopt_pending_clients(loop);
+
+        // WSAPoll is level-triggered, so interest in writability is only
+        // registered while a client actually has queued output
+        loop.poll_fds[0].revents = 0;
+        for (size_t i = 0; i < loop.clients.size(); i++)
+        {
+            WSAPOLLFD& poll_fd = loop.poll_fds[i + 1];
+            poll_fd.events = POLLRDNORM;
+            if (loop.clients[i]->has_pending_output())
+            {
+                poll_fd.events |= POLLWRNORM;
+            }
+            poll_fd.revents = 0;
+        }
+
+        int ready = WSAPoll(loop.poll_fds.data(), static_cast<ULONG>(loop.poll_fds.size()),
+                            Config::Server::POLL_TIMEOUT_MS);
+        if (ready == SOCKET_ERROR)
+        {
+            Utils::Logger::error("[REACTOR] WSAPoll failed with error: " +
+                                 Utils::Conversion::int_to_string(WSAGetLastError()));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        if (loop.poll_fds[0].revents & POLLRDNORM)
+        {
+            drain_wake_socket(loop);
+        }
+
+        size_t i = 0;
+        while (i < loop.clients.size())
+        {
+            std::shared_ptr<Client_Handler>& client = loop.clients[i];
+            short revents = loop.poll_fds[i + 1].revents;
+            bool keep = client->is_client_running();
+
+            if (keep && (revents & (POLLRDNORM | POLLHUP)))
+            {
+                keep = client->on_readable();
+            }
+            if (keep && (revents & POLLWRNORM))
+            {
+                keep = client->on_writable();
+            }
+            if (keep && (revents & (POLLERR | POLLNVAL)))
+            {
+                keep = false;
+            }
+
+            if (keep)
+            {
+                i++;
+                continue;
+            }
+
+            client->handle_disconnection();
+
+            // Swap-remove, the moved entry keeps its revents and is handled next
+            loop.clients[i] = std::move(loop.clients.back());
+            loop.clients.pop_back();
+            loop.poll_fds[i + 1] = loop.poll_fds.back();
+            loop.poll_fds.pop_back();
+            loop.client_count--;
+        }
+    }
+
+    close_loop_clients(loop);
+}
+
+bool SocketNetwork::Io_Reactor::create_wake_socket(Io_Loop& loop)
+{
+    // Windows has no eventfd/pipe usable with WSAPoll, a UDP socket connected
+    // to itself on loopback serves the same purpose
+    SocketRAII wake_socket(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (!wake_socket.is_valid())
+    {
+        return false;
+    }
+
+    sockaddr_in addr;
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    int addr_len = sizeof(addr);
+    if (bind(wake_socket, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR ||
+        getsockname(wake_socket, (sockaddr*)&addr, &addr_len) == SOCKET_ERROR ||
+        connect(wake_socket, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+    {
+        return false;
+    }
+
+    u_long non_blocking = 1;
+    if (ioctlsocket(wake_socket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        return false;
+    }
+
+    loop.wake_socket = std::move(wake_socket);
+    loop.wake_pending = false;
+    return true;
+}
+
+void SocketNetwork::Io_Reactor::drain_wake_socket(Io_Loop& loop)
+{
+    // Clear the flag first so a wake() racing with the drain is never lost
+    loop.wake_pending = false;
+
+    char buffer[64];
+    while (recv(loop.wake_socket, buffer, sizeof(buffer), 0) > 0)
+    {
+    }
+}
+
+void SocketNetwork::Io_Reactor::adopt_pending_clients(Io_Loop& loop)
+{
+    std::vector<std::shared_ptr<Client_Handler>> adopted;
+    {
+        std::lock_guard<std::mutex> lock(loop.pending_mutex);
+        adopted.swap(loop.pending_clients);
+    }
+
+    for (auto& client : adopted)
+    {
+        WSAPOLLFD poll_fd;
+        poll_fd.fd = client->get_client_info().socket;
+        poll_fd.events = POLLRDNORM;
+        poll_fd.revents = 0;
+
+        loop.poll_fds.push_back(poll_fd);
+        loop.clients.push_back(std::move(client));
+    }
+}
+
+void SocketNetwork::Io_Reactor::close_loop_clients(Io_Loop& loop)
+{
+    adopt_pending_clients(loop);
+
+    for (auto& client : loop.clients)
+    {
+        if (client->is_client_running())
+        {
+            client->handle_disconnection();
+        }
+    }
+
+    loop.clients.clear();
+    loop.poll_fds.clear();
+    loop.client_count = 0;
+}
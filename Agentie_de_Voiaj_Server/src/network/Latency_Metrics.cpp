@@ -0,0 +1,419 @@
+#include "network/Latency_Metrics.h"
+#include "network/Protocol_Handler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+    using SocketNetwork::Latency_Histogram;
+    using SocketNetwork::LATENCY_PHASE_COUNT;
+    using SocketNetwork::MESSAGE_TYPE_COUNT;
+
+    // Written only by the owning thread, so a relaxed load and store replace an atomic add;
+    // the atomics are there for the readers merging concurrently
+    void bump(std::atomic<uint64_t>& counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    struct Phase_Counters
+    {
+        std::atomic<uint64_t> buckets[Latency_Histogram::BUCKET_COUNT] = {};
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> sum_us{ 0 };
+        std::atomic<uint64_t> max_us{ 0 };
+    };
+
+    struct Type_Counters
+    {
+        Phase_Counters phases[LATENCY_PHASE_COUNT];
+    };
+
+    // One per thread that has recorded; message types are allocated on first use
+    struct Thread_Recorder
+    {
+        std::atomic<Type_Counters*> types[MESSAGE_TYPE_COUNT] = {};
+
+        ~Thread_Recorder()
+        {
+            for (auto& type : types)
+            {
+                delete type.load();
+            }
+        }
+
+        void merge_into(SocketNetwork::Latency_Snapshot& snapshot) const
+        {
+            for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++)
+            {
+                const Type_Counters* counters = types[t].load(std::memory_order_acquire);
+                if (!counters)
+                {
+                    continue;
+                }
+                for (size_t p = 0; p < LATENCY_PHASE_COUNT; p++)
+                {
+                    const Phase_Counters& phase = counters->phases[p];
+                    uint64_t count = phase.count.load(std::memory_order_relaxed);
+                    if (count == 0)
+                    {
+                        continue;
+                    }
+                    Latency_Histogram& target = snapshot.histograms[t * LATENCY_PHASE_COUNT + p];
+                    for (size_t b = 0; b < Latency_Histogram::BUCKET_COUNT; b++)
+                    {
+                        uint64_t bucket = phase.buckets[b].load(std::memory_order_relaxed);
+                        if (bucket)
+                        {
+                            target.add_bucket(b, bucket);
+                        }
+                    }
+                    target.add_totals(count, phase.sum_us.load(std::memory_order_relaxed), phase.max_us.load(std::memory_order_relaxed));
+                }
+            }
+        }
+
+        void clear()
+        {
+            for (auto& type : types)
+            {
+                Type_Counters* counters = type.load(std::memory_order_acquire);
+                if (!counters)
+                {
+                    continue;
+                }
+                for (auto& phase : counters->phases)
+                {
+                    for (auto& bucket : phase.buckets)
+                    {
+                        bucket.store(0, std::memory_order_relaxed);
+                    }
+                    phase.count.store(0, std::memory_order_relaxed);
+                    phase.sum_us.store(0, std::memory_order_relaxed);
+                    phase.max_us.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    struct Recorder_Registry
+    {
+        std::mutex mutex;
+        std::vector<Thread_Recorder*> live;
+        SocketNetwork::Latency_Snapshot retired; // Exited threads
+    };
+
+    // Never destroyed, threads may still exit during static destruction
+    Recorder_Registry& registry()
+    {
+        static Recorder_Registry* instance = new Recorder_Registry();
+        return *instance;
+    }
+
+    struct Thread_Slot
+    {
+        Thread_Recorder* recorder = nullptr;
+
+        ~Thread_Slot()
+        {
+            if (!recorder)
+            {
+                return;
+            }
+            Recorder_Registry& owner = registry();
+            std::lock_guard<std::mutex> lock(owner.mutex);
+            recorder->merge_into(owner.retired);
+            owner.live.erase(std::remove(owner.live.begin(), owner.live.end(), recorder), owner.live.end());
+            delete recorder;
+        }
+    };
+
+    thread_local Thread_Slot thread_slot;
+
+    Thread_Recorder& this_thread_recorder()
+    {
+        if (!thread_slot.recorder)
+        {
+            thread_slot.recorder = new Thread_Recorder();
+            Recorder_Registry& owner = registry();
+            std::lock_guard<std::mutex> lock(owner.mutex);
+            owner.live.push_back(thread_slot.recorder);
+        }
+        return *thread_slot.recorder;
+    }
+
+    void write_percentiles(std::ostringstream& out, const Latency_Histogram& histogram)
+    {
+        out << std::setw(10) << histogram.count() << std::setw(10) << histogram.percentile(50.0)
+            << std::setw(10) << histogram.percentile(99.0) << std::setw(10) << histogram.percentile(99.9)
+            << std::setw(10) << histogram.peak();
+    }
+}
+
+// ============================================================================
+// Latency_Histogram Implementation
+// ============================================================================
+
+size_t SocketNetwork::Latency_Histogram::bucket_index(uint64_t micros)
+{
+    micros = (std::min)(micros, MAX_TRACKABLE_US);
+    int highest_bit = 0;
+    for (int step = 16; step > 0; step >>= 1)
+    {
+        if (micros >> (highest_bit + step))
+        {
+            highest_bit += step;
+        }
+    }
+
+    // shift * 32 + top six bits; exact (shift 0) below 64 us
+    int shift = (std::max)(0, highest_bit - SUB_BUCKET_BITS);
+    return static_cast<size_t>(shift) * (1u << SUB_BUCKET_BITS) + static_cast<size_t>(micros >> shift);
+}
+
+uint64_t SocketNetwork::Latency_Histogram::bucket_upper_bound(size_t index)
+{
+    constexpr size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    if (index < 2 * SUB_BUCKETS)
+    {
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t mantissa = index - shift * SUB_BUCKETS;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void SocketNetwork::Latency_Histogram::record(uint64_t micros)
+{
+    add_bucket(bucket_index(micros), 1);
+    add_totals(1, micros, micros);
+}
+
+void SocketNetwork::Latency_Histogram::add_bucket(size_t index, uint64_t count)
+{
+    if (counts.empty())
+    {
+        counts.resize(BUCKET_COUNT, 0);
+    }
+    counts[index] += count;
+}
+
+void SocketNetwork::Latency_Histogram::add_totals(uint64_t count, uint64_t sum, uint64_t peak)
+{
+    total_count += count;
+    sum_us += sum;
+    max_us = (std::max)(max_us, peak);
+}
+
+void SocketNetwork::Latency_Histogram::merge(const Latency_Histogram& other)
+{
+    for (size_t i = 0; i < other.counts.size(); i++)
+    {
+        if (other.counts[i])
+        {
+            add_bucket(i, other.counts[i]);
+        }
+    }
+    add_totals(other.total_count, other.sum_us, other.max_us);
+}
+
+double SocketNetwork::Latency_Histogram::mean() const
+{
+    return total_count ? static_cast<double>(sum_us) / static_cast<double>(total_count) : 0.0;
+}
+
+uint64_t SocketNetwork::Latency_Histogram::percentile(double p) const
+{
+    if (total_count == 0 || counts.empty())
+    {
+        return 0;
+    }
+
+    // Rank of the sample at p, rounded up, among the bucket counts merged so far
+    uint64_t bucketed = 0;
+    for (uint64_t count : counts)
+    {
+        bucketed += count;
+    }
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(bucketed) + 0.999999);
+    rank = std::max<uint64_t>(1, (std::min)(rank, bucketed));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return (std::min)(bucket_upper_bound(i), max_us);
+        }
+    }
+    return max_us;
+}
+
+// ============================================================================
+// Latency_Snapshot Implementation
+// ============================================================================
+
+SocketNetwork::Latency_Histogram& SocketNetwork::Latency_Snapshot::at(Message_Type type, Latency_Phase phase)
+{
+    return histograms[static_cast<size_t>(type) * LATENCY_PHASE_COUNT + static_cast<size_t>(phase)];
+}
+
+const SocketNetwork::Latency_Histogram& SocketNetwork::Latency_Snapshot::at(Message_Type type, Latency_Phase phase) const
+{
+    return histograms[static_cast<size_t>(type) * LATENCY_PHASE_COUNT + static_cast<size_t>(phase)];
+}
+
+uint64_t SocketNetwork::Latency_Snapshot::request_count() const
+{
+    uint64_t count = 0;
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++)
+    {
+        count += at(static_cast<Message_Type>(t), Latency_Phase::TOTAL).count();
+    }
+    return count;
+}
+
+double SocketNetwork::Latency_Snapshot::average_response_time_ms() const
+{
+    uint64_t count = 0;
+    uint64_t sum_us = 0;
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++)
+    {
+        const Latency_Histogram& total = at(static_cast<Message_Type>(t), Latency_Phase::TOTAL);
+        count += total.count();
+        sum_us += total.sum();
+    }
+    return count ? static_cast<double>(sum_us) / static_cast<double>(count) / 1000.0 : 0.0;
+}
+
+// ============================================================================
+// Latency_Metrics Implementation
+// ============================================================================
+
+void SocketNetwork::Latency_Metrics::record(Message_Type type, Latency_Phase phase, std::chrono::steady_clock::duration elapsed)
+{
+    size_t type_index = static_cast<size_t>(type);
+    if (type_index >= MESSAGE_TYPE_COUNT)
+    {
+        return;
+    }
+
+    Thread_Recorder& recorder = this_thread_recorder();
+    Type_Counters* counters = recorder.types[type_index].load(std::memory_order_relaxed);
+    if (!counters)
+    {
+        counters = new Type_Counters();
+        recorder.types[type_index].store(counters, std::memory_order_release);
+    }
+
+    uint64_t micros = static_cast<uint64_t>(std::max<long long>(0,
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    Phase_Counters& counter = counters->phases[static_cast<size_t>(phase)];
+    bump(counter.buckets[Latency_Histogram::bucket_index(micros)], 1);
+    bump(counter.count, 1);
+    bump(counter.sum_us, micros);
+    if (micros > counter.max_us.load(std::memory_order_relaxed))
+    {
+        counter.max_us.store(micros, std::memory_order_relaxed);
+    }
+}
+
+SocketNetwork::Latency_Snapshot SocketNetwork::Latency_Metrics::snapshot()
+{
+    Recorder_Registry& owner = registry();
+    std::lock_guard<std::mutex> lock(owner.mutex);
+
+    Latency_Snapshot result = owner.retired;
+    for (const Thread_Recorder* recorder : owner.live)
+    {
+        recorder->merge_into(result);
+    }
+    return result;
+}
+
+void SocketNetwork::Latency_Metrics::reset()
+{
+    Recorder_Registry& owner = registry();
+    std::lock_guard<std::mutex> lock(owner.mutex);
+
+    owner.retired = Latency_Snapshot();
+    for (Thread_Recorder* recorder : owner.live)
+    {
+        recorder->clear();
+    }
+}
+
+const char* SocketNetwork::Latency_Metrics::phase_name(Latency_Phase phase)
+{
+    switch (phase)
+    {
+        case Latency_Phase::PARSE: return "parse";
+        case Latency_Phase::DATABASE: return "database";
+        case Latency_Phase::SERIALIZE: return "serialize";
+        case Latency_Phase::TOTAL: return "total";
+        default: return "unknown";
+    }
+}
+
+std::string SocketNetwork::Latency_Metrics::format_report(const Latency_Snapshot& snapshot)
+{
+    std::ostringstream out;
+    out << "Request latency (us)" << std::endl;
+    out << std::left << std::setw(24) << "type" << std::setw(11) << "phase" << std::right
+        << std::setw(10) << "count" << std::setw(10) << "p50" << std::setw(10) << "p99"
+        << std::setw(10) << "p999" << std::setw(10) << "max" << std::endl;
+
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++)
+    {
+        Message_Type type = static_cast<Message_Type>(t);
+        if (snapshot.at(type, Latency_Phase::TOTAL).count() == 0)
+        {
+            continue;
+        }
+        for (size_t p = 0; p < LATENCY_PHASE_COUNT; p++)
+        {
+            Latency_Phase phase = static_cast<Latency_Phase>(p);
+            out << std::left << std::setw(24) << (p == 0 ? Protocol_Handler::message_type_to_string(type) : "")
+                << std::setw(11) << phase_name(phase) << std::right;
+            write_percentiles(out, snapshot.at(type, phase));
+            out << std::endl;
+        }
+    }
+    return out.str();
+}
+
+nlohmann::json SocketNetwork::Latency_Metrics::to_json(const Latency_Snapshot& snapshot)
+{
+    nlohmann::json result = nlohmann::json::object();
+    for (size_t t = 0; t < MESSAGE_TYPE_COUNT; t++)
+    {
+        Message_Type type = static_cast<Message_Type>(t);
+        if (snapshot.at(type, Latency_Phase::TOTAL).count() == 0)
+        {
+            continue;
+        }
+
+        nlohmann::json phases = nlohmann::json::object();
+        for (size_t p = 0; p < LATENCY_PHASE_COUNT; p++)
+        {
+            Latency_Phase phase = static_cast<Latency_Phase>(p);
+            const Latency_Histogram& histogram = snapshot.at(type, phase);
+            phases[phase_name(phase)] = {
+                { "count", histogram.count() },
+                { "mean_us", histogram.mean() },
+                { "p50_us", histogram.percentile(50.0) },
+                { "p99_us", histogram.percentile(99.0) },
+                { "p999_us", histogram.percentile(99.9) },
+                { "max_us", histogram.peak() }
+            };
+        }
+        result[Protocol_Handler::message_type_to_string(type)] = phases;
+    }
+    return result;
+}
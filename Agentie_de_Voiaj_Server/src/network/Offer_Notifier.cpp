@@ -0,0 +1,230 @@
+#include "network/Offer_Notifier.h"
+#include "network/Client_Handler.h"
+#include "network/Socket_Server.h"
+#include "network/Frame_Codec.h"
+
+#include <nlohmann/json.hpp>
+
+// ============================================================================
+// Offer_Notifier Implementation
+// ============================================================================
+
+SocketNetwork::Offer_Notifier::Offer_Notifier(Socket_Server* server,
+    std::shared_ptr<Database::Database_Manager> db_manager, std::chrono::milliseconds coalesce_window)
+    : server(server), db_manager(std::move(db_manager)), coalesce_window(coalesce_window)
+{
+}
+
+SocketNetwork::Offer_Notifier::~Offer_Notifier()
+{
+    stop();
+}
+
+bool SocketNetwork::Offer_Notifier::start()
+{
+    if (!db_manager || notifier_thread.joinable())
+    {
+        return notifier_thread.joinable();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        is_stopping = false;
+    }
+
+    try
+    {
+        notifier_thread = std::thread(&Offer_Notifier::run, this);
+    }
+    catch (const std::exception& e)
+    {
+        Utils::Logger::error("Failed to start offer notifier: " + std::string(e.what()));
+        return false;
+    }
+
+    listener_id = db_manager->add_offer_listener([this](int offer_id, Database::Offer_Change change)
+    {
+        on_offer_changed(offer_id, change);
+    });
+    return true;
+}
+
+void SocketNetwork::Offer_Notifier::stop()
+{
+    if (listener_id != 0)
+    {
+        db_manager->remove_offer_listener(listener_id);
+        listener_id = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        is_stopping = true;
+        pending.clear();
+    }
+    pending_condition.notify_all();
+
+    if (notifier_thread.joinable())
+    {
+        notifier_thread.join();
+    }
+}
+
+void SocketNetwork::Offer_Notifier::on_offer_changed(int offer_id, Database::Offer_Change change)
+{
+    // An added offer has no id here, clients see it on their next GET_OFFERS
+    if (offer_id <= 0)
+    {
+        return;
+    }
+
+    changes++;
+    bool is_first = false;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        if (is_stopping)
+        {
+            return;
+        }
+
+        is_first = pending.empty();
+        if (is_first)
+        {
+            first_pending_at = std::chrono::steady_clock::now();
+        }
+
+        // A deletion is final, a later MODIFIED for the same id cannot undo it
+        auto inserted = pending.emplace(offer_id, change);
+        if (!inserted.second && change == Database::Offer_Change::DELETED)
+        {
+            inserted.first->second = change;
+        }
+    }
+
+    if (is_first)
+    {
+        pending_condition.notify_one();
+    }
+}
+
+SocketNetwork::Offer_Notifier::Stats SocketNetwork::Offer_Notifier::get_stats() const
+{
+    Stats stats;
+    stats.changes = changes.load();
+    stats.pushes = pushes.load();
+    stats.offers_pushed = offers_pushed.load();
+    return stats;
+}
+
+std::string SocketNetwork::Offer_Notifier::build_update_message(const std::vector<Offer_Seats>& offers)
+{
+    nlohmann::json data = nlohmann::json::array();
+    for (const auto& offer : offers)
+    {
+        data.push_back({
+            { "offer_id", offer.offer_id },
+            { "available_seats", offer.available_seats },
+            { "status", offer.status }
+        });
+    }
+
+    nlohmann::json message = {
+        { "type", "OFFER_UPDATE" },
+        { "data", std::move(data) }
+    };
+    return message.dump();
+}
+
+void SocketNetwork::Offer_Notifier::run()
+{
+    std::unique_lock<std::mutex> lock(pending_mutex);
+    for (;;)
+    {
+        pending_condition.wait(lock, [this]()
+        {
+            return is_stopping || !pending.empty();
+        });
+        if (is_stopping)
+        {
+            return;
+        }
+
+        // Whatever else changes before the window closes goes out with this batch
+        pending_condition.wait_until(lock, first_pending_at + coalesce_window, [this]()
+        {
+            return is_stopping;
+        });
+        if (is_stopping)
+        {
+            return;
+        }
+
+        std::map<int, Database::Offer_Change> batch;
+        batch.swap(pending);
+        lock.unlock();
+
+        try
+        {
+            publish(batch);
+        }
+        catch (const std::exception& e)
+        {
+            Utils::Logger::error("Offer update push failed: " + std::string(e.what()));
+        }
+
+        lock.lock();
+    }
+}
+
+void SocketNetwork::Offer_Notifier::publish(const std::map<int, Database::Offer_Change>& batch)
+{
+    // Seats are read back after the commit, so the push never shows a rolled back booking
+    std::vector<Offer_Seats> offers;
+    offers.reserve(batch.size());
+    for (const auto& entry : batch)
+    {
+        Offer_Seats seats;
+        seats.offer_id = entry.first;
+        if (entry.second == Database::Offer_Change::DELETED)
+        {
+            seats.status = "deleted";
+            offers.push_back(std::move(seats));
+            continue;
+        }
+
+        auto result = db_manager->execute_prepared("SELECT Total_Seats - Reserved_Seats AS Available_Seats, Status "
+                                                   "FROM Offers WHERE Offer_ID = ?", { entry.first });
+        if (!result.is_success())
+        {
+            Utils::Logger::warning("Offer update skipped for offer " + Utils::Conversion::int_to_string(entry.first) +
+                                   ": " + result.message);
+            continue;
+        }
+
+        if (result.data.empty())
+        {
+            seats.status = "deleted";
+        }
+        else
+        {
+            auto row = result.data[0];
+            seats.available_seats = Utils::Conversion::string_to_int(row["Available_Seats"]);
+            seats.status = row["Status"];
+        }
+        offers.push_back(std::move(seats));
+    }
+
+    if (offers.empty())
+    {
+        return;
+    }
+
+    Frame_Header header;
+    header.message_type = to_wire_type(Message_Type::OFFER_UPDATE);
+    server->broadcast_message(build_update_message(offers), header, [](const Client_Handler& client)
+    {
+        return client.is_offer_subscriber();
+    });
+    pushes++;
+    offers_pushed += offers.size();
+}
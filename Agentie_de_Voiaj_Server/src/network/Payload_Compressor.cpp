@@ -0,0 +1,98 @@
+#include "network/Payload_Compressor.h"
+#include "Offer_Dictionary.h"
+#include "config.h"
+
+#include <zstd.h>
+
+#pragma comment(lib, "zstd.lib")
+
+namespace
+{
+    struct Dictionaries
+    {
+        ZSTD_CDict* compress;
+        ZSTD_DDict* decompress;
+    };
+
+    // Built once and shared by every connection, zstd only reads them
+    const Dictionaries& dictionaries()
+    {
+        static const Dictionaries built = {
+            ZSTD_createCDict(Offer_Dictionary::TEXT, Offer_Dictionary::SIZE, Config::Server::COMPRESSION_LEVEL),
+            ZSTD_createDDict(Offer_Dictionary::TEXT, Offer_Dictionary::SIZE)
+        };
+        return built;
+    }
+}
+
+const char* const SocketNetwork::Payload_Compressor::DICTIONARY_NAME = Offer_Dictionary::NAME.text;
+
+// ============================================================================
+// Payload_Compressor Implementation
+// ============================================================================
+
+SocketNetwork::Payload_Compressor::Payload_Compressor(bool use_dictionary)
+    : context(ZSTD_createCCtx()), use_dictionary(use_dictionary)
+{
+}
+
+SocketNetwork::Payload_Compressor::~Payload_Compressor()
+{
+    ZSTD_freeCCtx(context);
+}
+
+const std::string* SocketNetwork::Payload_Compressor::compress(const char* data, size_t size)
+{
+    if (!context || size < static_cast<size_t>(Config::Server::COMPRESSION_MIN_BYTES))
+    {
+        return nullptr;
+    }
+
+    output.resize(ZSTD_compressBound(size));
+    size_t written = use_dictionary ?
+        ZSTD_compress_usingCDict(context, &output[0], output.size(), data, size, dictionaries().compress) :
+        ZSTD_compressCCtx(context, &output[0], output.size(), data, size, Config::Server::COMPRESSION_LEVEL);
+    if (ZSTD_isError(written) || written >= size)
+    {
+        return nullptr;
+    }
+
+    output.resize(written);
+    return &output;
+}
+
+bool SocketNetwork::Payload_Compressor::decompress(const char* data, size_t size, bool use_dictionary,
+    size_t max_bytes, std::string& out)
+{
+    // The one-shot compressor always records the content size in the frame
+    unsigned long long content_size = ZSTD_getFrameContentSize(data, size);
+    if (content_size == ZSTD_CONTENTSIZE_ERROR || content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size > max_bytes)
+    {
+        return false;
+    }
+
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    if (!context)
+    {
+        return false;
+    }
+
+    out.resize(static_cast<size_t>(content_size));
+    size_t read = use_dictionary ?
+        ZSTD_decompress_usingDDict(context, &out[0], out.size(), data, size, dictionaries().decompress) :
+        ZSTD_decompressDCtx(context, &out[0], out.size(), data, size);
+    ZSTD_freeDCtx(context);
+
+    if (ZSTD_isError(read) || read != out.size())
+    {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+const std::string& SocketNetwork::Payload_Compressor::dictionary()
+{
+    static const std::string text(Offer_Dictionary::TEXT, Offer_Dictionary::SIZE);
+    return text;
+}
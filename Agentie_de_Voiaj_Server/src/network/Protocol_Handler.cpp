@@ -1,5 +1,7 @@
 #include "network/Protocol_Handler.h"
 #include "network/Client_Handler.h"
+#include "network/Socket_Server.h"
+#include "network/Latency_Metrics.h"
 #include <vector>
 #include <map>
 
@@ -13,10 +15,11 @@ SocketNetwork::Protocol_Handler::Protocol_Handler(std::shared_ptr<Database::Data
 {
 }
 
-SocketNetwork::Parsed_Message SocketNetwork::Protocol_Handler::parse_message(const std::string& json_message)
+SocketNetwork::Parsed_Message SocketNetwork::Protocol_Handler::parse_message(const std::string& json_message, SocketNetwork::Message_Type framed_type, uint32_t framed_request_id)
 {
     SocketNetwork::Parsed_Message parsed;
     parsed.raw_message = json_message;
+    parsed.request_id = framed_request_id;
     
     if (json_message.empty())
     {
@@ -28,6 +31,21 @@ SocketNetwork::Parsed_Message SocketNetwork::Protocol_Handler::parse_message(con
     {
         nlohmann::json msg_json = nlohmann::json::parse(json_message);
         parsed.json_data = msg_json;
+        if (parsed.request_id == 0)
+        {
+            parsed.request_id = get_request_id(msg_json);
+        }
+        
+        if (framed_type != Message_Type::UNKNOWN)
+        {
+            parsed.type = framed_type;
+            parsed.is_valid = msg_json.is_object();
+            if (!parsed.is_valid)
+            {
+                parsed.error_message = Config::ErrorMessages::INVALID_REQUEST;
+            }
+            return parsed;
+        }
         
         // Extract command/type from JSON
         if (!msg_json.contains("type") && !msg_json.contains("command"))
@@ -62,6 +80,45 @@ SocketNetwork::Parsed_Message SocketNetwork::Protocol_Handler::parse_message(con
     }
 }
 
+uint32_t SocketNetwork::Protocol_Handler::get_request_id(const nlohmann::json& json_obj)
+{
+    // Optional, sent as a number or a numeric string; 0 means the client does not correlate
+    if (!json_obj.is_object() || !json_obj.contains("request_id"))
+    {
+        return 0;
+    }
+    
+    const auto& value = json_obj["request_id"];
+    if (value.is_number_unsigned())
+    {
+        return static_cast<uint32_t>(value.get<uint64_t>());
+    }
+    if (value.is_string())
+    {
+        try
+        {
+            return static_cast<uint32_t>(std::stoul(value.get<std::string>()));
+        }
+        catch (const std::exception&)
+        {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+long long SocketNetwork::Protocol_Handler::get_known_version(const nlohmann::json& json_obj)
+{
+    // Anything but a number means the client has no usable copy, it gets the full list
+    if (!json_obj.is_object() || !json_obj.contains("known_version"))
+    {
+        return 0;
+    }
+
+    const auto& value = json_obj["known_version"];
+    return value.is_number_integer() ? value.get<long long>() : 0;
+}
+
 SocketNetwork::Message_Type SocketNetwork::Protocol_Handler::get_message_type(const nlohmann::json& json_obj)
 {
     try
@@ -98,6 +155,11 @@ SocketNetwork::Message_Type SocketNetwork::Protocol_Handler::get_message_type(co
         // if (cmd == "ADMIN_GET_USERS") return Message_Type::ADMIN_GET_USERS;
         // if (cmd == "ADMIN_MANAGE_OFFERS") return Message_Type::ADMIN_MANAGE_OFFERS;
         if (cmd == "KEEPALIVE" || cmd == "PING") return Message_Type::KEEPALIVE;
+        if (cmd == "HELLO") return Message_Type::HELLO;
+        if (cmd == "GET_SERVER_STATS") return Message_Type::GET_SERVER_STATS;
+        if (cmd == "SUBSCRIBE_OFFERS") return Message_Type::SUBSCRIBE_OFFERS;
+        if (cmd == "RESUME_SESSION") return Message_Type::RESUME_SESSION;
+        if (cmd == "LOGOUT" || cmd == "END_SESSION") return Message_Type::LOGOUT;
         if (cmd == "ERROR") return Message_Type::ERR;
         
         return Message_Type::UNKNOWN;
@@ -127,6 +189,12 @@ std::string SocketNetwork::Protocol_Handler::message_type_to_string(SocketNetwor
         // case Message_Type::ADMIN_GET_USERS: return "ADMIN_GET_USERS"; 
         // case Message_Type::ADMIN_MANAGE_OFFERS: return "ADMIN_MANAGE_OFFERS";
         case Message_Type::KEEPALIVE: return "KEEPALIVE";
+        case Message_Type::HELLO: return "HELLO";
+        case Message_Type::GET_SERVER_STATS: return "GET_SERVER_STATS";
+        case Message_Type::SUBSCRIBE_OFFERS: return "SUBSCRIBE_OFFERS";
+        case Message_Type::OFFER_UPDATE: return "OFFER_UPDATE";
+        case Message_Type::RESUME_SESSION: return "RESUME_SESSION";
+        case Message_Type::LOGOUT: return "LOGOUT";
         case Message_Type::ERR: return "ERROR";
         case Message_Type::UNKNOWN: return "UNKNOWN";
         default: return "UNKNOWN";
@@ -177,6 +245,21 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::process_message(const S
             case Message_Type::KEEPALIVE:
                 return handle_keepalive(parsed_message, client_handler);
             
+            case Message_Type::HELLO:
+                return handle_hello(parsed_message, client_handler);
+            
+            case Message_Type::GET_SERVER_STATS:
+                return handle_get_server_stats(parsed_message, client_handler);
+            
+            case Message_Type::SUBSCRIBE_OFFERS:
+                return handle_subscribe_offers(parsed_message, client_handler);
+            
+            case Message_Type::RESUME_SESSION:
+                return handle_resume_session(parsed_message, client_handler);
+            
+            case Message_Type::LOGOUT:
+                return handle_logout(parsed_message, client_handler);
+            
             // Admin functions not implemented for college project scope
             // case Message_Type::ADMIN_GET_STATS:
             //     return handle_admin_get_stats(parsed_message, client_handler);
@@ -272,13 +355,20 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_authentication(c
             
             Utils::Logger::info("Authentication SUCCESS: User '" + username + "' (ID:" + std::to_string(user_id) + ") logged in from " + client->get_client_info().ip_address);
             
-            nlohmann::json user_data;
-            for (const auto& pair : result.data[0])
+            // The token lets the next connection skip this lookup, see handle_resume_session()
+            nlohmann::json user = nlohmann::json::parse(row_to_json(result.data[0]));
+            if (Socket_Server* server = client->get_server())
             {
-                user_data[pair.first] = pair.second;
+                std::string token = server->get_session_store().create(user_id, username);
+                if (!token.empty())
+                {
+                    user["session_token"] = token;
+                }
             }
             
-            return Response(true, Config::SuccessMessages::LOGIN_SUCCESS, user_data.dump());
+            Response response(true, Config::SuccessMessages::LOGIN_SUCCESS, user.dump());
+            response.data_is_json = true;
+            return response;
         }
         else 
         {
@@ -353,6 +443,43 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_destinations
     
     try 
     {
+        // A client sending the version it holds gets either "not modified" or the list with its version
+        if (!db_manager->is_running_in_demo_mode() && message.json_data.contains("known_version"))
+        {
+            const long long version = db_manager->get_destinations_version();
+            std::string json = "{\"version\":" + std::to_string(version);
+            if (get_known_version(message.json_data) == version)
+            {
+                json += ",\"not_modified\":true}";
+            }
+            else
+            {
+                // Read after the version: an edit in between is fetched again next time, never missed
+                auto result = db_manager->get_all_destinations();
+                if (!result.is_success())
+                {
+                    return Response(false, result.message);
+                }
+
+                json += ",\"destinations\":[";
+                bool is_first = true;
+                for (const auto& row : result.data)
+                {
+                    if (!is_first)
+                    {
+                        json += ',';
+                    }
+                    json += row_to_json(row);
+                    is_first = false;
+                }
+                json += "]}";
+            }
+
+            Response response(true, Config::SuccessMessages::DATA_RETRIEVED, json);
+            response.data_is_json = true;
+            return response;
+        }
+
         // Check if we're in demo mode and use mock data
         auto result = db_manager->is_running_in_demo_mode() ? 
             db_manager->create_mock_response("get_destinations") : 
@@ -360,11 +487,10 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_destinations
         
         if (result.is_success())
         {
-            std::string destinations_json = vector_to_json(result.data);
             std::string message = db_manager->is_running_in_demo_mode() ? 
                 "Demo destinations retrieved successfully" : 
                 Config::SuccessMessages::DATA_RETRIEVED;
-            return Response(true, message, destinations_json);
+            return rows_response(message, std::move(result.data));
         }
         else 
         {
@@ -386,6 +512,26 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_offers(const
     
     try 
     {
+        // Served from memory, the catalog only goes to the database when offers changed
+        auto catalog = db_manager->is_running_in_demo_mode() ? nullptr : db_manager->get_offer_catalog();
+        if (catalog)
+        {
+            auto snapshot = catalog->get_snapshot();
+
+            // Clients sending the version they hold get "not modified" or the rows changed since
+            if (message.json_data.contains("known_version"))
+            {
+                Response response(true, Config::SuccessMessages::DATA_RETRIEVED,
+                    Database::Offer_Catalog::build_changes_since(*snapshot, get_known_version(message.json_data)));
+                response.data_is_json = true;
+                return response;
+            }
+
+            Response response(true, Config::SuccessMessages::DATA_RETRIEVED, snapshot->offers_json);
+            response.data_is_json = true;
+            return response;
+        }
+
         // Check if we're in demo mode and use mock data
         auto result = db_manager->is_running_in_demo_mode() ? 
             db_manager->create_mock_response("get_offers") : 
@@ -393,11 +539,10 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_offers(const
         
         if (result.is_success())
         {
-            std::string offers_json = vector_to_json(result.data);
             std::string message = db_manager->is_running_in_demo_mode() ? 
                 "Demo offers retrieved successfully" : 
                 Config::SuccessMessages::DATA_RETRIEVED;
-            return Response(true, message, offers_json);
+            return rows_response(message, std::move(result.data));
         }
         else 
         {
@@ -425,12 +570,31 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_search_offers(co
         std::string start_date = message.json_data.contains("start_date") ? message.json_data["start_date"].get<std::string>() : "";
         std::string end_date = message.json_data.contains("end_date") ? message.json_data["end_date"].get<std::string>() : "";
         
+        // Answered from the catalog's in-memory indexes, LIKE wildcards in the destination still go to SQL
+        Database::Offer_Search_Criteria criteria;
+        criteria.destination = destination;
+        criteria.min_price = min_price;
+        criteria.max_price = max_price;
+        criteria.start_date = start_date;
+        criteria.end_date = end_date;
+        auto catalog = db_manager->is_running_in_demo_mode() ? nullptr : db_manager->get_offer_catalog();
+        if (catalog && Database::Offer_Index::can_answer(criteria))
+        {
+            auto validation = Database::Database_Manager::validate_search_criteria(criteria);
+            if (!validation.is_success())
+            {
+                return Response(false, validation.message);
+            }
+            Response response(true, Config::SuccessMessages::DATA_RETRIEVED, catalog->search(criteria));
+            response.data_is_json = true;
+            return response;
+        }
+        
         auto result = db_manager->search_offers(destination, min_price, max_price, start_date, end_date);
         
         if (result.is_success())
         {
-            std::string offers_json = vector_to_json(result.data);
-            return Response(true, Config::SuccessMessages::DATA_RETRIEVED, offers_json);
+            return rows_response(Config::SuccessMessages::DATA_RETRIEVED, std::move(result.data));
         }
         else 
         {
@@ -470,12 +634,39 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_book_offer(const
         {
             return Response(false, "Invalid person count");
         }
+
+        // Optional traveler details, one entry per person: [{"full_name","cnp","birth_date","person_type"}]
+        std::vector<Reservation_Person_Data> persons;
+        if (message.json_data.contains("persons") && message.json_data["persons"].is_array())
+        {
+            for (const auto& entry : message.json_data["persons"])
+            {
+                Reservation_Person_Data person;
+                person.full_name = entry.value("full_name", "");
+                person.cnp = entry.value("cnp", "");
+                person.birth_date = entry.value("birth_date", "");
+                person.person_type = entry.value("person_type", "adult");
+                if (person.full_name.empty() || !Utils::Validation::is_valid_cnp(person.cnp) ||
+                    !Utils::DateTime::is_valid_date(person.birth_date))
+                {
+                    return Response(false, "Invalid traveler details");
+                }
+                persons.push_back(std::move(person));
+            }
+        }
         
-        auto result = db_manager->book_offer(client->get_client_info().user_id, offer_id, person_count);
+        auto result = db_manager->book_offer(client->get_user_id(), offer_id, person_count, persons);
         
         if (result.is_success())
         {
-            return Response(true, Config::SuccessMessages::RESERVATION_CREATED);
+            nlohmann::json data = nlohmann::json::object();
+            if (result.has_data())
+            {
+                data["reservation_id"] = Utils::Conversion::string_to_int(result.data[0]["Reservation_ID"]);
+            }
+            Response response(true, Config::SuccessMessages::RESERVATION_CREATED, data.dump());
+            response.data_is_json = true;
+            return response;
         }
         else 
         {
@@ -502,12 +693,11 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_user_reserva
     
     try 
     {
-        auto result = db_manager->get_user_reservations(client->get_client_info().user_id);
+        auto result = db_manager->get_user_reservations(client->get_user_id());
         
         if (result.is_success())
         {
-            std::string reservations_json = vector_to_json(result.data);
-            return Response(true, Config::SuccessMessages::DATA_RETRIEVED, reservations_json);
+            return rows_response(Config::SuccessMessages::DATA_RETRIEVED, std::move(result.data));
         }
         else 
         {
@@ -572,16 +762,13 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_user_info(co
     
     try 
     {
-        auto result = db_manager->get_user_by_id(client->get_client_info().user_id);
+        auto result = db_manager->get_user_by_id(client->get_user_id());
         
         if (result.is_success() && result.has_data())
         {
-            nlohmann::json user_data;
-            for (const auto& pair : result.data[0])
-            {
-                user_data[pair.first] = pair.second;
-            }
-            return Response(true, Config::SuccessMessages::DATA_RETRIEVED, user_data.dump());
+            Response response(true, Config::SuccessMessages::DATA_RETRIEVED, row_to_json(result.data[0]));
+            response.data_is_json = true;
+            return response;
         }
         else 
         {
@@ -609,14 +796,14 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_update_user_info
     try 
     {
         // Get current user data
-        auto current_result = db_manager->get_user_by_id(client->get_client_info().user_id);
+        auto current_result = db_manager->get_user_by_id(client->get_user_id());
         if (!current_result.is_success() || !current_result.has_data())
         {
             return Response(false, Config::ErrorMessages::USER_NOT_FOUND);
         }
         
         User_Data user_data;
-        user_data.id = client->get_client_info().user_id;
+        user_data.id = client->get_user_id();
         user_data.username = current_result.data[0]["Username"];
         user_data.password_hash = current_result.data[0]["Password_Hash"];
         
@@ -652,29 +839,164 @@ SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_keepalive(const
     return Response(true, "PONG");
 }
 
-bool SocketNetwork::Protocol_Handler::is_user_admin(int /*user_id*/)
+SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_hello(const SocketNetwork::Parsed_Message& message, SocketNetwork::Client_Handler* client)
 {
-    // Not implemented in college project scope - all users are regular clients
-    return false;
+    // {"type":"HELLO","framing":"binary"} - the reply is sent in the current framing,
+    // both sides switch right after it. Unknown or disabled modes keep text lines,
+    // and a connection never switches back once it is binary.
+    std::string requested = message.json_data.contains("framing") && message.json_data["framing"].is_string() ?
+        Utils::String::to_lower(message.json_data["framing"].get<std::string>()) : "text";
+    bool use_binary = client->get_framing() == Framing_Mode::BINARY;
+    
+    if (!use_binary && requested == "binary" && Config::Server::ENABLE_BINARY_FRAMING)
+    {
+        client->request_framing(Framing_Mode::BINARY);
+        use_binary = true;
+    }
+    
+    // {"compression":"zstd","dictionary":"offers-1"} - binary frames only; the dictionary
+    // is used when the client names the one this server has
+    std::string compression = "none";
+    bool use_dictionary = false;
+    if (use_binary && Config::Server::ENABLE_COMPRESSION && message.json_data.contains("compression") &&
+        message.json_data["compression"].is_string() &&
+        Utils::String::to_lower(message.json_data["compression"].get<std::string>()) == "zstd")
+    {
+        use_dictionary = message.json_data.contains("dictionary") && message.json_data["dictionary"].is_string() &&
+            message.json_data["dictionary"].get<std::string>() == Payload_Compressor::DICTIONARY_NAME;
+        client->request_compression(use_dictionary);
+        compression = "zstd";
+    }
+    
+    nlohmann::json data;
+    data["framing"] = use_binary ? "binary" : "text";
+    data["compression"] = compression;
+    if (use_dictionary)
+    {
+        data["dictionary"] = Payload_Compressor::DICTIONARY_NAME;
+    }
+    data["max_request_bytes"] = std::to_string(Config::JSON::MAX_JSON_SIZE);
+    data["server_version"] = Config::Application::VERSION;
+    Response response(true, "HELLO", data.dump());
+    response.data_is_json = true;
+    return response;
 }
 
-std::string SocketNetwork::Protocol_Handler::vector_to_json(const std::vector<std::map<std::string, std::string>>& data)
+SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_get_server_stats(const SocketNetwork::Parsed_Message& /*message*/, SocketNetwork::Client_Handler* client)
 {
-    if (data.empty())
+    // Operator request: there are no admin accounts, so it is limited to this machine
+    const std::string& address = client->get_client_info().ip_address;
+    bool is_loopback = address == "127.0.0.1" || address == "::1" || address.rfind("127.", 0) == 0;
+    if (!Config::Server::ENABLE_SERVER_STATS_REQUEST || (Config::Server::SERVER_STATS_LOOPBACK_ONLY && !is_loopback))
     {
-        return "[]";
+        return Response(false, "Unsupported message type");
     }
     
-    nlohmann::json json_array = nlohmann::json::array();
-    for (const auto& row : data)
+    Latency_Snapshot latencies = Latency_Metrics::snapshot();
+    nlohmann::json data;
+    if (Socket_Server* server = client->get_server())
+    {
+        Server_Stats stats = server->get_server_stats();
+        data["server"] = {
+            { "active_clients", stats.active_clients },
+            { "total_connections", stats.total_connections },
+            { "total_messages_received", stats.total_messages_received },
+            { "total_messages_sent", stats.total_messages_sent },
+            { "uptime", stats.uptime },
+            { "start_time", stats.start_time },
+            { "average_response_time_ms", stats.average_response_time_ms },
+            { "memory_usage_mb", stats.memory_usage_mb },
+            { "statement_cache_hit_rate", stats.statement_cache_hit_rate },
+            { "bookings_refused_in_memory", stats.bookings_refused_in_memory }
+        };
+    }
+    data["latency"] = Latency_Metrics::to_json(latencies);
+    
+    Response response(true, Config::SuccessMessages::DATA_RETRIEVED, data.dump());
+    response.data_is_json = true;
+    return response;
+}
+
+SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_subscribe_offers(const SocketNetwork::Parsed_Message& message, SocketNetwork::Client_Handler* client)
+{
+    // {"type":"SUBSCRIBE_OFFERS","subscribe":false} stops the pushes; the catalog is public, no login needed
+    if (!Config::Server::ENABLE_OFFER_PUSH)
     {
-        nlohmann::json json_obj;
-        for (const auto& pair : row)
-        {
-            json_obj[pair.first] = pair.second;
-        }
-        json_array.push_back(json_obj);
+        return Response(false, "Unsupported message type");
+    }
+    
+    bool is_subscribed = true;
+    if (message.json_data.contains("subscribe") && message.json_data["subscribe"].is_boolean())
+    {
+        is_subscribed = message.json_data["subscribe"].get<bool>();
     }
+    client->set_offer_subscription(is_subscribed);
     
-    return json_array.dump();
+    nlohmann::json data = { { "subscribed", is_subscribed } };
+    Response response(true, is_subscribed ? "Subscribed to offer updates" : "Unsubscribed from offer updates", data.dump());
+    response.data_is_json = true;
+    return response;
+}
+
+SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_resume_session(const SocketNetwork::Parsed_Message& message, SocketNetwork::Client_Handler* client)
+{
+    // {"type":"RESUME_SESSION","token":"..."} with the session_token from AUTH; no database access
+    if (!message.json_data.contains("token") || !message.json_data["token"].is_string())
+    {
+        return Response(false, "Missing required field: token");
+    }
+    
+    Socket_Server* server = client->get_server();
+    Session session;
+    if (!server || !server->get_session_store().resume(message.json_data["token"].get<std::string>(), session))
+    {
+        return Response(false, "Invalid or expired session");
+    }
+    
+    client->set_authenticated(session.user_id, session.username);
+    Utils::Logger::info("Session resumed: User '" + session.username + "' (ID:" + std::to_string(session.user_id) + ") from " + client->get_client_info().ip_address);
+    
+    nlohmann::json data = { { "ID", session.user_id }, { "Username", session.username } };
+    Response response(true, "Session resumed", data.dump());
+    response.data_is_json = true;
+    return response;
+}
+
+SocketNetwork::Response SocketNetwork::Protocol_Handler::handle_logout(const SocketNetwork::Parsed_Message& message, SocketNetwork::Client_Handler* client)
+{
+    // {"type":"LOGOUT","token":"..."} - the token can no longer be resumed, from any connection
+    Socket_Server* server = client->get_server();
+    if (server && message.json_data.contains("token") && message.json_data["token"].is_string())
+    {
+        server->get_session_store().revoke(message.json_data["token"].get<std::string>());
+    }
+    
+    if (client->is_authenticated())
+    {
+        Utils::Logger::info("User ID " + std::to_string(client->get_user_id()) + " logged out from " + client->get_client_info().ip_address);
+        client->clear_authentication();
+    }
+    return Response(true, "Logged out");
+}
+
+bool SocketNetwork::Protocol_Handler::is_user_admin(int /*user_id*/)
+{
+    // Not implemented in college project scope - all users are regular clients
+    return false;
+}
+
+SocketNetwork::Response SocketNetwork::Protocol_Handler::rows_response(const std::string& message, Database::Result_Set&& rows)
+{
+    // Serialized by the connection's Response_Writer straight from the columns
+    Response response(true, message);
+    response.rows = std::make_shared<const Database::Result_Set>(std::move(rows));
+    return response;
+}
+
+std::string SocketNetwork::Protocol_Handler::row_to_json(const Database::Result_Set::Row_View& row)
+{
+    // Values stay strings (NULL as ""), the client parses every field from text
+    std::string json;
+    row.append_json(json);
+    return json;
 }
\ No newline at end of file
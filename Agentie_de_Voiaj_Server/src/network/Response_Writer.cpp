@@ -0,0 +1,87 @@
+#include "network/Response_Writer.h"
+#include "database/Result_Set.h"
+
+// ============================================================================
+// Response_Writer Implementation
+// ============================================================================
+
+const std::string& SocketNetwork::Response_Writer::write(const Response& response, Framing_Mode mode, const Frame_Header& header)
+{
+    if (buffer.capacity() > RETAINED_CAPACITY)
+    {
+        std::string().swap(buffer);
+    }
+    buffer.clear();
+
+    // The header's length is only known once the body is written, reserve its bytes first
+    if (mode == Framing_Mode::BINARY)
+    {
+        buffer.append(FRAME_HEADER_SIZE, '\0');
+    }
+
+    append_body(buffer, response);
+
+    if (mode == Framing_Mode::BINARY)
+    {
+        Frame_Header wire_header = header;
+        wire_header.length = static_cast<uint32_t>(buffer.size() - FRAME_HEADER_SIZE);
+        write_frame_header(&buffer[0], wire_header);
+    }
+    else
+    {
+        buffer += "\r\n";
+    }
+    return buffer;
+}
+
+void SocketNetwork::Response_Writer::append_body(std::string& out, const Response& response)
+{
+    // Keys in sorted order: data, error_code, message, request_id, success
+    out += '{';
+    if (response.success)
+    {
+        out += "\"data\":";
+        if (response.rows)
+        {
+            response.rows->append_json(out);
+        }
+        else if (response.data.empty())
+        {
+            out += "{}";
+        }
+        else if (response.data_is_json)
+        {
+            out += response.data;
+        }
+        else
+        {
+            // Free-form data: JSON text is embedded as is, anything else as a string
+            try
+            {
+                out += nlohmann::json::parse(response.data).dump();
+            }
+            catch (const nlohmann::json::parse_error&)
+            {
+                Utils::JSON::append_json_string(out, response.data);
+            }
+        }
+        out += ',';
+    }
+    else if (response.error_code != -1)
+    {
+        out += "\"error_code\":";
+        out += std::to_string(response.error_code);
+        out += ',';
+    }
+
+    out += "\"message\":";
+    Utils::JSON::append_json_string(out, response.success && response.message.empty() ? "Success" : response.message);
+
+    if (response.request_id != 0)
+    {
+        out += ",\"request_id\":";
+        out += std::to_string(response.request_id);
+    }
+
+    out += response.success ? ",\"success\":true}" : ",\"success\":false}";
+}
@@ -0,0 +1,139 @@
+#include "network/Send_Queue.h"
+#include "config.h"
+
+#include <algorithm>
+
+// ============================================================================
+// Send_Queue Implementation
+// ============================================================================
+
+void SocketNetwork::Send_Queue::push_frame(Framing_Mode mode, const Frame_Header& header, const Shared_Buffer& payload)
+{
+    if (mode == Framing_Mode::BINARY)
+    {
+        Frame_Header wire_header = header;
+        wire_header.length = static_cast<uint32_t>(payload->size());
+
+        char header_bytes[FRAME_HEADER_SIZE];
+        write_frame_header(header_bytes, wire_header);
+        push_owned(header_bytes, FRAME_HEADER_SIZE);
+    }
+
+    if (payload->size() <= static_cast<size_t>(Config::Server::SEND_COALESCE_BYTES))
+    {
+        push_owned(payload->data(), payload->size());
+    }
+    else
+    {
+        Segment segment;
+        segment.shared = payload;
+        segments.push_back(std::move(segment));
+        queued_bytes += payload->size();
+    }
+
+    if (mode == Framing_Mode::TEXT_LINES)
+    {
+        push_owned("\r\n", 2);
+    }
+}
+
+void SocketNetwork::Send_Queue::push_copy(const char* data, size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (size <= static_cast<size_t>(Config::Server::SEND_COALESCE_BYTES))
+    {
+        push_owned(data, size);
+        return;
+    }
+
+    Segment segment;
+    segment.owned.assign(data, size);
+    segments.push_back(std::move(segment));
+    queued_bytes += size;
+}
+
+SocketNetwork::Send_Queue::Flush_Result SocketNetwork::Send_Queue::flush(SOCKET socket)
+{
+    WSABUF buffers[Config::Server::MAX_SEND_SEGMENTS];
+
+    while (!segments.empty())
+    {
+        DWORD count = 0;
+        for (auto it = segments.begin(); it != segments.end() && count < Config::Server::MAX_SEND_SEGMENTS; ++it, ++count)
+        {
+            const std::string& bytes = it->bytes();
+            buffers[count].buf = const_cast<char*>(bytes.data()) + it->offset;
+            buffers[count].len = static_cast<ULONG>(bytes.size() - it->offset);
+        }
+
+        DWORD bytes_sent = 0;
+        if (WSASend(socket, buffers, count, &bytes_sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            int error = WSAGetLastError();
+            if (error == WSAEWOULDBLOCK)
+            {
+                return Flush_Result::WOULD_BLOCK;
+            }
+            if (error != WSAEINTR)
+            {
+                return Flush_Result::FAILED;
+            }
+            continue;
+        }
+
+        consume(bytes_sent);
+    }
+
+    return Flush_Result::DONE;
+}
+
+void SocketNetwork::Send_Queue::clear()
+{
+    segments.clear();
+    queued_bytes = 0;
+}
+
+void SocketNetwork::Send_Queue::push_owned(const char* data, size_t size)
+{
+    if (size == 0)
+    {
+        return; // An empty segment would never be consumed
+    }
+
+    // Appended to the tail while it is a small owned segment, its sent prefix is left alone
+    if (!segments.empty())
+    {
+        Segment& tail = segments.back();
+        if (!tail.shared && tail.owned.size() + size <= static_cast<size_t>(Config::Server::SEND_COALESCE_BYTES))
+        {
+            tail.owned.append(data, size);
+            queued_bytes += size;
+            return;
+        }
+    }
+
+    Segment segment;
+    segment.owned.assign(data, size);
+    segments.push_back(std::move(segment));
+    queued_bytes += size;
+}
+
+void SocketNetwork::Send_Queue::consume(size_t bytes)
+{
+    queued_bytes -= (std::min)(bytes, queued_bytes);
+    while (bytes > 0 && !segments.empty())
+    {
+        Segment& front = segments.front();
+        size_t remaining = front.bytes().size() - front.offset;
+        if (bytes < remaining)
+        {
+            front.offset += bytes;
+            return;
+        }
+        bytes -= remaining;
+        segments.pop_front();
+    }
+}
@@ -0,0 +1,107 @@
+#include "network/Session_Store.h"
+#include "utils/utils.h"
+
+#include <algorithm>
+#include <functional>
+
+// ============================================================================
+// Session_Store Implementation
+// ============================================================================
+
+SocketNetwork::Session_Store::Session_Store(std::chrono::milliseconds ttl, size_t shard_count,
+    std::chrono::milliseconds max_lifetime)
+    : ttl(ttl), max_lifetime(max_lifetime)
+{
+    shard_count = std::max<size_t>(1, shard_count);
+    for (size_t i = 0; i < shard_count; i++)
+    {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::string SocketNetwork::Session_Store::create(int user_id, const std::string& username)
+{
+    std::string token = Utils::Crypto::generate_session_token();
+    if (token.empty())
+    {
+        return token;
+    }
+
+    Session session;
+    session.user_id = user_id;
+    session.username = username;
+    auto now = std::chrono::steady_clock::now();
+    session.ends_at = now + max_lifetime;
+    session.expires_at = (std::min)(now + ttl, session.ends_at);
+
+    Shard& shard = shard_for(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (++shard.creates_since_sweep >= Config::Security::SESSION_SWEEP_EVERY)
+    {
+        sweep(shard, now);
+    }
+    if (shard.sessions.emplace(token, std::move(session)).second)
+    {
+        session_count++;
+    }
+    return token;
+}
+
+bool SocketNetwork::Session_Store::resume(const std::string& token, Session& session)
+{
+    if (token.empty())
+    {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    Shard& shard = shard_for(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(token);
+    if (it == shard.sessions.end())
+    {
+        return false;
+    }
+    if (now >= it->second.expires_at)
+    {
+        shard.sessions.erase(it);
+        session_count--;
+        return false;
+    }
+
+    it->second.expires_at = (std::min)(now + ttl, it->second.ends_at);
+    session = it->second;
+    return true;
+}
+
+void SocketNetwork::Session_Store::revoke(const std::string& token)
+{
+    Shard& shard = shard_for(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.sessions.erase(token) > 0)
+    {
+        session_count--;
+    }
+}
+
+SocketNetwork::Session_Store::Shard& SocketNetwork::Session_Store::shard_for(const std::string& token) const
+{
+    return *shards[std::hash<std::string>()(token) % shards.size()];
+}
+
+void SocketNetwork::Session_Store::sweep(Shard& shard, std::chrono::steady_clock::time_point now)
+{
+    shard.creates_since_sweep = 0;
+    for (auto it = shard.sessions.begin(); it != shard.sessions.end();)
+    {
+        if (now >= it->second.expires_at)
+        {
+            it = shard.sessions.erase(it);
+            session_count--;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
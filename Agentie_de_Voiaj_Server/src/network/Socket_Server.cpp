@@ -1,6 +1,10 @@
 #include "network/Socket_Server.h"
 #include "network/Client_Handler.h"
 #include "network/Protocol_Handler.h"
+#include "network/Io_Reactor.h"
+#include "network/Latency_Metrics.h"
+#include "network/Worker_Pool.h"
+#include "network/Offer_Notifier.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -14,7 +18,7 @@
 
 SocketNetwork::Socket_Server::Socket_Server()
     : server_socket(), is_running(false), is_initialized(false),
-      client_count(0), total_connections(0), total_messages_received(0), total_messages_sent(0)
+      total_connections(0), total_messages_received(0), total_messages_sent(0)
 {
     server_start_time = Utils::DateTime::get_current_date_time();
     Utils::Logger::info("Socket_Server created with default configuration");
@@ -22,7 +26,7 @@ SocketNetwork::Socket_Server::Socket_Server()
 
 SocketNetwork::Socket_Server::Socket_Server(const Server_Config& config)
     : server_socket(), config(config), is_running(false), is_initialized(false),
-      client_count(0), total_connections(0), total_messages_received(0), total_messages_sent(0)
+      total_connections(0), total_messages_received(0), total_messages_sent(0)
 {
     server_start_time = Utils::DateTime::get_current_date_time();
     Utils::Logger::info("Socket_Server created with custom configuration - Port: " + 
@@ -31,7 +35,7 @@ SocketNetwork::Socket_Server::Socket_Server(const Server_Config& config)
 
 SocketNetwork::Socket_Server::Socket_Server(const std::string& ip, int port)
     : server_socket(), is_running(false), is_initialized(false),
-      client_count(0), total_connections(0), total_messages_received(0), total_messages_sent(0)
+      total_connections(0), total_messages_received(0), total_messages_sent(0)
 {
     config.ip_address = ip;
     config.port = port;
@@ -108,6 +112,39 @@ bool SocketNetwork::Socket_Server::start()
 
     try 
     {
+        if (config.worker_thread_count > 0)
+        {
+            Worker_Pool::Options pool_options;
+            pool_options.thread_count = config.worker_thread_count;
+            worker_pool = std::make_unique<Worker_Pool>(pool_options);
+            if (!worker_pool->start())
+            {
+                log_server_event("Failed to start worker pool");
+                worker_pool.reset();
+                return false;
+            }
+        }
+        
+        if (Config::Server::ENABLE_OFFER_PUSH && db_manager)
+        {
+            offer_notifier = std::make_unique<Offer_Notifier>(this, db_manager);
+            if (!offer_notifier->start())
+            {
+                log_server_event("Failed to start offer notifier, seat changes will not be pushed");
+                offer_notifier.reset();
+            }
+        }
+        
+        if (config.io_mode == Io_Mode::REACTOR)
+        {
+            io_reactor = std::make_unique<Io_Reactor>(this, config.io_thread_count);
+            if (!io_reactor->start())
+            {
+                log_server_event("Failed to start I/O reactor");
+                return false;
+            }
+        }
+        
         is_running = true;
         
         // Start accept thread
@@ -116,9 +153,17 @@ bool SocketNetwork::Socket_Server::start()
         // Start cleanup thread
         cleanup_thread = std::thread([this]() 
         {
+            auto last_latency_report = std::chrono::steady_clock::now();
             while (is_running.load())
             {
                 cleanup_disconnected_clients();
+                
+                if (Config::Server::LATENCY_REPORT_INTERVAL_SECONDS > 0 &&
+                    std::chrono::steady_clock::now() - last_latency_report >= std::chrono::seconds(Config::Server::LATENCY_REPORT_INTERVAL_SECONDS))
+                {
+                    log_latency_report();
+                    last_latency_report = std::chrono::steady_clock::now();
+                }
                 std::this_thread::sleep_for(std::chrono::seconds(5));
             }
         });
@@ -156,6 +201,23 @@ void SocketNetwork::Socket_Server::stop()
         accept_thread.join();
     }
     
+    if (io_reactor)
+    {
+        io_reactor->stop();
+    }
+    
+    // After the I/O threads, nothing submits any more; queued requests are dropped
+    if (worker_pool)
+    {
+        worker_pool->stop();
+    }
+    
+    // Its listener is only called from requests, all of which have finished by now
+    if (offer_notifier)
+    {
+        offer_notifier->stop();
+    }
+    
     if (cleanup_thread.joinable())
     {
         cleanup_thread.join();
@@ -211,19 +273,18 @@ bool SocketNetwork::Socket_Server::is_server_initialized() const
 
 int SocketNetwork::Socket_Server::get_active_client_count() const
 {
-    return client_count.load();
+    return client_registry.size();
 }
 
 std::vector<SocketNetwork::Client_Info> SocketNetwork::Socket_Server::get_active_clients() const
 {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(clients_mutex));
     std::vector<Client_Info> clients;
     
-    for (const auto& pair : active_clients)
+    for (const auto& client : client_registry.snapshot())
     {
-        if (pair.second)
+        if (client)
         {
-            clients.push_back(pair.second->get_client_info());
+            clients.push_back(client->get_client_snapshot());
         }
     }
     
@@ -232,46 +293,45 @@ std::vector<SocketNetwork::Client_Info> SocketNetwork::Socket_Server::get_active
 
 void SocketNetwork::Socket_Server::disconnect_client(SOCKET client_socket)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    auto it = active_clients.find(client_socket);
-    if (it != active_clients.end())
+    auto client = client_registry.remove(client_socket);
+    if (client)
     {
-        if (it->second)
-        {
-            log_client_event(it->second->get_client_info(), "Client disconnected by server");
-            it->second->stop_handling();
-        }
-        active_clients.erase(it);
-        client_count--;
+        log_client_event(client->get_client_snapshot(), "Client disconnected by server");
+        client->stop_handling();
     }
 }
 
 void SocketNetwork::Socket_Server::disconnect_all_clients()
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
+    auto clients = client_registry.clear();
     log_server_event("Disconnecting all clients (" + 
-                     Utils::Conversion::int_to_string(static_cast<int>(active_clients.size())) + ")");
+                     Utils::Conversion::int_to_string(static_cast<int>(clients.size())) + ")");
     
-    for (auto& pair : active_clients)
+    for (auto& client : clients)
     {
-        if (pair.second)
+        if (client)
         {
-            pair.second->stop_handling();
+            client->stop_handling();
         }
     }
-    
-    active_clients.clear();
-    client_count = 0;
 }
 
-void SocketNetwork::Socket_Server::broadcast_message(const std::string& message)
+void SocketNetwork::Socket_Server::broadcast_message(const std::string& message, const Frame_Header& header,
+    const std::function<bool(const Client_Handler&)>& recipient_filter)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
+    // Sends run on a copy of the list, a slow socket never holds up accepts or disconnects.
+    // Every recipient queues the same buffer, only the framing bytes are per connection.
     int sent_count = 0;
+    Shared_Buffer shared_message = std::make_shared<const std::string>(message);
     
-    for (auto& pair : active_clients)
+    for (auto& client : client_registry.snapshot())
     {
-        if (pair.second && pair.second->send_message(message))
+        if (!client || (recipient_filter && !recipient_filter(*client)))
+        {
+            continue;
+        }
+        
+        if (client->send_shared_message(shared_message, header))
         {
             sent_count++;
         }
@@ -283,49 +343,62 @@ void SocketNetwork::Socket_Server::broadcast_message(const std::string& message)
 
 void SocketNetwork::Socket_Server::send_message_to_user(int user_id, const std::string& message)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
+    // Every connection the user has open gets the message
+    auto clients = client_registry.find_by_user(user_id);
+    if (clients.empty())
+    {
+        log_server_event("User " + Utils::Conversion::int_to_string(user_id) + " not found for message delivery");
+        return;
+    }
     
-    for (auto& pair : active_clients)
+    int sent_count = 0;
+    Shared_Buffer shared_message = std::make_shared<const std::string>(message);
+    for (auto& client : clients)
     {
-        if (pair.second && pair.second->get_client_info().user_id == user_id)
+        if (client->send_shared_message(shared_message))
         {
-            if (pair.second->send_message(message))
-            {
-                total_messages_sent++;
-                log_server_event("Message sent to user " + Utils::Conversion::int_to_string(user_id));
-            }
-            return;
+            sent_count++;
         }
     }
     
-    log_server_event("User " + Utils::Conversion::int_to_string(user_id) + " not found for message delivery");
+    total_messages_sent += sent_count;
+    log_server_event("Message sent to user " + Utils::Conversion::int_to_string(user_id) + " on " +
+                     Utils::Conversion::int_to_string(sent_count) + " connection(s)");
 }
 
 void SocketNetwork::Socket_Server::send_message_to_client(SOCKET client_socket, const std::string& message)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    auto it = active_clients.find(client_socket);
-    
-    if (it != active_clients.end() && it->second)
+    auto client = client_registry.find(client_socket);
+    if (client && client->send_message(message))
     {
-        if (it->second->send_message(message))
-        {
-            total_messages_sent++;
-        }
+        total_messages_sent++;
     }
 }
 
 SocketNetwork::Server_Stats SocketNetwork::Socket_Server::get_server_stats() const
 {
     Server_Stats stats;
-    stats.active_clients = client_count.load();
+    stats.active_clients = client_registry.size();
     stats.total_connections = total_connections.load();
     stats.total_messages_received = total_messages_received.load();
     stats.total_messages_sent = total_messages_sent.load();
     stats.uptime = get_uptime();
     stats.start_time = server_start_time;
-    stats.average_response_time_ms = 0.0; // Response time tracking not implemented in this version
+    stats.average_response_time_ms = Latency_Metrics::snapshot().average_response_time_ms();
     stats.memory_usage_mb = static_cast<int>(Utils::Memory::get_memory_usage_MB());
+
+    if (db_manager)
+    {
+        auto cache_stats = db_manager->get_statement_cache_stats();
+        stats.statement_cache_hits = cache_stats.hits;
+        stats.statement_cache_misses = cache_stats.misses;
+        stats.statement_cache_hit_rate = cache_stats.hit_rate();
+
+        if (auto counters = db_manager->get_seat_counters())
+        {
+            stats.bookings_refused_in_memory = counters->get_stats().rejected;
+        }
+    }
     
     return stats;
 }
@@ -336,6 +409,7 @@ void SocketNetwork::Socket_Server::reset_server_stats()
     total_messages_received = 0;
     total_messages_sent = 0;
     server_start_time = Utils::DateTime::get_current_date_time();
+    Latency_Metrics::reset();
     log_server_event("Server statistics reset");
 }
 
@@ -399,7 +473,8 @@ bool SocketNetwork::Socket_Server::bind_and_listen()
         return false;
     }
     
-    if (listen(server_socket, Config::Server::BACKLOG_SIZE) == SOCKET_ERROR)
+    int backlog = config.io_mode == Io_Mode::REACTOR ? Config::Server::REACTOR_BACKLOG_SIZE : Config::Server::BACKLOG_SIZE;
+    if (listen(server_socket, backlog) == SOCKET_ERROR)
     {
         log_server_event("Listen failed with error: " + 
                         Utils::Conversion::int_to_string(WSAGetLastError()));
@@ -430,7 +505,7 @@ void SocketNetwork::Socket_Server::accept_connections_loop()
             continue;
         }
         
-        if (client_count.load() >= config.max_clients)
+        if (client_registry.size() >= config.max_clients)
         {
             log_server_event("Maximum clients reached, rejecting connection");
             closesocket(clientSocket);
@@ -451,23 +526,16 @@ void SocketNetwork::Socket_Server::accept_connections_loop()
 
 void SocketNetwork::Socket_Server::cleanup_disconnected_clients()
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    auto it = active_clients.begin();
+    auto removed = client_registry.remove_if([](const std::shared_ptr<Client_Handler>& client)
+    {
+        return !client || !client->is_client_running();
+    });
     
-    while (it != active_clients.end())
+    for (auto& client : removed)
     {
-        if (!it->second || !it->second->is_client_running())
+        if (client)
         {
-            if (it->second)
-            {
-                log_client_event(it->second->get_client_info(), "Cleaning up disconnected client");
-            }
-            it = active_clients.erase(it);
-            client_count--;
-        }
-        else 
-        {
-            ++it;
+            log_client_event(client->get_client_snapshot(), "Cleaning up disconnected client");
         }
     }
 }
@@ -483,6 +551,13 @@ void SocketNetwork::Socket_Server::handle_new_client(SOCKET client_socket, const
             return;
         }
         
+        if (config.io_mode == Io_Mode::REACTOR && !set_non_blocking(client_socket))
+        {
+            closesocket(client_socket);
+            log_server_event("Failed to switch new client socket to non-blocking mode");
+            return;
+        }
+        
         // Extract port from client socket
         sockaddr_in clientAddr;
         int addrlen = sizeof(clientAddr);
@@ -526,15 +601,27 @@ void SocketNetwork::Socket_Server::handle_new_client(SOCKET client_socket, const
             return;
         }
         
+        if (!client_registry.add(client_socket, client_handler))
         {
-            std::lock_guard<std::mutex> lock(clients_mutex);
-            active_clients[client_socket] = client_handler;
-            client_count++;
+            // A handler not yet cleaned up still holds the reused socket number
+            client_registry.remove(client_socket);
+            client_registry.add(client_socket, client_handler);
         }
         
         try 
         {
-            client_handler->start_handling();
+            client_handler->attach_worker_pool(worker_pool.get());
+            if (io_reactor)
+            {
+                if (!io_reactor->add_client(client_handler))
+                {
+                    throw std::runtime_error("I/O reactor is not running");
+                }
+            }
+            else
+            {
+                client_handler->start_handling();
+            }
             log_client_event(client_info, "New client connected successfully");
             
             if (on_client_connected)
@@ -545,11 +632,7 @@ void SocketNetwork::Socket_Server::handle_new_client(SOCKET client_socket, const
         catch (const std::exception& e)
         {
             // Remove client from active list if start_handling fails
-            {
-                std::lock_guard<std::mutex> lock(clients_mutex);
-                active_clients.erase(client_socket);
-                client_count--;
-            }
+            client_registry.remove(client_socket);
             log_server_event("Failed to start client handling: " + std::string(e.what()));
             closesocket(client_socket);
         }
@@ -568,40 +651,40 @@ void SocketNetwork::Socket_Server::handle_new_client(SOCKET client_socket, const
 
 void SocketNetwork::Socket_Server::remove_client(SOCKET client_socket)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    auto it = active_clients.find(client_socket);
-    
-    if (it != active_clients.end())
+    auto client = client_registry.remove(client_socket);
+    if (client)
     {
-        if (it->second)
+        Client_Info client_info = client->get_client_snapshot();
+        log_client_event(client_info, "Client removed");
+        
+        if (on_client_disconnected)
         {
-            Client_Info client_info = it->second->get_client_info();
-            log_client_event(client_info, "Client removed");
-            
-            if (on_client_disconnected)
-            {
-                on_client_disconnected(client_info);
-            }
+            on_client_disconnected(client_info);
         }
-        
-        active_clients.erase(it);
-        client_count--;
     }
 }
 
 SocketNetwork::Client_Info* SocketNetwork::Socket_Server::get_client_info(SOCKET client_socket)
 {
-    std::lock_guard<std::mutex> lock(clients_mutex);
-    auto it = active_clients.find(client_socket);
-    
-    if (it != active_clients.end() && it->second)
+    auto client = client_registry.find(client_socket);
+    if (client)
     {
-        return const_cast<Client_Info*>(&it->second->get_client_info());
+        return const_cast<Client_Info*>(&client->get_client_info());
     }
     
     return nullptr;
 }
 
+void SocketNetwork::Socket_Server::bind_client_user(SOCKET client_socket, int user_id, int previous_user_id)
+{
+    client_registry.bind_user(client_socket, user_id, previous_user_id);
+}
+
+void SocketNetwork::Socket_Server::unbind_client_user(SOCKET client_socket, int user_id)
+{
+    client_registry.unbind_user(client_socket, user_id);
+}
+
 std::string SocketNetwork::Socket_Server::get_socket_address(SOCKET socket) const
 {
     sockaddr_in addr;
@@ -649,6 +732,19 @@ bool SocketNetwork::Socket_Server::set_socket_options(SOCKET socket)
     return true;
 }
 
+bool SocketNetwork::Socket_Server::set_non_blocking(SOCKET socket)
+{
+    u_long non_blocking = 1;
+    if (ioctlsocket(socket, FIONBIO, &non_blocking) == SOCKET_ERROR)
+    {
+        log_server_event("Failed to set non-blocking mode: " + 
+                        Utils::Conversion::int_to_string(WSAGetLastError()));
+        return false;
+    }
+    
+    return true;
+}
+
 std::string SocketNetwork::Socket_Server::get_uptime() const
 {
     // Calculate uptime from server start time
@@ -664,6 +760,23 @@ void SocketNetwork::Socket_Server::log_server_event(const std::string& message)
     }
 }
 
+void SocketNetwork::Socket_Server::log_latency_report()
+{
+    Latency_Snapshot snapshot = Latency_Metrics::snapshot();
+    if (snapshot.request_count() == 0)
+    {
+        return;
+    }
+    
+    // One record per line, log records are kept short
+    std::istringstream report(Latency_Metrics::format_report(snapshot));
+    std::string line;
+    while (std::getline(report, line))
+    {
+        log_server_event(line);
+    }
+}
+
 void SocketNetwork::Socket_Server::log_client_event(const Client_Info& client_info, const std::string& message)
 {
     if (config.enable_logging)
@@ -0,0 +1,206 @@
+#include "network/Worker_Pool.h"
+
+#include <algorithm>
+
+// ============================================================================
+// Worker_Pool Implementation
+// ============================================================================
+
+SocketNetwork::Worker_Pool::Worker_Pool()
+    : Worker_Pool(Options())
+{
+}
+
+SocketNetwork::Worker_Pool::Worker_Pool(const Options& pool_options)
+    : options(pool_options)
+{
+    options.thread_count = (std::max)(1, options.thread_count);
+    options.high_priority_reserve = (std::min)(options.high_priority_reserve, options.capacity);
+}
+
+SocketNetwork::Worker_Pool::~Worker_Pool()
+{
+    stop();
+}
+
+bool SocketNetwork::Worker_Pool::start()
+{
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (!workers.empty())
+    {
+        return true;
+    }
+
+    is_stopping = false;
+    try
+    {
+        for (int i = 0; i < options.thread_count; i++)
+        {
+            workers.emplace_back(&Worker_Pool::run_worker, this);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Utils::Logger::error("Failed to start worker thread: " + std::string(e.what()));
+        is_stopping = true;
+        queue_condition.notify_all();
+        return false;
+    }
+    return true;
+}
+
+void SocketNetwork::Worker_Pool::stop()
+{
+    std::vector<std::thread> stopping_workers;
+    std::deque<Task> discarded[PRIORITY_COUNT];
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        is_stopping = true;
+        stopping_workers.swap(workers);
+        for (size_t i = 0; i < PRIORITY_COUNT; i++)
+        {
+            discarded[i].swap(queues[i]);
+        }
+        queued_count = 0;
+    }
+    queue_condition.notify_all();
+
+    for (auto& worker : stopping_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    // discarded is destroyed outside the lock, tasks may own the last reference to a client
+}
+
+bool SocketNetwork::Worker_Pool::try_submit(Request_Priority priority, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+
+        // The last high_priority_reserve slots are kept for KEEPALIVE and authentication
+        size_t limit = priority == Request_Priority::HIGH ? options.capacity : options.capacity - options.high_priority_reserve;
+        if (is_stopping || workers.empty() || queued_count >= limit)
+        {
+            rejected++;
+            return false;
+        }
+
+        queues[static_cast<size_t>(priority)].push_back(Task{ std::move(task), std::chrono::steady_clock::now() });
+        queued_count++;
+    }
+    queue_condition.notify_one();
+    return true;
+}
+
+SocketNetwork::Worker_Pool::Stats SocketNetwork::Worker_Pool::get_stats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stats.queued = queued_count;
+    }
+    stats.completed = completed.load();
+    stats.rejected = rejected.load();
+    return stats;
+}
+
+SocketNetwork::Request_Priority SocketNetwork::Worker_Pool::priority_for(Message_Type type)
+{
+    switch (type)
+    {
+        case Message_Type::KEEPALIVE:
+        case Message_Type::HELLO:
+        case Message_Type::AUTHENTICATION:
+        case Message_Type::REGISTRATION:
+        case Message_Type::GET_SERVER_STATS:
+        case Message_Type::SUBSCRIBE_OFFERS:
+        case Message_Type::RESUME_SESSION:
+        case Message_Type::LOGOUT:
+            return Request_Priority::HIGH;
+
+        case Message_Type::BOOK_OFFER:
+        case Message_Type::CANCEL_RESERVATION:
+        case Message_Type::GET_USER_RESERVATIONS:
+        case Message_Type::GET_USER_INFO:
+        case Message_Type::UPDATE_USER_INFO:
+            return Request_Priority::NORMAL;
+
+        default:
+            return Request_Priority::LOW;
+    }
+}
+
+void SocketNetwork::Worker_Pool::run_worker()
+{
+    for (;;)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_condition.wait(lock, [this]()
+            {
+                return is_stopping || queued_count > 0;
+            });
+            if (is_stopping)
+            {
+                return;
+            }
+            take_task(task);
+        }
+
+        try
+        {
+            task.run();
+        }
+        catch (const std::exception& e)
+        {
+            Utils::Logger::error("Worker task failed: " + std::string(e.what()));
+        }
+        catch (...)
+        {
+            Utils::Logger::error("Worker task failed with an unknown exception");
+        }
+        task.run = nullptr; // Release what the task captured before waiting again
+        completed++;
+    }
+}
+
+bool SocketNetwork::Worker_Pool::take_task(Task& task)
+{
+    // A lower priority head that waited too long is served first, oldest such one wins
+    auto now = std::chrono::steady_clock::now();
+    size_t chosen = PRIORITY_COUNT;
+    for (size_t i = PRIORITY_COUNT; i-- > 1;)
+    {
+        if (!queues[i].empty() && now - queues[i].front().queued_at > options.max_queue_wait &&
+            (chosen == PRIORITY_COUNT || queues[i].front().queued_at < queues[chosen].front().queued_at))
+        {
+            chosen = i;
+        }
+    }
+
+    if (chosen == PRIORITY_COUNT)
+    {
+        for (size_t i = 0; i < PRIORITY_COUNT; i++)
+        {
+            if (!queues[i].empty())
+            {
+                chosen = i;
+                break;
+            }
+        }
+    }
+
+    if (chosen == PRIORITY_COUNT)
+    {
+        return false;
+    }
+
+    task = std::move(queues[chosen].front());
+    queues[chosen].pop_front();
+    queued_count--;
+    return true;
+}
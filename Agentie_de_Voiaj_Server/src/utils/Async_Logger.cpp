@@ -0,0 +1,399 @@
+#include "utils/Async_Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+namespace
+{
+    const char* level_name(Utils::Logger::Level level)
+    {
+        switch (level)
+        {
+            case Utils::Logger::Level::DEBUG: return "DEBUG";
+            case Utils::Logger::Level::INFO: return "INFO";
+            case Utils::Logger::Level::WARNING: return "WARNING";
+            case Utils::Logger::Level::ERR: return "ERROR";
+            case Utils::Logger::Level::CRITICAL: return "CRITICAL";
+            default: return "UNKNOWN";
+        }
+    }
+
+    std::tm local_time(std::time_t time)
+    {
+        std::tm result{};
+#ifdef _WIN32
+        localtime_s(&result, &time);
+#else
+        localtime_r(&time, &result);
+#endif
+        return result;
+    }
+
+    // "YYYY-MM-DD HH:MM:SS", re-formatted once per second per thread
+    const char* current_timestamp()
+    {
+        thread_local std::time_t cached_second = -1;
+        thread_local char cached_text[32] = {};
+
+        std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        if (now != cached_second)
+        {
+            std::tm parts = local_time(now);
+            std::strftime(cached_text, sizeof(cached_text), "%Y-%m-%d %H:%M:%S", &parts);
+            cached_second = now;
+        }
+        return cached_text;
+    }
+
+    std::string current_log_path(const std::string& directory)
+    {
+        std::tm parts = local_time(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+        char date[16];
+        std::strftime(date, sizeof(date), "%Y_%m_%d", &parts);
+        return directory + "server_" + date + ".log";
+    }
+
+    // server_<date>.log -> server_<date>.<index>.log
+    std::string rotated_log_path(const std::string& path, int index)
+    {
+        return path.substr(0, path.size() - 4) + "." + std::to_string(index) + ".log";
+    }
+}
+
+// ============================================================================
+// Async_Logger Implementation
+// ============================================================================
+
+Utils::Async_Logger::Async_Logger()
+    : Async_Logger(Options())
+{
+}
+
+Utils::Async_Logger::Async_Logger(const Options& logger_options)
+    : options(logger_options), console_output(logger_options.console_output), file_output(logger_options.file_output)
+{
+    size_t capacity = 2;
+    while (capacity < options.capacity)
+    {
+        capacity <<= 1;
+    }
+    options.capacity = capacity;
+    mask = capacity - 1;
+
+    // Slot i is free for the producer that claims position i
+    slots = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    writer = std::thread(&Async_Logger::run_writer, this);
+}
+
+Utils::Async_Logger::~Async_Logger()
+{
+    is_stopping = true;
+    wake_writer();
+    if (writer.joinable())
+    {
+        writer.join();
+    }
+}
+
+bool Utils::Async_Logger::log(Logger::Level level, const std::string& message)
+{
+    if (try_enqueue(level, message))
+    {
+        return true;
+    }
+
+    bool may_drop = options.policy == Overflow_Policy::DROP && level <= Logger::Level::INFO;
+    if (may_drop)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Ring full: hand the writer the CPU, then back off until a slot frees up
+    wake_writer();
+    for (int attempt = 0; !try_enqueue(level, message); ++attempt)
+    {
+        if (attempt < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    return true;
+}
+
+bool Utils::Async_Logger::try_enqueue(Logger::Level level, const std::string& message)
+{
+    uint64_t position = enqueue_position.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;)
+    {
+        slot = &slots[position & mask];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+        if (difference == 0)
+        {
+            if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false; // The writer has not freed this slot yet
+        }
+        else
+        {
+            position = enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->length = static_cast<uint32_t>(format_record(slot->text, level, message));
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    // The writer polls every flush interval; under a burst it is woken each half ring
+    if ((position & (mask >> 1)) == 0)
+    {
+        wake_writer();
+    }
+    return true;
+}
+
+size_t Utils::Async_Logger::format_record(char* out, Logger::Level level, const std::string& message)
+{
+    static const char TRUNCATED_MARKER[] = " ...[truncated]";
+    constexpr size_t MARKER_LENGTH = sizeof(TRUNCATED_MARKER) - 1;
+
+    size_t length = 0;
+    auto append = [&](const char* text, size_t count)
+    {
+        count = std::min(count, RECORD_BYTES - length);
+        std::memcpy(out + length, text, count);
+        length += count;
+    };
+
+    const char* name = level_name(level);
+    append("[", 1);
+    append(current_timestamp(), 19);
+    append("] [", 3);
+    append(name, std::strlen(name));
+    append("] ", 2);
+
+    if (length + message.size() <= RECORD_BYTES)
+    {
+        append(message.data(), message.size());
+    }
+    else
+    {
+        append(message.data(), RECORD_BYTES - MARKER_LENGTH - length);
+        append(TRUNCATED_MARKER, MARKER_LENGTH);
+    }
+    return length;
+}
+
+void Utils::Async_Logger::wake_writer()
+{
+    wake_condition.notify_one();
+}
+
+void Utils::Async_Logger::flush()
+{
+    uint64_t target = enqueue_position.load(std::memory_order_acquire);
+    if (written_position.load(std::memory_order_acquire) >= target)
+    {
+        return;
+    }
+
+    wake_writer();
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    flushed_condition.wait(lock, [&]
+    {
+        return written_position.load(std::memory_order_acquire) >= target;
+    });
+}
+
+Utils::Async_Logger::Stats Utils::Async_Logger::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    Stats result = stats;
+    result.dropped = dropped.load(std::memory_order_relaxed);
+    return result;
+}
+
+// ============================================================================
+// Writer thread
+// ============================================================================
+
+void Utils::Async_Logger::run_writer()
+{
+    auto record_ready = [this]
+    {
+        const Slot& slot = slots[dequeue_position & mask];
+        return slot.sequence.load(std::memory_order_acquire) == dequeue_position + 1;
+    };
+
+    for (;;)
+    {
+        size_t count = drain_batch();
+        if (!batch.empty())
+        {
+            write_batch();
+        }
+
+        if (count > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                written_position.store(dequeue_position, std::memory_order_release);
+            }
+            flushed_condition.notify_all();
+            continue;
+        }
+
+        if (is_stopping)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        wake_condition.wait_for(lock, std::chrono::milliseconds(options.flush_interval_ms), [&]
+        {
+            return is_stopping.load() || record_ready();
+        });
+    }
+
+    if (file.is_open())
+    {
+        file.close();
+    }
+}
+
+size_t Utils::Async_Logger::drain_batch()
+{
+    batch.clear();
+    size_t count = 0;
+
+    // At most one ring's worth, so a steady stream of producers cannot starve the write
+    while (count <= mask)
+    {
+        Slot& slot = slots[dequeue_position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1)
+        {
+            break; // Empty, or the next producer is still formatting its record
+        }
+
+        batch.append(slot.text, slot.length);
+        batch += '\n';
+
+        // Free the slot for the producer one lap ahead
+        slot.sequence.store(dequeue_position + mask + 1, std::memory_order_release);
+        ++dequeue_position;
+        ++count;
+    }
+
+    uint64_t dropped_now = dropped.load(std::memory_order_relaxed);
+    if (dropped_now != reported_dropped)
+    {
+        batch += "[";
+        batch += current_timestamp();
+        batch += "] [WARNING] " + std::to_string(dropped_now - reported_dropped) + " log records dropped, logging ring full\n";
+        reported_dropped = dropped_now;
+    }
+    return count;
+}
+
+void Utils::Async_Logger::write_batch()
+{
+    if (console_output)
+    {
+        std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        std::cout.flush();
+    }
+
+    if (file_output)
+    {
+        if (!file.is_open() || file_path != current_log_path(options.directory))
+        {
+            open_log_file();
+        }
+        else if (file_bytes > 0 && file_bytes + static_cast<long long>(batch.size()) > options.max_file_bytes)
+        {
+            rotate_log_file();
+        }
+
+        if (file.is_open())
+        {
+            file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            file.flush();
+            file_bytes += static_cast<long long>(batch.size());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.written = dequeue_position;
+    ++stats.batches;
+}
+
+void Utils::Async_Logger::open_log_file()
+{
+    if (file.is_open())
+    {
+        file.close();
+    }
+
+    file_path = current_log_path(options.directory);
+    std::error_code error;
+    std::filesystem::create_directories(options.directory, error);
+
+    file.open(file_path, std::ios::app | std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open log file: " << file_path << std::endl;
+        file_bytes = 0;
+        return;
+    }
+
+    auto size = std::filesystem::file_size(file_path, error);
+    file_bytes = error ? 0 : static_cast<long long>(size);
+}
+
+void Utils::Async_Logger::rotate_log_file()
+{
+    file.close();
+
+    // server_<date>.log becomes .1, .1 becomes .2 ... and the oldest is removed
+    std::error_code error;
+    std::filesystem::remove(rotated_log_path(file_path, options.max_rotated_files), error);
+    for (int index = options.max_rotated_files - 1; index >= 1; --index)
+    {
+        std::filesystem::rename(rotated_log_path(file_path, index), rotated_log_path(file_path, index + 1), error);
+    }
+    if (options.max_rotated_files > 0)
+    {
+        std::filesystem::rename(file_path, rotated_log_path(file_path, 1), error);
+    }
+    else
+    {
+        std::filesystem::remove(file_path, error);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        ++stats.rotations;
+    }
+    open_log_file();
+}
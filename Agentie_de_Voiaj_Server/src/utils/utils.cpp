@@ -1,4 +1,5 @@
 #include "utils/utils.h"
+#include "utils/Async_Logger.h"
 #include "config.h"
 // Windows includes - careful order to avoid conflicts
 #include <winsock2.h>
@@ -15,11 +16,16 @@
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 
 // OpenSSL includes
 #include <openssl/md5.h>
 #include <openssl/evp.h>
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
 
 // JSON include
 #include <nlohmann/json.hpp>
@@ -297,24 +303,60 @@ namespace Utils
 
 	namespace Crypto
 	{
-		std::string hash_password(const std::string& password, const std::string& salt)
+		namespace
 		{
-			std::string salted_password = password + salt;
-			
-			EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
-			const EVP_MD* md = EVP_sha256();
-			unsigned char md_value[EVP_MAX_MD_SIZE];
-			unsigned int md_len;
+			// One context per thread, EVP_DigestInit_ex resets it for every digest
+			EVP_MD_CTX* thread_digest_context()
+			{
+				struct Context_Holder
+				{
+					EVP_MD_CTX* context = EVP_MD_CTX_new();
+					~Context_Holder() { EVP_MD_CTX_free(context); }
+				};
+				thread_local Context_Holder holder;
+				return holder.context;
+			}
 
-			EVP_DigestInit_ex(mdctx, md, NULL);
-			EVP_DigestUpdate(mdctx, salted_password.c_str(), salted_password.length());
-			EVP_DigestFinal_ex(mdctx, md_value, &md_len);
-			EVP_MD_CTX_free(mdctx);
+			// Empty on failure, which never matches a stored hash
+			std::string digest_hex(const EVP_MD* md, const std::string& first, const std::string& second = "")
+			{
+				EVP_MD_CTX* mdctx = thread_digest_context();
+				unsigned char md_value[EVP_MAX_MD_SIZE];
+				unsigned int md_len = 0;
+
+				if (!mdctx || EVP_DigestInit_ex(mdctx, md, NULL) != 1 ||
+					EVP_DigestUpdate(mdctx, first.data(), first.size()) != 1 ||
+					EVP_DigestUpdate(mdctx, second.data(), second.size()) != 1 ||
+					EVP_DigestFinal_ex(mdctx, md_value, &md_len) != 1)
+				{
+					return std::string();
+				}
+				return to_hex(md_value, md_len);
+			}
+		}
 
-			std::ostringstream oss;
-			for (unsigned int i = 0; i < md_len; ++i)
-				oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(md_value[i]);
-			return oss.str();
+		std::string to_hex(const unsigned char* data, size_t length)
+		{
+			static const char digits[] = "0123456789abcdef";
+			std::string hex(length * 2, '0');
+			for (size_t i = 0; i < length; ++i)
+			{
+				hex[2 * i] = digits[data[i] >> 4];
+				hex[2 * i + 1] = digits[data[i] & 0x0F];
+			}
+			return hex;
+		}
+
+		bool constant_time_equals(const std::string& a, const std::string& b)
+		{
+			// Only the length can leak, and a hex digest's length is no secret
+			return a.size() == b.size() && CRYPTO_memcmp(a.data(), b.data(), a.size()) == 0;
+		}
+
+		std::string hash_password(const std::string& password, const std::string& salt)
+		{
+			// Two updates hash the same bytes as password + salt without building the string
+			return digest_hex(EVP_sha256(), password, salt);
 		}
 
 		std::string generate_salt()
@@ -324,30 +366,24 @@ namespace Utils
 
 		bool verify_password(const std::string& password, const std::string& hashed_password, const std::string& salt)
 		{
-			return hash_password(password, salt) == hashed_password;
+			std::string computed = hash_password(password, salt);
+			return !computed.empty() && constant_time_equals(computed, hashed_password);
 		}
 
 		std::string generate_session_token()
 		{
-			return Utils::Random::generate_random_string(32, true, true);
+			// Bearer credential: 256 bits from the OpenSSL CSPRNG, empty if it could not be seeded
+			unsigned char bytes[32];
+			if (RAND_bytes(bytes, sizeof(bytes)) != 1)
+			{
+				return std::string();
+			}
+			return to_hex(bytes, sizeof(bytes));
 		}
 
 		std::string md5_hash(const std::string& input)
 		{
-			EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
-			const EVP_MD* md = EVP_md5();
-			unsigned char md_value[EVP_MAX_MD_SIZE];
-			unsigned int md_len;
-
-			EVP_DigestInit_ex(mdctx, md, NULL);
-			EVP_DigestUpdate(mdctx, input.c_str(), input.length());
-			EVP_DigestFinal_ex(mdctx, md_value, &md_len);
-			EVP_MD_CTX_free(mdctx);
-
-			std::ostringstream oss;
-			for (unsigned int i = 0; i < md_len; ++i)
-				oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(md_value[i]);
-			return oss.str();
+			return digest_hex(EVP_md5(), input);
 		}	
 	}
 
@@ -482,13 +518,25 @@ namespace Utils
 	namespace Logger
 	{
 		static Level current_log_level = Level::DEBUG;
-		static bool file_logging_enabled = true;
-		static bool logging_initialized = false;
+		static std::atomic<bool> file_logging_enabled{ true };
+		static std::atomic<bool> console_logging_enabled{ true };
+		static std::atomic<bool> logging_initialized{ false };
+
+		static std::mutex async_logger_mutex;
+		static std::unique_ptr<Async_Logger> async_logger_owner;
+		static std::atomic<Async_Logger*> async_logger{ nullptr };
 
 		void log(Level level, const std::string& message)
 		{
 			if (level < current_log_level)
 				return;
+
+			if (Async_Logger* logger = async_logger.load(std::memory_order_acquire))
+			{
+				logger->log(level, message);
+				return;
+			}
+
 			std::string level_str;
 			switch (level)
 			{
@@ -501,7 +549,10 @@ namespace Utils
 			std::string log_message = "[" + DateTime::get_current_date_time() + "] [" + level_str + "] " + message;
 			
 			// Output to console
-			std::cout << log_message << std::endl;
+			if (console_logging_enabled)
+			{
+				std::cout << log_message << std::endl;
+			}
 			
 			// Output to file if enabled
 			if (file_logging_enabled && logging_initialized)
@@ -578,6 +629,11 @@ namespace Utils
 				}
 				
 				logging_initialized = true;
+
+				if (Config::Application::ASYNC_LOGGING)
+				{
+					enable_async_logging(true);
+				}
 				
 				// Log startup message
 				info("=== Logging system initialized ===");
@@ -595,6 +651,13 @@ namespace Utils
 		void enable_file_logging(bool enabled)
 		{
 			file_logging_enabled = enabled;
+			{
+				std::lock_guard<std::mutex> lock(async_logger_mutex);
+				if (async_logger_owner)
+				{
+					async_logger_owner->set_file_output(enabled && logging_initialized);
+				}
+			}
 			if (logging_initialized)
 			{
 				std::string status = enabled ? "enabled" : "disabled";
@@ -602,6 +665,57 @@ namespace Utils
 			}
 		}
 
+		void enable_console_logging(bool enabled)
+		{
+			console_logging_enabled = enabled;
+			std::lock_guard<std::mutex> lock(async_logger_mutex);
+			if (async_logger_owner)
+			{
+				async_logger_owner->set_console_output(enabled);
+			}
+		}
+
+		void enable_async_logging(bool enabled)
+		{
+			std::lock_guard<std::mutex> lock(async_logger_mutex);
+			if (enabled && !async_logger_owner)
+			{
+				Async_Logger::Options options;
+				options.console_output = console_logging_enabled;
+				options.file_output = file_logging_enabled && logging_initialized;
+				async_logger_owner = std::make_unique<Async_Logger>(options);
+				async_logger.store(async_logger_owner.get(), std::memory_order_release);
+			}
+			else if (!enabled && async_logger_owner)
+			{
+				// Later records go the synchronous way; the writer drains what is queued
+				async_logger.store(nullptr, std::memory_order_release);
+				async_logger_owner.reset();
+			}
+		}
+
+		void flush_logs()
+		{
+			std::lock_guard<std::mutex> lock(async_logger_mutex);
+			if (async_logger_owner)
+			{
+				async_logger_owner->flush();
+			}
+			std::cout.flush();
+		}
+
+		void shutdown_logging()
+		{
+			enable_async_logging(false);
+			std::cout.flush();
+		}
+
+		uint64_t get_dropped_log_count()
+		{
+			std::lock_guard<std::mutex> lock(async_logger_mutex);
+			return async_logger_owner ? async_logger_owner->get_stats().dropped : 0;
+		}
+
 		std::string get_log_filename()
 		{
 			std::string date = DateTime::get_current_date();
@@ -631,21 +745,144 @@ namespace Utils
 			return nlohmann::json(input).dump();
 		}
 
-		std::string create_error_response(const std::string& error_message, int error_code)
+		namespace
+		{
+			// Length of the well-formed UTF-8 sequence starting at data[0]. For an ill-formed one
+			// returns 0 and sets invalid_length to its maximal subpart, replaced by one U+FFFD
+			size_t utf8_sequence_length(const unsigned char* data, size_t available, size_t& invalid_length)
+			{
+				invalid_length = 1;
+				unsigned char lead = data[0];
+				size_t length;
+				unsigned char min_second = 0x80;
+				unsigned char max_second = 0xBF;
+				if (lead >= 0xC2 && lead <= 0xDF)
+					length = 2;
+				else if (lead >= 0xE0 && lead <= 0xEF)
+				{
+					length = 3;
+					if (lead == 0xE0) min_second = 0xA0;	// Overlong
+					if (lead == 0xED) max_second = 0x9F;	// Surrogates
+				}
+				else if (lead >= 0xF0 && lead <= 0xF4)
+				{
+					length = 4;
+					if (lead == 0xF0) min_second = 0x90;	// Overlong
+					if (lead == 0xF4) max_second = 0x8F;	// Above U+10FFFF
+				}
+				else
+					return 0;
+
+				for (size_t i = 1; i < length; i++)
+				{
+					unsigned char low = i == 1 ? min_second : 0x80;
+					unsigned char high = i == 1 ? max_second : 0xBF;
+					if (i >= available || data[i] < low || data[i] > high)
+					{
+						invalid_length = i;
+						return 0;
+					}
+				}
+				return length;
+			}
+		}
+
+		void append_json_string(std::string& out, std::string_view value)
+		{
+			static const char hex_digits[] = "0123456789abcdef";
+			const unsigned char* data = reinterpret_cast<const unsigned char*>(value.data());
+			const size_t size = value.size();
+
+			out += '"';
+			size_t run_start = 0;
+			size_t i = 0;
+			while (i < size)
+			{
+				unsigned char c = data[i];
+				if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80)
+				{
+					i++;
+					continue;
+				}
+
+				size_t invalid_length = 1;
+				size_t sequence = c >= 0x80 ? utf8_sequence_length(data + i, size - i, invalid_length) : 0;
+				if (sequence > 0)
+				{
+					i += sequence;
+					continue;
+				}
+
+				// Plain bytes are copied in runs, only the ones needing an escape stop the run
+				out.append(value.data() + run_start, i - run_start);
+				switch (c)
+				{
+					case '"': out += "\\\""; break;
+					case '\\': out += "\\\\"; break;
+					case '\b': out += "\\b"; break;
+					case '\f': out += "\\f"; break;
+					case '\n': out += "\\n"; break;
+					case '\r': out += "\\r"; break;
+					case '\t': out += "\\t"; break;
+					default:
+						if (c < 0x20)
+						{
+							out += "\\u00";
+							out += hex_digits[c >> 4];
+							out += hex_digits[c & 0x0F];
+						}
+						else
+						{
+							out += "\xEF\xBF\xBD";
+						}
+						break;
+				}
+				i += invalid_length;
+				run_start = i;
+			}
+			out.append(value.data() + run_start, size - run_start);
+			out += '"';
+		}
+
+		std::string create_error_response(const std::string& error_message, int error_code, uint32_t request_id)
     	{
 			nlohmann::json response;
 			response["success"] = false;
 			response["message"] = error_message;
 			if (error_code != -1)
 				response["error_code"] = error_code;
+			if (request_id != 0)
+				response["request_id"] = request_id;
 			return response.dump();
     	}
 
-		std::string create_success_response(const std::string& data, const std::string& message)
+		std::string create_success_response(const std::string& data, const std::string& message, bool data_is_json,
+			uint32_t request_id)
    		{
+			if (data_is_json && !data.empty())
+			{
+				// Pre-serialized payload (offer catalog): splice it in instead of parsing and dumping it again.
+				// Keys in the order nlohmann::json would dump them
+				std::string response;
+				response.reserve(data.size() + message.size() + 72);
+				response += "{\"data\":";
+				response += data;
+				response += ",\"message\":";
+				response += nlohmann::json(message.empty() ? "Success" : message).dump();
+				if (request_id != 0)
+				{
+					response += ",\"request_id\":";
+					response += std::to_string(request_id);
+				}
+				response += ",\"success\":true}";
+				return response;
+			}
+
 			nlohmann::json response;
 			response["success"] = true;
 			response["message"] = message.empty() ? "Success" : message;
+			if (request_id != 0)
+				response["request_id"] = request_id;
 			
 			if (!data.empty())
 			{
@@ -0,0 +1,1409 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+
+// Include test headers
+#include "network/Socket_Server.h"
+#include "network/Client_Handler.h"
+#include "network/Protocol_Handler.h"
+#include "network/Network_Types.h"
+#include "database/Database_Manager.h"
+#include "database/Row_Fetcher.h"
+#include "database/Offer_Index.h"
+#include "network/Response_Writer.h"
+#include "network/Payload_Compressor.h"
+#include "utils/utils.h"
+#include <ws2tcpip.h>
+#include <openssl/evp.h>
+
+// Benchmarks are run by hand against a Release build; they print numbers
+// instead of asserting, regressions are judged by comparing runs.
+
+// Benchmark utilities
+class BenchUtils {
+public:
+    static double percentile(std::vector<double> samples, double p) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        std::sort(samples.begin(), samples.end());
+        size_t index = static_cast<size_t>(p / 100.0 * (samples.size() - 1));
+        return samples[index];
+    }
+
+    static void print_header(const std::string& title) {
+        std::cout << "\n=== " << title << " ===" << std::endl;
+    }
+
+    static std::string get_env(const char* name, const std::string& fallback) {
+        const char* value = std::getenv(name);
+        return value && *value ? std::string(value) : fallback;
+    }
+
+    // Local stand-in backend, AGENTIE_BENCH_DB_SERVER overrides the LocalDB default.
+    // Returns nullptr (benchmark skipped) when no database is reachable.
+    static std::shared_ptr<Database::Database_Manager> connect_bench_database(const Database::Pool_Config& pool_config) {
+        auto db = std::make_shared<Database::Database_Manager>(
+            get_env("AGENTIE_BENCH_DB_SERVER", "(LocalDB)\\MSSQLLocalDB"),
+            get_env("AGENTIE_BENCH_DB_NAME", Config::Database::DEFAULT_DATABASE), "", "");
+        db->set_pool_config(pool_config);
+        try {
+            if (db->connect() && db->database_exists()) {
+                return db;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cout << "  skipped: " << e.what() << std::endl;
+            return nullptr;
+        }
+        std::cout << "  skipped: benchmark database not reachable" << std::endl;
+        return nullptr;
+    }
+};
+
+// ============================================================================
+// Connection scaling: thread-per-client vs reactor
+// ============================================================================
+
+namespace {
+    constexpr int BENCH_BASE_PORT = 18080;
+    constexpr int LATENCY_SAMPLES = 200;
+
+    struct Scaling_Result {
+        int requested = 0;
+        int connected = 0;
+        size_t memory_mb = 0;
+        double p50_us = 0.0;
+        double p99_us = 0.0;
+    };
+
+    SOCKET open_client_connection(int port, int index) {
+        SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (s == INVALID_SOCKET) {
+            return INVALID_SOCKET;
+        }
+
+        // Spread source addresses over 127.0.0.x so 50k connections do not run
+        // out of the ~16k default ephemeral ports of a single source address
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = 0;
+        local.sin_addr.s_addr = htonl(0x7F000002 + index / 10000);
+        bind(s, (sockaddr*)&local, sizeof(local));
+
+        sockaddr_in remote{};
+        remote.sin_family = AF_INET;
+        remote.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &remote.sin_addr);
+
+        if (connect(s, (sockaddr*)&remote, sizeof(remote)) == SOCKET_ERROR) {
+            closesocket(s);
+            return INVALID_SOCKET;
+        }
+
+        DWORD timeout = 5000;
+        setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+        return s;
+    }
+
+    bool keepalive_round_trip(SOCKET s) {
+        const std::string request = "{\"type\":\"KEEPALIVE\"}\r\n";
+        if (send(s, request.c_str(), static_cast<int>(request.size()), 0) == SOCKET_ERROR) {
+            return false;
+        }
+
+        char buffer[512];
+        while (true) {
+            int received = recv(s, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            if (std::find(buffer, buffer + received, '\n') != buffer + received) {
+                return true;
+            }
+        }
+    }
+
+    Scaling_Result run_connection_scaling(SocketNetwork::Io_Mode mode, int connections) {
+        Scaling_Result result;
+        result.requested = connections;
+
+        // Fresh port per run, the previous run leaves its sockets in TIME_WAIT
+        static int run_index = 0;
+        int port = BENCH_BASE_PORT + run_index++;
+
+        SocketNetwork::Server_Config config("127.0.0.1", port);
+        config.io_mode = mode;
+        config.max_clients = connections + 1;
+        config.enable_logging = false;
+
+        SocketNetwork::Socket_Server server(config);
+        server.set_database_manager(std::make_shared<Database::Database_Manager>("dummy", "dummy", "", ""));
+        if (!server.start()) {
+            return result;
+        }
+
+        size_t baseline_mb = Utils::Memory::get_memory_usage_MB();
+
+        std::vector<SOCKET> clients;
+        clients.reserve(connections);
+        for (int i = 0; i < connections; i++) {
+            SOCKET s = open_client_connection(port, i);
+            if (s == INVALID_SOCKET) {
+                break;
+            }
+            clients.push_back(s);
+        }
+
+        // Accept runs on its own thread, give it time to register everything
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (server.get_active_client_count() < static_cast<int>(clients.size()) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        result.connected = server.get_active_client_count();
+        size_t loaded_mb = Utils::Memory::get_memory_usage_MB();
+        result.memory_mb = loaded_mb > baseline_mb ? loaded_mb - baseline_mb : 0;
+
+        // Latency is sampled across the whole population while all sockets stay open
+        std::vector<double> samples;
+        if (!clients.empty()) {
+            size_t stride = std::max<size_t>(1, clients.size() / LATENCY_SAMPLES);
+            for (size_t i = 0; i < clients.size(); i += stride) {
+                auto start = std::chrono::high_resolution_clock::now();
+                if (keepalive_round_trip(clients[i])) {
+                    auto end = std::chrono::high_resolution_clock::now();
+                    samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+                }
+            }
+        }
+        result.p50_us = BenchUtils::percentile(samples, 50.0);
+        result.p99_us = BenchUtils::percentile(samples, 99.0);
+
+        for (SOCKET s : clients) {
+            closesocket(s);
+        }
+        server.stop();
+        return result;
+    }
+}
+
+void benchmark_connection_scaling() {
+    BenchUtils::print_header("CONNECTION SCALING (KEEPALIVE, DEMO DATABASE)");
+
+    const int connection_counts[] = { 1000, 10000, 50000 };
+    const std::pair<SocketNetwork::Io_Mode, const char*> modes[] = {
+        { SocketNetwork::Io_Mode::THREAD_PER_CLIENT, "thread-per-client" },
+        { SocketNetwork::Io_Mode::REACTOR, "reactor" }
+    };
+
+    std::cout << std::left << std::setw(20) << "mode" << std::setw(12) << "requested"
+              << std::setw(12) << "connected" << std::setw(14) << "memory (MB)"
+              << std::setw(12) << "p50 (us)" << "p99 (us)" << std::endl;
+
+    for (const auto& mode : modes) {
+        for (int count : connection_counts) {
+            Scaling_Result r = run_connection_scaling(mode.first, count);
+            std::cout << std::left << std::setw(20) << mode.second << std::setw(12) << r.requested
+                      << std::setw(12) << r.connected << std::setw(14) << r.memory_mb
+                      << std::setw(12) << std::fixed << std::setprecision(1) << r.p50_us
+                      << r.p99_us << std::endl;
+        }
+    }
+}
+
+// ============================================================================
+// Connection pool: concurrent Protocol_Handler::process_message throughput
+// ============================================================================
+
+namespace {
+    constexpr int POOL_BENCH_THREADS = 16;
+    constexpr int POOL_BENCH_REQUESTS_PER_THREAD = 200;
+
+    struct Throughput_Result {
+        int requests = 0;
+        int failures = 0;
+        double seconds = 0.0;
+        Database::Pool_Stats pool_stats;
+    };
+
+    Throughput_Result run_pool_throughput(std::shared_ptr<Database::Database_Manager> db, int book_offer_id) {
+        SocketNetwork::Protocol_Handler protocol_handler(db);
+        std::atomic<int> failures(0);
+        std::vector<std::thread> workers;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < POOL_BENCH_THREADS; t++) {
+            workers.emplace_back([&, t]() {
+                // Detached handler: no socket, only used for the auth state process_message expects
+                SocketNetwork::Client_Info info(INVALID_SOCKET, "127.0.0.1", 0);
+                SocketNetwork::Client_Handler client(INVALID_SOCKET, info, db, &protocol_handler, nullptr);
+                client.set_authenticated(1, "bench");
+
+                auto get_offers = protocol_handler.parse_message("{\"type\":\"GET_OFFERS\"}");
+                auto book_offer = protocol_handler.parse_message(
+                    "{\"type\":\"BOOK_OFFER\",\"offer_id\":" + std::to_string(book_offer_id) + ",\"person_count\":1}");
+
+                for (int i = 0; i < POOL_BENCH_REQUESTS_PER_THREAD; i++) {
+                    // One booking per eight reads when an offer to book against was given
+                    bool book = book_offer_id > 0 && (i + t) % 8 == 0;
+                    auto response = protocol_handler.process_message(book ? book_offer : get_offers, &client);
+                    if (!response.success) {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        Throughput_Result result;
+        result.requests = POOL_BENCH_THREADS * POOL_BENCH_REQUESTS_PER_THREAD;
+        result.failures = failures.load();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        result.pool_stats = db->get_pool_stats();
+        return result;
+    }
+}
+
+void benchmark_connection_pool() {
+    BenchUtils::print_header("CONNECTION POOL THROUGHPUT (" + std::to_string(POOL_BENCH_THREADS) + " THREADS)");
+
+    // AGENTIE_BENCH_OFFER_ID mixes BOOK_OFFER into the load; it books real seats, use a scratch database
+    int book_offer_id = std::atoi(BenchUtils::get_env("AGENTIE_BENCH_OFFER_ID", "0").c_str());
+
+    std::cout << std::left << std::setw(12) << "pool size" << std::setw(12) << "requests"
+              << std::setw(12) << "failures" << std::setw(14) << "req/s"
+              << std::setw(10) << "peak" << "waits" << std::endl;
+
+    const int pool_sizes[] = { 1, 4, POOL_BENCH_THREADS };
+    for (int pool_size : pool_sizes) {
+        Database::Pool_Config pool_config;
+        pool_config.min_size = pool_size;
+        pool_config.max_size = pool_size;
+        pool_config.acquire_timeout_ms = 60000;
+
+        auto db = BenchUtils::connect_bench_database(pool_config);
+        if (!db) {
+            return;
+        }
+
+        Throughput_Result r = run_pool_throughput(db, book_offer_id);
+        std::cout << std::left << std::setw(12) << pool_size << std::setw(12) << r.requests
+                  << std::setw(12) << r.failures << std::setw(14) << std::fixed << std::setprecision(0)
+                  << (r.seconds > 0 ? r.requests / r.seconds : 0.0)
+                  << std::setw(10) << r.pool_stats.peak_connections << r.pool_stats.wait_count << std::endl;
+    }
+}
+
+// ============================================================================
+// Bulk fetch: per-column SQLGetData vs bound row arrays
+// ============================================================================
+
+namespace {
+    constexpr int FETCH_BENCH_ROWS = 10000;
+    constexpr int FETCH_BENCH_RUNS = 5;
+
+    struct Odbc_Connection {
+        SQLHENV henv = SQL_NULL_HENV;
+        SQLHDBC hdbc = SQL_NULL_HDBC;
+
+        ~Odbc_Connection() {
+            if (hdbc != SQL_NULL_HDBC) {
+                SQLDisconnect(hdbc);
+                SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+            }
+            if (henv != SQL_NULL_HENV) {
+                SQLFreeHandle(SQL_HANDLE_ENV, henv);
+            }
+        }
+
+        bool open(const std::string& connection_string) {
+            if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv)) ||
+                !SQL_SUCCEEDED(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0)) ||
+                !SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc))) {
+                return false;
+            }
+            std::vector<char> conn_str(connection_string.begin(), connection_string.end());
+            conn_str.push_back('\0');
+            SQLRETURN ret = SQLDriverConnectA(hdbc, NULL, reinterpret_cast<SQLCHAR*>(conn_str.data()), SQL_NTS,
+                                              NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+            if (!SQL_SUCCEEDED(ret)) {
+                SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+                hdbc = SQL_NULL_HDBC;
+                return false;
+            }
+            return true;
+        }
+
+        bool execute(const std::string& sql) {
+            SQLHSTMT hstmt = SQL_NULL_HSTMT;
+            if (!SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt))) {
+                return false;
+            }
+            std::vector<char> query(sql.begin(), sql.end());
+            query.push_back('\0');
+            SQLRETURN ret = SQLExecDirectA(hstmt, reinterpret_cast<SQLCHAR*>(query.data()), SQL_NTS);
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+            return SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA;
+        }
+    };
+
+    bool create_fetch_bench_table(Odbc_Connection& odbc) {
+        odbc.execute("DROP TABLE bench_offers");
+        if (!odbc.execute("CREATE TABLE bench_offers (Offer_ID INTEGER, Name VARCHAR(100), Price_per_Person DECIMAL(10,2), "
+                          "Duration_Days INTEGER, Departure_Date DATE, Total_Seats INTEGER, Reserved_Seats INTEGER, "
+                          "Status VARCHAR(20), Date_Created TIMESTAMP, Description TEXT)")) {
+            return false;
+        }
+
+        SQLSetConnectAttr(odbc.hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+        bool inserted = true;
+        const std::string description(1200, 'd'); // Longer than the 1024-byte buffer the legacy loop truncates at
+        for (int i = 1; i <= FETCH_BENCH_ROWS && inserted; i++) {
+            inserted = odbc.execute("INSERT INTO bench_offers VALUES (" + std::to_string(i) + ", 'Offer " + std::to_string(i) +
+                                    "', " + std::to_string(100 + i % 900) + ".99, 7, '2026-07-01', 40, " + std::to_string(i % 40) +
+                                    ", 'active', '2026-01-15 10:30:00', '" + description + "')");
+        }
+        SQLEndTran(SQL_HANDLE_DBC, odbc.hdbc, inserted ? SQL_COMMIT : SQL_ROLLBACK);
+        SQLSetConnectAttr(odbc.hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+        return inserted;
+    }
+
+    // The fetch loop process_select_result used before rows were bound, kept here as the baseline
+    Database::Fetch_Stats legacy_fetch(SQLHSTMT hstmt) {
+        Database::Fetch_Stats stats;
+        SQLSMALLINT columns = 0;
+        SQLNumResultCols(hstmt, &columns);
+
+        std::vector<std::map<std::string, std::string>> rows;
+        while (true) {
+            stats.fetch_calls++;
+            if (SQLFetch(hstmt) != SQL_SUCCESS) {
+                break;
+            }
+            std::map<std::string, std::string> row;
+            for (SQLSMALLINT i = 1; i <= columns; i++) {
+                SQLCHAR data[1024];
+                SQLLEN indicator;
+                stats.get_data_calls++;
+                SQLRETURN ret = SQLGetData(hstmt, i, SQL_C_CHAR, data, sizeof(data), &indicator);
+                if (SQL_SUCCEEDED(ret) && indicator != SQL_NULL_DATA) {
+                    row[std::to_string(i)] = std::string(reinterpret_cast<char*>(data));
+                }
+            }
+            rows.push_back(row);
+            stats.rows++;
+        }
+        return stats;
+    }
+
+    struct Fetch_Result {
+        Database::Fetch_Stats stats;
+        double best_ms = 0.0;
+    };
+
+    // block_rows == 0 runs the legacy loop
+    Fetch_Result run_fetch(Odbc_Connection& odbc, const std::string& query, int block_rows) {
+        Fetch_Result result;
+        for (int run = 0; run < FETCH_BENCH_RUNS; run++) {
+            SQLHSTMT hstmt = SQL_NULL_HSTMT;
+            SQLAllocHandle(SQL_HANDLE_STMT, odbc.hdbc, &hstmt);
+            std::vector<char> sql(query.begin(), query.end());
+            sql.push_back('\0');
+
+            auto start = std::chrono::high_resolution_clock::now();
+            SQLExecDirectA(hstmt, reinterpret_cast<SQLCHAR*>(sql.data()), SQL_NTS);
+            Database::Fetch_Stats stats;
+            if (block_rows == 0) {
+                stats = legacy_fetch(hstmt);
+            }
+            else {
+                Database::Result_Set rows;
+                Database::Row_Fetcher fetcher(odbc.hdbc, hstmt, block_rows);
+                fetcher.fetch_all(rows);
+                stats = fetcher.get_stats();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (run == 0 || ms < result.best_ms) {
+                result.best_ms = ms;
+            }
+            result.stats = stats;
+        }
+        return result;
+    }
+}
+
+void benchmark_bulk_fetch() {
+    BenchUtils::print_header("BULK FETCH (" + std::to_string(FETCH_BENCH_ROWS) + " ROWS)");
+
+    // Any local ODBC driver works, SQLite ODBC keeps the numbers about the client side of the fetch
+    std::string connection_string = BenchUtils::get_env("AGENTIE_BENCH_ODBC",
+        "DRIVER={SQLite3 ODBC Driver};Database=agentie_bench.db;");
+
+    Odbc_Connection odbc;
+    if (!odbc.open(connection_string) || !create_fetch_bench_table(odbc)) {
+        std::cout << "  skipped: set AGENTIE_BENCH_ODBC to a usable ODBC connection string" << std::endl;
+        return;
+    }
+
+    const std::string narrow_query = "SELECT Offer_ID, Name, Price_per_Person, Duration_Days, Departure_Date, "
+                                     "Total_Seats, Reserved_Seats, Status, Date_Created FROM bench_offers";
+    const std::string text_query = "SELECT Offer_ID, Name, Price_per_Person, Duration_Days, Departure_Date, "
+                                   "Total_Seats, Reserved_Seats, Status, Date_Created, Description FROM bench_offers";
+
+    const std::pair<const char*, int> paths[] = {
+        { "per-column SQLGetData", 0 },
+        { "bound, 1 row/fetch", 1 },
+        { "bound, block fetch", Config::Database::FETCH_BLOCK_ROWS }
+    };
+    const std::pair<const char*, const std::string*> queries[] = {
+        { "no TEXT", &narrow_query },
+        { "TEXT last", &text_query }
+    };
+
+    std::cout << std::left << std::setw(12) << "query" << std::setw(24) << "path" << std::setw(10) << "rows"
+              << std::setw(14) << "calls/row" << "best (ms)" << std::endl;
+
+    for (const auto& query : queries) {
+        for (const auto& path : paths) {
+            Fetch_Result r = run_fetch(odbc, *query.second, path.second);
+            std::cout << std::left << std::setw(12) << query.first << std::setw(24) << path.first
+                      << std::setw(10) << r.stats.rows << std::setw(14) << std::fixed << std::setprecision(2)
+                      << r.stats.per_row() << std::setprecision(1) << r.best_ms << std::endl;
+        }
+    }
+
+    odbc.execute("DROP TABLE bench_offers");
+}
+
+// ============================================================================
+// Offer search: in-memory indexes vs the LIKE query
+// ============================================================================
+
+namespace {
+    constexpr int SEARCH_BENCH_OFFERS = 100000;
+    constexpr int SEARCH_BENCH_INDEX_RUNS = 200;
+    constexpr int SEARCH_BENCH_SQL_RUNS = 5;
+
+    struct Search_Case {
+        const char* label;
+        Database::Offer_Search_Criteria criteria;
+    };
+
+    std::vector<Search_Case> make_search_cases() {
+        std::vector<Search_Case> cases(5);
+        cases[0].label = "destination";
+        cases[0].criteria.destination = "rom";
+        cases[1].label = "dest + price";
+        cases[1].criteria.destination = "ital";
+        cases[1].criteria.min_price = 500;
+        cases[1].criteria.max_price = 900;
+        cases[2].label = "dest + dates";
+        cases[2].criteria.destination = "grec";
+        cases[2].criteria.start_date = "2027-05-01";
+        cases[2].criteria.end_date = "2027-08-01";
+        cases[3].label = "one city";
+        cases[3].criteria.destination = "Paris 42";
+        cases[4].label = "price only";
+        cases[4].criteria.min_price = 1000;
+        cases[4].criteria.max_price = 1100;
+        return cases;
+    }
+
+    // Deterministic offers over 6 countries and 3000 destinations, dates spread over a year
+    std::vector<Database::Indexed_Offer> make_search_offers() {
+        const char* cities[] = { "Paris", "Roma", "Barcelona", "Brasov", "Londra", "Atena" };
+        const char* countries[] = { "Franta", "Italia", "Spania", "Romania", "Marea Britanie", "Grecia" };
+
+        std::vector<Database::Indexed_Offer> offers;
+        offers.reserve(SEARCH_BENCH_OFFERS);
+        for (int i = 1; i <= SEARCH_BENCH_OFFERS; i++) {
+            int day = (i * 7919) % 336;
+            char departure[16];
+            char return_date[16];
+            snprintf(departure, sizeof(departure), "2027-%02d-%02d", 1 + day / 28, 1 + day % 28);
+            snprintf(return_date, sizeof(return_date), "2027-%02d-%02d", 1 + (day / 28 + 1) % 12, 1 + day % 28);
+
+            Database::Indexed_Offer offer;
+            offer.offer_id = i;
+            offer.price = 100 + (i * 104729) % 2000;
+            offer.departure_date = departure;
+            offer.return_date = return_date;
+            offer.destination_name = std::string(cities[i % 6]) + " " + std::to_string(i % 500);
+            offer.country = countries[i % 6];
+
+            nlohmann::json row;
+            row["Offer_ID"] = std::to_string(i);
+            row["Name"] = "Offer " + std::to_string(i);
+            row["Price_per_Person"] = std::to_string(static_cast<int>(offer.price)) + ".00";
+            row["Departure_Date"] = offer.departure_date;
+            row["Return_Date"] = offer.return_date;
+            row["Destination_Name"] = offer.destination_name;
+            row["Country"] = offer.country;
+            offer.row_json = std::make_shared<const std::string>(row.dump());
+            offers.push_back(std::move(offer));
+        }
+        return offers;
+    }
+
+    // Same predicates as Database_Manager::search_offers, over the benchmark table
+    std::string build_search_sql(const Database::Offer_Search_Criteria& criteria) {
+        std::string sql = "SELECT Offer_ID, Name, Price_per_Person, Departure_Date, Return_Date, Destination_Name, Country "
+                          "FROM bench_search_offers WHERE 1 = 1";
+        if (!criteria.destination.empty()) {
+            sql += " AND (Destination_Name LIKE '%" + criteria.destination + "%' OR Country LIKE '%" + criteria.destination + "%')";
+        }
+        if (criteria.min_price > 0) {
+            sql += " AND Price_per_Person >= " + std::to_string(criteria.min_price);
+        }
+        if (criteria.max_price > 0) {
+            sql += " AND Price_per_Person <= " + std::to_string(criteria.max_price);
+        }
+        if (!criteria.start_date.empty()) {
+            sql += " AND Departure_Date >= '" + criteria.start_date + "'";
+        }
+        if (!criteria.end_date.empty()) {
+            sql += " AND Return_Date <= '" + criteria.end_date + "'";
+        }
+        return sql + " ORDER BY Departure_Date";
+    }
+
+    bool create_search_bench_table(Odbc_Connection& odbc, const std::vector<Database::Indexed_Offer>& offers) {
+        odbc.execute("DROP TABLE bench_search_offers");
+        if (!odbc.execute("CREATE TABLE bench_search_offers (Offer_ID INTEGER, Name VARCHAR(100), Price_per_Person DECIMAL(10,2), "
+                          "Departure_Date DATE, Return_Date DATE, Destination_Name VARCHAR(100), Country VARCHAR(100))") ||
+            !odbc.execute("CREATE INDEX IX_Bench_Search_Price ON bench_search_offers(Price_per_Person)") ||
+            !odbc.execute("CREATE INDEX IX_Bench_Search_Departure ON bench_search_offers(Departure_Date)")) {
+            return false;
+        }
+
+        SQLSetConnectAttr(odbc.hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+        bool inserted = true;
+        for (size_t i = 0; i < offers.size() && inserted; i++) {
+            const Database::Indexed_Offer& offer = offers[i];
+            inserted = odbc.execute("INSERT INTO bench_search_offers VALUES (" + std::to_string(offer.offer_id) +
+                                    ", 'Offer " + std::to_string(offer.offer_id) + "', " + std::to_string(offer.price) +
+                                    ", '" + offer.departure_date + "', '" + offer.return_date + "', '" +
+                                    offer.destination_name + "', '" + offer.country + "')");
+        }
+        SQLEndTran(SQL_HANDLE_DBC, odbc.hdbc, inserted ? SQL_COMMIT : SQL_ROLLBACK);
+        SQLSetConnectAttr(odbc.hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+        return inserted;
+    }
+
+    double run_sql_search(Odbc_Connection& odbc, const std::string& query, size_t& rows) {
+        std::vector<double> samples;
+        for (int run = 0; run < SEARCH_BENCH_SQL_RUNS; run++) {
+            SQLHSTMT hstmt = SQL_NULL_HSTMT;
+            SQLAllocHandle(SQL_HANDLE_STMT, odbc.hdbc, &hstmt);
+            std::vector<char> sql(query.begin(), query.end());
+            sql.push_back('\0');
+
+            auto start = std::chrono::high_resolution_clock::now();
+            SQLExecDirectA(hstmt, reinterpret_cast<SQLCHAR*>(sql.data()), SQL_NTS);
+            Database::Result_Set result;
+            {
+                Database::Row_Fetcher fetcher(odbc.hdbc, hstmt);
+                fetcher.fetch_all(result);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+
+            rows = result.size();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return BenchUtils::percentile(samples, 50);
+    }
+}
+
+void benchmark_offer_search() {
+    BenchUtils::print_header("OFFER SEARCH (" + std::to_string(SEARCH_BENCH_OFFERS) + " OFFERS)");
+
+    std::vector<Database::Indexed_Offer> offers = make_search_offers();
+    auto build_start = std::chrono::high_resolution_clock::now();
+    Database::Offer_Index index(offers);
+    auto build_end = std::chrono::high_resolution_clock::now();
+    std::cout << "  index build: " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(build_end - build_start).count() << " ms" << std::endl;
+
+    // The SQL side is optional, it needs a local ODBC driver like the bulk fetch benchmark
+    std::string connection_string = BenchUtils::get_env("AGENTIE_BENCH_ODBC",
+        "DRIVER={SQLite3 ODBC Driver};Database=agentie_bench.db;");
+    Odbc_Connection odbc;
+    bool has_sql = odbc.open(connection_string) && create_search_bench_table(odbc, offers);
+    if (!has_sql) {
+        std::cout << "  SQL path skipped: set AGENTIE_BENCH_ODBC to a usable ODBC connection string" << std::endl;
+    }
+
+    std::cout << std::left << std::setw(16) << "query" << std::setw(10) << "matches" << std::setw(14) << "match p50"
+              << std::setw(14) << "search p50" << std::setw(14) << "search p99" << "SQL p50 (ms)" << std::endl;
+
+    for (const Search_Case& test_case : make_search_cases()) {
+        std::vector<double> match_samples;
+        std::vector<double> search_samples;
+        size_t matches = 0;
+        for (int run = 0; run < SEARCH_BENCH_INDEX_RUNS; run++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            Database::Offer_Bitmap bitmap = index.match(test_case.criteria);
+            auto matched = std::chrono::high_resolution_clock::now();
+            std::string json = index.search(test_case.criteria, &matches);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            match_samples.push_back(std::chrono::duration<double, std::milli>(matched - start).count());
+            search_samples.push_back(std::chrono::duration<double, std::milli>(end - matched).count());
+        }
+
+        std::cout << std::left << std::setw(16) << test_case.label << std::setw(10) << matches << std::fixed
+                  << std::setprecision(3) << std::setw(14) << BenchUtils::percentile(match_samples, 50)
+                  << std::setw(14) << BenchUtils::percentile(search_samples, 50)
+                  << std::setw(14) << BenchUtils::percentile(search_samples, 99);
+        if (has_sql) {
+            size_t sql_rows = 0;
+            double sql_ms = run_sql_search(odbc, build_search_sql(test_case.criteria), sql_rows);
+            std::cout << std::setprecision(1) << sql_ms << (sql_rows == matches ? "" : " (row count differs)");
+        }
+        else {
+            std::cout << "-";
+        }
+        std::cout << std::endl;
+    }
+
+    if (has_sql) {
+        odbc.execute("DROP TABLE bench_search_offers");
+    }
+}
+
+// ============================================================================
+// Response serialization: DOM + re-parse vs single-pass writer
+// ============================================================================
+
+namespace {
+    constexpr int SERIALIZE_BENCH_RUNS = 20;
+
+    // Columns of the offers query, typed the way Row_Fetcher stores them
+    Database::Result_Set make_offer_rows(int rows) {
+        using Database::Column_Type;
+        Database::Result_Set result;
+        size_t id = result.add_column("Offer_ID", Column_Type::INT);
+        size_t name = result.add_column("Name", Column_Type::STRING);
+        size_t price = result.add_column("Price_per_Person", Column_Type::DOUBLE, 2);
+        size_t days = result.add_column("Duration_Days", Column_Type::INT);
+        size_t departure = result.add_column("Departure_Date", Column_Type::DATE);
+        size_t seats = result.add_column("Available_Seats", Column_Type::INT);
+        size_t destination = result.add_column("Destination_Name", Column_Type::STRING);
+        size_t description = result.add_column("Description", Column_Type::STRING);
+        size_t created = result.add_column("Date_Created", Column_Type::TIMESTAMP, 3);
+
+        result.reserve(rows);
+        for (int i = 1; i <= rows; i++) {
+            std::string offer_name = "Offer " + std::to_string(i);
+            std::string city = std::string("Paris ") + std::to_string(i % 500);
+            std::string text = "Sejur \"all inclusive\" cu mic dejun, transfer si ghid local - oferta " + std::to_string(i);
+            SQL_TIMESTAMP_STRUCT date{};
+            date.year = 2027;
+            date.month = static_cast<SQLUSMALLINT>(1 + i % 12);
+            date.day = static_cast<SQLUSMALLINT>(1 + i % 28);
+
+            result.append_int(id, i);
+            result.append_string(name, offer_name.data(), offer_name.size());
+            result.append_double(price, 100.0 + (i * 104729) % 2000);
+            result.append_int(days, 3 + i % 11);
+            result.append_date(departure, date);
+            result.append_int(seats, i % 40);
+            result.append_string(destination, city.data(), city.size());
+            result.append_string(description, text.data(), text.size());
+            result.append_date(created, date);
+            result.end_row();
+        }
+        return result;
+    }
+
+    // What a response cost before: rows into a DOM, dumped, parsed again into the envelope, dumped again
+    std::string serialize_with_dom(const Database::Result_Set& rows) {
+        nlohmann::json json_array = nlohmann::json::array();
+        for (const auto& row : rows) {
+            nlohmann::json json_obj = nlohmann::json::object();
+            for (size_t i = 0; i < row.column_count(); i++) {
+                json_obj[row.column_name(i)] = row.get_string(i);
+            }
+            json_array.push_back(std::move(json_obj));
+        }
+        std::string body = Utils::JSON::create_success_response(json_array.dump(), Config::SuccessMessages::DATA_RETRIEVED);
+        return SocketNetwork::encode_frame(SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header(), body);
+    }
+}
+
+void benchmark_response_serialization() {
+    BenchUtils::print_header("RESPONSE SERIALIZATION");
+
+    std::cout << std::left << std::setw(10) << "rows" << std::setw(12) << "bytes" << std::setw(14) << "DOM p50"
+              << std::setw(14) << "writer p50" << std::setw(12) << "speedup" << "identical" << std::endl;
+
+    for (int rows : { 100, 10000, 100000 }) {
+        auto result = std::make_shared<const Database::Result_Set>(make_offer_rows(rows));
+        SocketNetwork::Response response(true, Config::SuccessMessages::DATA_RETRIEVED);
+        response.rows = result;
+
+        // One writer for all runs, like a connection reusing its buffer
+        SocketNetwork::Response_Writer writer;
+        std::vector<double> dom_samples;
+        std::vector<double> writer_samples;
+        std::string dom_output;
+        size_t writer_bytes = 0;
+        bool is_identical = true;
+        for (int run = 0; run < SERIALIZE_BENCH_RUNS; run++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            dom_output = serialize_with_dom(*result);
+            auto dom_end = std::chrono::high_resolution_clock::now();
+            const std::string& written = writer.write(response, SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header());
+            auto end = std::chrono::high_resolution_clock::now();
+
+            writer_bytes = written.size();
+            is_identical = is_identical && written == dom_output;
+            dom_samples.push_back(std::chrono::duration<double, std::milli>(dom_end - start).count());
+            writer_samples.push_back(std::chrono::duration<double, std::milli>(end - dom_end).count());
+        }
+
+        double dom_ms = BenchUtils::percentile(dom_samples, 50);
+        double writer_ms = BenchUtils::percentile(writer_samples, 50);
+        std::cout << std::left << std::setw(10) << rows << std::setw(12) << writer_bytes << std::fixed << std::setprecision(3)
+                  << std::setw(14) << dom_ms << std::setw(14) << writer_ms << std::setprecision(1)
+                  << std::setw(12) << (writer_ms > 0.0 ? dom_ms / writer_ms : 0.0) << (is_identical ? "yes" : "NO") << std::endl;
+    }
+}
+
+// ============================================================================
+// 10k-offer GET_OFFERS over a slow link: plain vs zstd vs zstd with the offer dictionary
+// ============================================================================
+
+namespace {
+    constexpr int COMPRESSION_BENCH_ROWS = 10000;
+    constexpr double SLOW_LINK_RTT_MS = 80.0;
+
+    struct Simulated_Link {
+        const char* name;
+        double megabits_per_second;
+    };
+
+    // Serialization on the server, then compression, the wire and decompression on the client
+    double link_latency_ms(size_t wire_bytes, double work_ms, const Simulated_Link& link) {
+        double transfer_ms = wire_bytes * 8.0 / (link.megabits_per_second * 1000.0);
+        return work_ms + SLOW_LINK_RTT_MS + transfer_ms;
+    }
+}
+
+void benchmark_compressed_offers() {
+    BenchUtils::print_header("COMPRESSED OFFER RESPONSES (" + std::to_string(COMPRESSION_BENCH_ROWS) + " rows)");
+
+    auto result = std::make_shared<const Database::Result_Set>(make_offer_rows(COMPRESSION_BENCH_ROWS));
+    SocketNetwork::Response response(true, Config::SuccessMessages::DATA_RETRIEVED);
+    response.rows = result;
+    SocketNetwork::Response_Writer writer;
+    const std::string wire = writer.write(response, SocketNetwork::Framing_Mode::BINARY, SocketNetwork::Frame_Header());
+    const char* payload = wire.data() + SocketNetwork::FRAME_HEADER_SIZE;
+    const size_t payload_size = wire.size() - SocketNetwork::FRAME_HEADER_SIZE;
+
+    const Simulated_Link links[] = { { "2 Mbit/s", 2.0 }, { "10 Mbit/s", 10.0 }, { "50 Mbit/s", 50.0 } };
+
+    std::cout << std::left << std::setw(14) << "payload" << std::setw(12) << "bytes" << std::setw(8) << "ratio"
+              << std::setw(14) << "compress p50" << std::setw(14) << "inflate p50";
+    for (const auto& link : links) {
+        std::cout << std::setw(14) << link.name;
+    }
+    std::cout << "intact" << std::endl;
+
+    for (int mode = 0; mode < 3; mode++) {
+        const bool is_compressed = mode > 0;
+        const bool use_dictionary = mode == 2;
+        SocketNetwork::Payload_Compressor compressor(use_dictionary);
+        std::vector<double> compress_samples;
+        std::vector<double> inflate_samples;
+        size_t wire_bytes = payload_size;
+        bool is_intact = true;
+
+        for (int run = 0; is_compressed && run < SERIALIZE_BENCH_RUNS; run++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            const std::string* packed = compressor.compress(payload, payload_size);
+            auto packed_end = std::chrono::high_resolution_clock::now();
+            std::string inflated;
+            bool is_inflated = packed && SocketNetwork::Payload_Compressor::decompress(packed->data(), packed->size(),
+                use_dictionary, payload_size, inflated);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            wire_bytes = packed ? packed->size() : payload_size;
+            is_intact = is_intact && is_inflated && inflated.size() == payload_size &&
+                        inflated.compare(0, payload_size, payload, payload_size) == 0;
+            compress_samples.push_back(std::chrono::duration<double, std::milli>(packed_end - start).count());
+            inflate_samples.push_back(std::chrono::duration<double, std::milli>(end - packed_end).count());
+        }
+
+        double compress_ms = is_compressed ? BenchUtils::percentile(compress_samples, 50) : 0.0;
+        double inflate_ms = is_compressed ? BenchUtils::percentile(inflate_samples, 50) : 0.0;
+        wire_bytes += SocketNetwork::FRAME_HEADER_SIZE;
+        std::cout << std::left << std::setw(14) << (mode == 0 ? "plain" : mode == 1 ? "zstd" : "zstd+dict")
+                  << std::setw(12) << wire_bytes << std::fixed << std::setprecision(2)
+                  << std::setw(8) << static_cast<double>(wire.size()) / wire_bytes << std::setprecision(3)
+                  << std::setw(14) << compress_ms << std::setw(14) << inflate_ms << std::setprecision(1);
+        for (const auto& link : links) {
+            std::cout << std::setw(14) << link_latency_ms(wire_bytes, compress_ms + inflate_ms, link);
+        }
+        std::cout << (is_intact ? "yes" : "NO") << std::endl;
+    }
+    std::cout << "Link columns: end-to-end ms with " << SLOW_LINK_RTT_MS << " ms RTT, serialization excluded" << std::endl;
+}
+
+// ============================================================================
+// Request latency with logging: off vs synchronous vs asynchronous
+// ============================================================================
+
+namespace {
+    constexpr int LOGGING_BENCH_THREADS = 8;
+    constexpr int LOGGING_BENCH_REQUESTS = 20000; // Per thread
+
+    // A request's own work (parse, respond) plus the three INFO lines a handler writes
+    std::vector<double> run_logged_requests() {
+        std::vector<std::vector<double>> thread_samples(LOGGING_BENCH_THREADS);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < LOGGING_BENCH_THREADS; t++) {
+            threads.emplace_back([t, &thread_samples]() {
+                SocketNetwork::Protocol_Handler handler(nullptr);
+                SocketNetwork::Response_Writer writer;
+                SocketNetwork::Response response(true, Config::SuccessMessages::LOGIN_SUCCESS,
+                    "{\"user_id\":42,\"username\":\"bench_user\"}");
+                response.data_is_json = true;
+                std::string client = "127.0.0.1:" + std::to_string(50000 + t);
+                auto& samples = thread_samples[t];
+                samples.reserve(LOGGING_BENCH_REQUESTS);
+
+                for (int i = 0; i < LOGGING_BENCH_REQUESTS; i++) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    std::string request = "{\"type\":\"AUTH\",\"request_id\":" + std::to_string(i + 1) +
+                        ",\"data\":{\"username\":\"bench_user\",\"password\":\"secret\"}}";
+                    Utils::Logger::info("Received message from " + client + ": " + std::to_string(request.size()) + " bytes");
+                    auto parsed = handler.parse_message(request);
+                    Utils::Logger::info("Processing AUTH request " + std::to_string(parsed.request_id) + " from " + client);
+                    response.request_id = parsed.request_id;
+                    const std::string& wire = writer.write(response, SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header());
+                    Utils::Logger::info("Sent " + std::to_string(wire.size()) + " bytes to " + client);
+                    auto end = std::chrono::high_resolution_clock::now();
+                    samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<double> samples;
+        for (const auto& part : thread_samples) {
+            samples.insert(samples.end(), part.begin(), part.end());
+        }
+        return samples;
+    }
+}
+
+void benchmark_logging_latency() {
+    BenchUtils::print_header("REQUEST LATENCY WITH LOGGING");
+    std::cout << LOGGING_BENCH_THREADS << " threads x " << LOGGING_BENCH_REQUESTS
+              << " requests, 3 INFO lines each, file output only" << std::endl;
+
+    Utils::Logger::initialize_logging();
+    Utils::Logger::enable_console_logging(false);
+    Utils::Logger::enable_file_logging(true);
+
+    struct Mode {
+        const char* name;
+        Utils::Logger::Level level;
+        bool is_async;
+    };
+    const Mode modes[] = {
+        { "INFO off", Utils::Logger::Level::WARNING, true },
+        { "INFO sync", Utils::Logger::Level::INFO, false },
+        { "INFO async", Utils::Logger::Level::INFO, true },
+    };
+
+    std::cout << std::left << std::setw(14) << "mode" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+              << std::setw(12) << "max us" << "dropped" << std::endl;
+
+    for (const auto& mode : modes) {
+        Utils::Logger::enable_async_logging(mode.is_async);
+        Utils::Logger::set_log_level(mode.level);
+        uint64_t dropped_before = Utils::Logger::get_dropped_log_count();
+
+        auto samples = run_logged_requests();
+        Utils::Logger::flush_logs();
+
+        std::cout << std::left << std::setw(14) << mode.name << std::fixed << std::setprecision(2)
+                  << std::setw(12) << BenchUtils::percentile(samples, 50) << std::setw(12) << BenchUtils::percentile(samples, 99)
+                  << std::setw(12) << BenchUtils::percentile(samples, 100)
+                  << (Utils::Logger::get_dropped_log_count() - dropped_before) << std::endl;
+    }
+
+    Utils::Logger::set_log_level(Utils::Logger::Level::DEBUG);
+    Utils::Logger::enable_console_logging(true);
+    Utils::Logger::shutdown_logging();
+}
+
+// ============================================================================
+// Booking contention: statement-by-statement transaction vs sp_Book_Offer,
+// with and without the in-memory seat counters
+// ============================================================================
+
+namespace {
+    constexpr int BOOKING_BENCH_THREADS = 32;
+    constexpr int BOOKING_BENCH_ATTEMPTS = 50; // Per thread
+    constexpr int BOOKING_BENCH_PERSONS = 2;
+
+    struct Booking_Result {
+        int booked = 0;
+        int sold_out = 0;
+        int errors = 0;
+        double seconds = 0.0;
+        std::vector<double> latencies_ms;
+    };
+
+    Booking_Result run_booking_contention(std::shared_ptr<Database::Database_Manager> db, int user_id, int offer_id) {
+        std::vector<Reservation_Person_Data> persons(BOOKING_BENCH_PERSONS);
+        for (int i = 0; i < BOOKING_BENCH_PERSONS; i++) {
+            persons[i].full_name = "Bench Traveler " + std::to_string(i + 1);
+            persons[i].cnp = "190010112345" + std::to_string(i);
+            persons[i].birth_date = "1990-01-01";
+            persons[i].person_type = "adult";
+        }
+
+        std::atomic<int> booked(0), sold_out(0), errors(0);
+        std::vector<std::vector<double>> thread_samples(BOOKING_BENCH_THREADS);
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < BOOKING_BENCH_THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < BOOKING_BENCH_ATTEMPTS; i++) {
+                    auto begin = std::chrono::high_resolution_clock::now();
+                    try {
+                        auto result = db->book_offer(user_id, offer_id, BOOKING_BENCH_PERSONS, persons);
+                        if (result.is_success()) {
+                            booked++;
+                        } else if (result.type == Database::Result_Type::ERROR_CONSTRAINT) {
+                            sold_out++;
+                        } else {
+                            errors++;
+                        }
+                    }
+                    catch (const std::exception&) {
+                        errors++; // Deadlock victims and timeouts
+                    }
+                    auto end = std::chrono::high_resolution_clock::now();
+                    thread_samples[t].push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        Booking_Result result;
+        result.booked = booked.load();
+        result.sold_out = sold_out.load();
+        result.errors = errors.load();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        for (const auto& part : thread_samples) {
+            result.latencies_ms.insert(result.latencies_ms.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+
+    void delete_bench_reservations(Database::Database_Manager& db, int user_id, int offer_id) {
+        db.execute_prepared("DELETE FROM Reservation_Persons WHERE Reservation_ID IN "
+                            "(SELECT Reservation_ID FROM Reservations WHERE Offer_ID = ? AND User_ID = ?)", { offer_id, user_id });
+        db.execute_prepared("DELETE FROM Reservations WHERE Offer_ID = ? AND User_ID = ?", { offer_id, user_id });
+    }
+}
+
+void benchmark_booking_contention() {
+    BenchUtils::print_header("BOOKING CONTENTION (" + std::to_string(BOOKING_BENCH_THREADS) + " THREADS, ONE OFFER)");
+
+    // Rewrites the offer's seats and deletes the bench user's reservations on it, use a scratch offer
+    int offer_id = std::atoi(BenchUtils::get_env("AGENTIE_BENCH_OFFER_ID", "0").c_str());
+    int user_id = std::atoi(BenchUtils::get_env("AGENTIE_BENCH_USER_ID", "1").c_str());
+    if (offer_id <= 0) {
+        std::cout << "  skipped: set AGENTIE_BENCH_OFFER_ID to a scratch offer" << std::endl;
+        return;
+    }
+
+    Database::Pool_Config pool_config;
+    pool_config.min_size = BOOKING_BENCH_THREADS;
+    pool_config.max_size = BOOKING_BENCH_THREADS;
+    pool_config.acquire_timeout_ms = 60000;
+    auto db = BenchUtils::connect_bench_database(pool_config);
+    if (!db) {
+        return;
+    }
+
+    auto original = db->execute_prepared("SELECT Total_Seats, Reserved_Seats FROM Offers WHERE Offer_ID = ?", { offer_id });
+    if (!original.has_data()) {
+        std::cout << "  skipped: offer " << offer_id << " not found" << std::endl;
+        return;
+    }
+
+    // Room for half the attempts, so the second half runs against a sold out offer
+    const int attempts = BOOKING_BENCH_THREADS * BOOKING_BENCH_ATTEMPTS;
+    const int total_seats = attempts * BOOKING_BENCH_PERSONS / 2;
+    std::cout << attempts << " bookings of " << BOOKING_BENCH_PERSONS << " persons for "
+              << total_seats << " seats" << std::endl;
+    std::cout << std::left << std::setw(14) << "path" << std::setw(10) << "booked" << std::setw(10) << "sold out"
+              << std::setw(10) << "errors" << std::setw(12) << "booked/s" << std::setw(10) << "p50 ms"
+              << std::setw(10) << "p99 ms" << "seats" << std::endl;
+
+    struct Mode {
+        const char* name;
+        bool use_procedure;
+        bool use_seat_counters;
+    };
+    const Mode modes[] = {
+        { "statements", false, false },
+        { "procedure", true, false },
+        { "proc+counter", true, true },
+    };
+
+    for (const auto& mode : modes) {
+        delete_bench_reservations(*db, user_id, offer_id);
+        db->execute_prepared("UPDATE Offers SET Reserved_Seats = 0, Total_Seats = ? WHERE Offer_ID = ?", { total_seats, offer_id });
+        db->set_use_booking_procedure(mode.use_procedure);
+        db->set_use_seat_counters(mode.use_seat_counters);
+        if (auto counters = db->get_seat_counters()) {
+            counters->reconcile();
+        }
+
+        Booking_Result r = run_booking_contention(db, user_id, offer_id);
+
+        // Every booked reservation must be counted exactly once
+        auto seats = db->execute_prepared("SELECT Reserved_Seats FROM Offers WHERE Offer_ID = ?", { offer_id });
+        int reserved = seats.has_data() ? Utils::Conversion::string_to_int(seats.data[0]["Reserved_Seats"]) : -1;
+
+        std::cout << std::left << std::setw(14) << mode.name << std::setw(10) << r.booked << std::setw(10) << r.sold_out
+                  << std::setw(10) << r.errors << std::setw(12) << std::fixed << std::setprecision(0)
+                  << (r.seconds > 0 ? r.booked / r.seconds : 0.0) << std::setprecision(2)
+                  << std::setw(10) << BenchUtils::percentile(r.latencies_ms, 50)
+                  << std::setw(10) << BenchUtils::percentile(r.latencies_ms, 99)
+                  << (reserved == r.booked * BOOKING_BENCH_PERSONS ? "ok" : "MISMATCH " + std::to_string(reserved)) << std::endl;
+    }
+
+    delete_bench_reservations(*db, user_id, offer_id);
+    db->execute_prepared("UPDATE Offers SET Total_Seats = ?, Reserved_Seats = ? WHERE Offer_ID = ?",
+                         { Utils::Conversion::string_to_int(original.data[0]["Total_Seats"]),
+                           Utils::Conversion::string_to_int(original.data[0]["Reserved_Seats"]), offer_id });
+    db->set_use_booking_procedure(Config::Database::USE_BOOKING_PROCEDURE);
+    db->set_use_seat_counters(Config::Database::USE_SEAT_COUNTERS);
+}
+
+// ============================================================================
+// Login: two queries + per-call digest context vs one fetch + in-process check
+// ============================================================================
+
+namespace {
+    constexpr int LOGIN_BENCH_THREADS = 16;
+    constexpr int LOGIN_BENCH_ATTEMPTS = 200; // Per thread
+    constexpr int HASH_BENCH_THREADS = 8;
+    constexpr int HASH_BENCH_HASHES = 50000; // Per thread
+
+    // hash_password as it was: fresh EVP_MD_CTX, concatenated input, ostringstream hex
+    std::string legacy_hash_password(const std::string& password, const std::string& salt) {
+        std::string salted_password = password + salt;
+        EVP_MD_CTX* mdctx = EVP_MD_CTX_new();
+        unsigned char md_value[EVP_MAX_MD_SIZE];
+        unsigned int md_len = 0;
+        EVP_DigestInit_ex(mdctx, EVP_sha256(), NULL);
+        EVP_DigestUpdate(mdctx, salted_password.c_str(), salted_password.length());
+        EVP_DigestFinal_ex(mdctx, md_value, &md_len);
+        EVP_MD_CTX_free(mdctx);
+
+        std::ostringstream oss;
+        for (unsigned int i = 0; i < md_len; ++i)
+            oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(md_value[i]);
+        return oss.str();
+    }
+
+    // authenticate_user as it was: the salt, then a second query comparing the hash in SQL
+    bool legacy_authenticate(Database::Database_Manager& db, const std::string& username, const std::string& password) {
+        auto salt = db.execute_prepared("SELECT Password_Salt FROM Users WHERE Username = ?", { username });
+        if (!salt.is_success() || salt.data.empty()) {
+            return false;
+        }
+        auto user = db.execute_prepared("SELECT User_ID, Username, Email, First_Name, Last_Name, Phone FROM Users "
+                                        "WHERE Username = ? AND Password_Hash = ?",
+                                        { username, legacy_hash_password(password, salt.data[0]["Password_Salt"]) });
+        return user.is_success() && !user.data.empty();
+    }
+
+    double run_hash_throughput(bool use_legacy) {
+        std::vector<std::thread> threads;
+        std::atomic<size_t> checksum(0); // Keeps the digests from being optimized away
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < HASH_BENCH_THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                std::string salt = "salt" + std::to_string(t);
+                size_t local = 0;
+                for (int i = 0; i < HASH_BENCH_HASHES; i++) {
+                    std::string password = "password" + std::to_string(i);
+                    local += (use_legacy ? legacy_hash_password(password, salt) : Utils::Crypto::hash_password(password, salt))[0];
+                }
+                checksum += local;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return seconds > 0 ? HASH_BENCH_THREADS * HASH_BENCH_HASHES / seconds : 0.0;
+    }
+
+    struct Login_Result {
+        int accepted = 0;
+        double seconds = 0.0;
+        std::vector<double> latencies_ms;
+    };
+
+    // unknown_names > 0 logs in as that many made-up users instead of the real one
+    Login_Result run_logins(Database::Database_Manager& db, bool use_legacy, const std::string& username,
+                            const std::string& password, int unknown_names) {
+        std::atomic<int> accepted(0);
+        std::vector<std::vector<double>> thread_samples(LOGIN_BENCH_THREADS);
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < LOGIN_BENCH_THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < LOGIN_BENCH_ATTEMPTS; i++) {
+                    std::string name = unknown_names > 0 ? "nobody_" + std::to_string((t * LOGIN_BENCH_ATTEMPTS + i) % unknown_names) : username;
+                    auto begin = std::chrono::high_resolution_clock::now();
+                    bool is_accepted = use_legacy ? legacy_authenticate(db, name, password)
+                                                  : db.authenticate_user(name, password).has_data();
+                    auto end = std::chrono::high_resolution_clock::now();
+                    if (is_accepted) {
+                        accepted++;
+                    }
+                    thread_samples[t].push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        Login_Result result;
+        result.accepted = accepted.load();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        for (const auto& part : thread_samples) {
+            result.latencies_ms.insert(result.latencies_ms.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+}
+
+void benchmark_login_throughput() {
+    BenchUtils::print_header("LOGIN THROUGHPUT");
+
+    std::cout << HASH_BENCH_THREADS << " threads hashing, no database" << std::endl;
+    std::cout << std::left << std::setw(16) << "hash" << "hashes/s" << std::endl;
+    std::cout << std::left << std::setw(16) << "legacy" << std::fixed << std::setprecision(0) << run_hash_throughput(true) << std::endl;
+    std::cout << std::left << std::setw(16) << "thread ctx" << std::fixed << std::setprecision(0) << run_hash_throughput(false) << std::endl;
+
+    // An account registered in the bench database through the server, so its hash matches
+    std::string username = BenchUtils::get_env("AGENTIE_BENCH_LOGIN_USER", "");
+    std::string password = BenchUtils::get_env("AGENTIE_BENCH_LOGIN_PASSWORD", "");
+    if (username.empty() || password.empty()) {
+        std::cout << "  logins skipped: set AGENTIE_BENCH_LOGIN_USER and AGENTIE_BENCH_LOGIN_PASSWORD" << std::endl;
+        return;
+    }
+
+    Database::Pool_Config pool_config;
+    pool_config.min_size = LOGIN_BENCH_THREADS;
+    pool_config.max_size = LOGIN_BENCH_THREADS;
+    auto db = BenchUtils::connect_bench_database(pool_config);
+    if (!db) {
+        return;
+    }
+
+    std::cout << "\n" << LOGIN_BENCH_THREADS << " threads x " << LOGIN_BENCH_ATTEMPTS << " logins" << std::endl;
+    std::cout << std::left << std::setw(24) << "path" << std::setw(10) << "accepted" << std::setw(12) << "logins/s"
+              << std::setw(10) << "p50 ms" << "p99 ms" << std::endl;
+
+    struct Mode {
+        const char* name;
+        bool use_legacy;
+        int unknown_names;
+    };
+    const Mode modes[] = {
+        { "two queries", true, 0 },
+        { "one fetch", false, 0 },
+        { "unknown, two queries", true, 100 },
+        { "unknown, cached", false, 100 },
+    };
+    for (const auto& mode : modes) {
+        Login_Result r = run_logins(*db, mode.use_legacy, username, password, mode.unknown_names);
+        std::cout << std::left << std::setw(24) << mode.name << std::setw(10) << r.accepted << std::setw(12)
+                  << std::fixed << std::setprecision(0) << (r.seconds > 0 ? r.latencies_ms.size() / r.seconds : 0.0)
+                  << std::setprecision(3) << std::setw(10) << BenchUtils::percentile(r.latencies_ms, 50)
+                  << BenchUtils::percentile(r.latencies_ms, 99) << std::endl;
+    }
+}
+
+// ============================================================================
+// Reconnect: connect + AUTH vs connect + RESUME_SESSION until the first answer
+// ============================================================================
+
+namespace {
+    constexpr int RECONNECT_BENCH_PORT = BENCH_BASE_PORT + 100;
+    constexpr int RECONNECT_BENCH_SAMPLES = 500;
+
+    // Sends one text line and reads until the reply's newline
+    bool text_round_trip(SOCKET s, const std::string& request, std::string& reply) {
+        std::string line = request + "\r\n";
+        if (send(s, line.c_str(), static_cast<int>(line.size()), 0) == SOCKET_ERROR) {
+            return false;
+        }
+
+        reply.clear();
+        char buffer[1024];
+        while (reply.find('\n') == std::string::npos) {
+            int received = recv(s, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            reply.append(buffer, received);
+        }
+        return reply.find("\"success\":true") != std::string::npos;
+    }
+
+    // Milliseconds from connect() to the authenticated reply, one fresh connection per sample
+    std::vector<double> run_reconnects(int port, const std::string& request) {
+        std::vector<double> samples;
+        for (int i = 0; i < RECONNECT_BENCH_SAMPLES; i++) {
+            std::string reply;
+            auto start = std::chrono::high_resolution_clock::now();
+            SOCKET s = open_client_connection(port, i);
+            bool is_ready = s != INVALID_SOCKET && text_round_trip(s, request, reply);
+            auto end = std::chrono::high_resolution_clock::now();
+            if (s != INVALID_SOCKET) {
+                closesocket(s);
+            }
+            if (is_ready) {
+                samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+        }
+        return samples;
+    }
+}
+
+void benchmark_reconnect_latency() {
+    BenchUtils::print_header("RECONNECT TO READY");
+
+    // The bench database and account when set, the demo user otherwise
+    std::string username = BenchUtils::get_env("AGENTIE_BENCH_LOGIN_USER", "demo");
+    std::string password = BenchUtils::get_env("AGENTIE_BENCH_LOGIN_PASSWORD", "demo123");
+    std::shared_ptr<Database::Database_Manager> db;
+    if (username != "demo") {
+        db = BenchUtils::connect_bench_database(Database::Pool_Config());
+    }
+    if (!db) {
+        db = std::make_shared<Database::Database_Manager>("dummy", "dummy", "", "");
+    }
+
+    SocketNetwork::Server_Config config("127.0.0.1", RECONNECT_BENCH_PORT);
+    config.enable_logging = false;
+    SocketNetwork::Socket_Server server(config);
+    server.set_database_manager(db);
+    if (!server.start()) {
+        std::cout << "  skipped: server did not start" << std::endl;
+        return;
+    }
+
+    nlohmann::json auth = { { "type", "AUTH" }, { "username", username }, { "password", password } };
+    std::string reply;
+    SOCKET s = open_client_connection(RECONNECT_BENCH_PORT, 0);
+    bool is_logged_in = s != INVALID_SOCKET && text_round_trip(s, auth.dump(), reply);
+    if (s != INVALID_SOCKET) {
+        closesocket(s);
+    }
+    std::string token;
+    if (is_logged_in) {
+        nlohmann::json response = nlohmann::json::parse(reply, nullptr, false);
+        if (response.is_object() && response.contains("data") && response["data"].contains("session_token")) {
+            token = response["data"]["session_token"].get<std::string>();
+        }
+    }
+    if (token.empty()) {
+        std::cout << "  skipped: login as '" << username << "' returned no session token" << std::endl;
+        server.stop();
+        return;
+    }
+
+    nlohmann::json resume = { { "type", "RESUME_SESSION" }, { "token", token } };
+    const std::pair<const char*, std::string> modes[] = {
+        { "AUTH", auth.dump() },
+        { "RESUME_SESSION", resume.dump() }
+    };
+
+    std::cout << RECONNECT_BENCH_SAMPLES << " reconnects as '" << username << "'" << std::endl;
+    std::cout << std::left << std::setw(18) << "first request" << std::setw(10) << "ready" << std::setw(10) << "p50 ms" << "p99 ms" << std::endl;
+    for (const auto& mode : modes) {
+        std::vector<double> samples = run_reconnects(RECONNECT_BENCH_PORT, mode.second);
+        std::cout << std::left << std::setw(18) << mode.first << std::setw(10) << samples.size()
+                  << std::fixed << std::setprecision(3) << std::setw(10) << BenchUtils::percentile(samples, 50)
+                  << BenchUtils::percentile(samples, 99) << std::endl;
+    }
+
+    server.stop();
+}
+
+// Main benchmark runner
+int main() {
+    std::cout << "Starting Agentie de Voiaj Server Benchmarks..." << std::endl;
+    std::cout << "=============================================" << std::endl;
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cerr << "WSAStartup failed" << std::endl;
+        return 1;
+    }
+
+    try {
+        benchmark_connection_scaling();
+        benchmark_connection_pool();
+        benchmark_booking_contention();
+        benchmark_login_throughput();
+        benchmark_reconnect_latency();
+        benchmark_bulk_fetch();
+        benchmark_offer_search();
+        benchmark_response_serialization();
+        benchmark_compressed_offers();
+        benchmark_logging_latency();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Benchmark failed with exception: " << e.what() << std::endl;
+        WSACleanup();
+        return 1;
+    }
+
+    WSACleanup();
+    return 0;
+}
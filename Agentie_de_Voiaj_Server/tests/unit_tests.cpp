@@ -5,12 +5,28 @@
 #include <cassert>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 // Include test headers
 #include "network/Protocol_Handler.h"
+#include "network/Response_Writer.h"
 #include "database/Database_Manager.h"
+#include "database/Seat_Counters.h"
+#include "database/Unknown_User_Cache.h"
 #include "network/Socket_Server.h"
 #include "network/Network_Types.h"
+#include "network/Frame_Codec.h"
+#include "network/Latency_Metrics.h"
+#include "network/Worker_Pool.h"
+#include "network/Client_Registry.h"
+#include "network/Client_Handler.h"
+#include "network/Offer_Notifier.h"
+#include "network/Session_Store.h"
+#include "network/Send_Queue.h"
+#include "network/Payload_Compressor.h"
+#include "utils/Async_Logger.h"
 #include "utils/Logger.h"
 
 // Test utilities
@@ -222,6 +238,109 @@ void test_database_manager() {
         auto result = mock_db->update_user_info(1, "phone", "+1234567890");
         return result.success;
     });
+    
+    // Test connection pool state without a connection
+    TestUtils::run_test("Connection Pool - Not Connected", [&]() {
+        Database::Database_Manager db("dummy", "dummy", "", "");
+        auto stats = db.get_pool_stats();
+        return stats.total_connections == 0 && !db.begin_transaction() && !db.commit_transaction();
+    });
+
+    // Test typed result set columns and the string compatibility accessors
+    TestUtils::run_test("Result Set - Typed Columns", [&]() {
+        Database::Result_Set rows;
+        size_t id = rows.add_column("ID", Database::Column_Type::INT);
+        size_t price = rows.add_column("Price_per_Person", Database::Column_Type::DOUBLE, 2);
+        size_t name = rows.add_column("Name", Database::Column_Type::STRING);
+
+        rows.append_int(id, 7);
+        rows.append_double(price, 299.99);
+        rows.append_string(name, "Paris", 5);
+        rows.end_row();
+        rows.append_int(id, 8);
+        rows.append_null(price);
+        rows.end_row();
+
+        return rows.size() == 2 && rows[0].get_int(id) == 7 && rows[0]["Price_per_Person"] == "299.99" &&
+               rows[0].get_string_view(name) == "Paris" && rows[1].is_null(price) && rows[1].is_null(name) &&
+               rows[1]["Name"].empty() && rows[1].to_map().size() == 3;
+    });
+
+    // Test the in-memory SEARCH_OFFERS indexes against the SQL predicates
+    TestUtils::run_test("Offer Index - Search Filters", [&]() {
+        auto make_offer = [](int id, double price, const std::string& departure, const std::string& return_date,
+                             const std::string& name, const std::string& country) {
+            Database::Indexed_Offer offer;
+            offer.offer_id = id;
+            offer.price = price;
+            offer.departure_date = departure;
+            offer.return_date = return_date;
+            offer.destination_name = name;
+            offer.country = country;
+            offer.row_json = std::make_shared<const std::string>("{\"Offer_ID\":\"" + std::to_string(id) + "\"}");
+            return offer;
+        };
+        Database::Offer_Index index({
+            make_offer(1, 450.0, "2026-07-10", "2026-07-17", "Paris", "Franta"),
+            make_offer(2, 899.0, "2026-06-01", "2026-06-08", "Roma", "Italia"),
+            make_offer(3, 1200.0, "2026-08-15", "2026-08-25", "Romantic Santorini", "Grecia"),
+            make_offer(4, 300.0, "2026-05-20", "2026-05-23", "Brasov", "Romania")
+        });
+
+        Database::Offer_Search_Criteria by_text;
+        by_text.destination = "ROM";
+        Database::Offer_Search_Criteria by_range;
+        by_range.min_price = 400.0;
+        by_range.max_price = 900.0;
+        by_range.start_date = "2026-06-01";
+        Database::Offer_Search_Criteria across_fields;
+        across_fields.destination = "orom"; // "Brasov" + "Romania" must not match as one string
+        Database::Offer_Search_Criteria with_wildcard;
+        with_wildcard.destination = "R%a";
+
+        size_t count = 0;
+        return index.search(by_text, &count) == "[{\"Offer_ID\":\"4\"},{\"Offer_ID\":\"2\"},{\"Offer_ID\":\"3\"}]" && count == 3 &&
+               index.search(by_range) == "[{\"Offer_ID\":\"2\"},{\"Offer_ID\":\"1\"}]" &&
+               index.search(across_fields) == "[]" &&
+               !Database::Offer_Index::can_answer(with_wildcard);
+    });
+
+    // Test conditional GET_OFFERS: versions only move with the rows, deltas carry changes and removals
+    TestUtils::run_test("Offer Catalog - Conditional Versions", [&]() {
+        auto make_snapshot = [](const std::vector<std::pair<int, std::string>>& rows) {
+            Database::Offer_Catalog_Snapshot snapshot;
+            snapshot.offers_json = "[";
+            for (const auto& row : rows) {
+                Database::Versioned_Offer offer;
+                offer.offer_id = row.first;
+                offer.row_json = std::make_shared<const std::string>("{\"Offer_ID\":\"" + row.second + "\"}");
+                snapshot.offers_json += (snapshot.offers.empty() ? "" : ",") + *offer.row_json;
+                snapshot.offers.push_back(offer);
+            }
+            snapshot.offers_json += "]";
+            return snapshot;
+        };
+
+        auto first = make_snapshot({ {1, "1"}, {2, "2"}, {3, "3"}, {4, "4"} });
+        Database::Offer_Catalog::carry_versions(nullptr, first);
+        auto same = make_snapshot({ {1, "1"}, {2, "2"}, {3, "3"}, {4, "4"} });
+        Database::Offer_Catalog::carry_versions(&first, same);
+        auto second = make_snapshot({ {1, "1"}, {2, "2b"}, {3, "3"} }); // 2 edited, 4 sold out
+        Database::Offer_Catalog::carry_versions(&same, second);
+
+        const std::string v1 = std::to_string(first.version);
+        const std::string v2 = std::to_string(second.version);
+        return same.version == first.version && second.version > first.version &&
+               Database::Offer_Catalog::build_changes_since(second, second.version) ==
+                   "{\"version\":" + v2 + ",\"not_modified\":true}" &&
+               Database::Offer_Catalog::build_changes_since(second, first.version) ==
+                   "{\"version\":" + v2 + ",\"changed\":[{\"Offer_ID\":\"2b\"}],\"removed\":[4]}" &&
+               // From an earlier run, or never fetched: the whole list
+               Database::Offer_Catalog::build_changes_since(second, 0) ==
+                   "{\"version\":" + v2 + ",\"offers\":" + second.offers_json + "}" &&
+               Database::Offer_Catalog::build_changes_since(first, first.version) ==
+                   "{\"version\":" + v1 + ",\"not_modified\":true}";
+    });
 }
 
 // Socket Server Tests
@@ -245,6 +364,20 @@ void test_socket_server() {
         return server != nullptr && !server->is_server_running();
     });
     
+    // Test reactor mode configuration
+    TestUtils::run_test("Server Creation - Reactor Mode", [&]() {
+        SocketNetwork::Server_Config config;
+        config.io_mode = SocketNetwork::Io_Mode::REACTOR;
+        config.io_thread_count = 2;
+        config.max_clients = Config::Server::MAX_REACTOR_CONNECTIONS;
+        
+        auto server = std::make_unique<SocketNetwork::Socket_Server>(config);
+        auto retrieved_config = server->get_config();
+        return !server->is_server_running() &&
+               retrieved_config.io_mode == SocketNetwork::Io_Mode::REACTOR &&
+               retrieved_config.io_thread_count == 2;
+    });
+    
     // Test server configuration
     TestUtils::run_test("Server Configuration", [&]() {
         auto server = std::make_unique<SocketNetwork::Socket_Server>();
@@ -303,6 +436,356 @@ void test_integration() {
         Response response = protocol_handler->process_message(request);
         return !response.success && !response.message.empty();
     });
+
+    // Test that a pre-serialized payload (offer catalog) produces the same bytes as a parsed one
+    TestUtils::run_test("Success Response - Pre-serialized Data", [&]() {
+        std::string offers = "[{\"Name\":\"Paris Weekend\",\"Offer_ID\":\"1\"}]";
+        return Utils::JSON::create_success_response(offers, "Data retrieved successfully", true) ==
+               Utils::JSON::create_success_response(offers, "Data retrieved successfully");
+    });
+
+    // Test request id correlation: read from the payload or the frame header, echoed in the response
+    TestUtils::run_test("Request ID - Parsed and Echoed", [&]() {
+        SocketNetwork::Protocol_Handler protocol_handler(nullptr);
+        bool parsed_ok = protocol_handler.parse_message("{\"type\":\"GET_OFFERS\",\"request_id\":7}").request_id == 7 &&
+                         protocol_handler.parse_message("{\"type\":\"GET_OFFERS\",\"request_id\":\"8\"}").request_id == 8 &&
+                         protocol_handler.parse_message("{\"type\":\"GET_OFFERS\"}").request_id == 0 &&
+                         protocol_handler.parse_message("{}", SocketNetwork::Message_Type::GET_OFFERS, 9).request_id == 9;
+
+        std::string offers = "[{\"Offer_ID\":\"1\"}]";
+        bool echoed_ok = Utils::JSON::create_success_response(offers, "OK", true, 7) ==
+                         Utils::JSON::create_success_response(offers, "OK", false, 7) &&
+                         nlohmann::json::parse(Utils::JSON::create_error_response("Failed", -1, 7))["request_id"] == 7;
+        return parsed_ok && echoed_ok;
+    });
+
+    // Test that the single-pass writer produces what the DOM path produced
+    TestUtils::run_test("Response Writer - Same Bytes as DOM", [&]() {
+        Database::Result_Set rows;
+        size_t id = rows.add_column("Offer_ID", Database::Column_Type::INT);
+        size_t name = rows.add_column("Name", Database::Column_Type::STRING);
+        size_t price = rows.add_column("Price_per_Person", Database::Column_Type::DOUBLE, 2);
+        for (int i = 1; i <= 3; i++) {
+            std::string offer_name = "Sejur \"" + std::to_string(i) + "\"\n\xC3\xA9";
+            rows.append_int(id, i);
+            rows.append_string(name, offer_name.data(), offer_name.size());
+            if (i == 2) rows.append_null(price); else rows.append_double(price, 99.5 * i);
+            rows.end_row();
+        }
+
+        nlohmann::json dom = nlohmann::json::array();
+        for (const auto& row : rows) {
+            nlohmann::json object = nlohmann::json::object();
+            for (size_t i = 0; i < row.column_count(); i++) object[row.column_name(i)] = row.get_string(i);
+            dom.push_back(object);
+        }
+
+        SocketNetwork::Response response(true, "Data retrieved successfully");
+        response.rows = std::make_shared<const Database::Result_Set>(rows);
+        response.request_id = 3;
+        SocketNetwork::Response_Writer writer;
+        std::string expected = Utils::JSON::create_success_response(dom.dump(), "Data retrieved successfully", false, 3) + "\r\n";
+        return writer.write(response, SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header()) == expected;
+    });
+
+    // Test message reassembly in both framing modes
+    TestUtils::run_test("Frame Decoder - Split and Packed Messages", [&]() {
+        SocketNetwork::Frame_Decoder decoder(1024);
+        SocketNetwork::Frame frame;
+        std::string lines = "{\"type\":\"KEEPALIVE\"}\r\n{\"type\":\"GET_OF";
+        decoder.append(lines.data(), lines.size());
+        bool text_ok = decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::FRAME &&
+                       frame.payload == "{\"type\":\"KEEPALIVE\"}" &&
+                       decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::NEED_MORE;
+        decoder.append("FERS\"}\r\n", 8);
+        text_ok = text_ok && decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::FRAME &&
+                  frame.payload == "{\"type\":\"GET_OFFERS\"}";
+
+        decoder.set_mode(SocketNetwork::Framing_Mode::BINARY);
+        SocketNetwork::Frame_Header header;
+        header.message_type = SocketNetwork::to_wire_type(SocketNetwork::Message_Type::GET_OFFERS);
+        header.request_id = 42;
+        std::string frames = SocketNetwork::encode_frame(SocketNetwork::Framing_Mode::BINARY, header, "{}") +
+                             SocketNetwork::encode_frame(SocketNetwork::Framing_Mode::BINARY, header, "{\"a\":\"1\"}");
+        decoder.append(frames.data(), 7);
+        bool binary_ok = decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::NEED_MORE;
+        decoder.append(frames.data() + 7, frames.size() - 7);
+        binary_ok = binary_ok && decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::FRAME && frame.payload == "{}" &&
+                    frame.header.request_id == 42 &&
+                    SocketNetwork::from_wire_type(frame.header.message_type) == SocketNetwork::Message_Type::GET_OFFERS &&
+                    decoder.next(frame) == SocketNetwork::Frame_Decoder::Result::FRAME && frame.payload == "{\"a\":\"1\"}" &&
+                    decoder.buffered() == 0;
+        return text_ok && binary_ok;
+    });
+
+    // Test that flush() waits for the writer and a full ring drops only low-level records
+    TestUtils::run_test("Async Logger - Flush and Drop Policy", [&]() {
+        Utils::Async_Logger::Options options;
+        options.directory = "test_logs/";
+        options.console_output = false;
+        options.capacity = 4;
+        options.flush_interval_ms = 1000;
+        Utils::Async_Logger logger(options);
+
+        for (int i = 0; i < 1000; i++) {
+            logger.log(Utils::Logger::Level::INFO, "record " + std::to_string(i));
+        }
+        bool warning_kept = logger.log(Utils::Logger::Level::WARNING, std::string(2000, 'x'));
+        logger.flush();
+
+        Utils::Async_Logger::Stats stats = logger.get_stats();
+        return warning_kept && stats.written + stats.dropped == 1001 && stats.written >= 4;
+    });
+
+    // Test histogram buckets and merged per-thread percentiles
+    TestUtils::run_test("Latency Metrics - Percentiles", [&]() {
+        bool buckets_ok = true;
+        for (uint64_t micros : { 0ULL, 1ULL, 63ULL, 64ULL, 1000ULL, 123456ULL, 1ULL << 31 }) {
+            size_t index = SocketNetwork::Latency_Histogram::bucket_index(micros);
+            uint64_t upper = SocketNetwork::Latency_Histogram::bucket_upper_bound(index);
+            buckets_ok = buckets_ok && upper >= micros && upper - micros <= micros / 32;
+        }
+
+        SocketNetwork::Latency_Metrics::reset();
+        std::thread other([]() {
+            for (int i = 1; i <= 500; i++) {
+                SocketNetwork::Latency_Metrics::record(Message_Type::KEEPALIVE, SocketNetwork::Latency_Phase::TOTAL, std::chrono::microseconds(i));
+            }
+        });
+        for (int i = 501; i <= 1000; i++) {
+            SocketNetwork::Latency_Metrics::record(Message_Type::KEEPALIVE, SocketNetwork::Latency_Phase::TOTAL, std::chrono::microseconds(i));
+        }
+        other.join();
+
+        auto snapshot = SocketNetwork::Latency_Metrics::snapshot();
+        const auto& total = snapshot.at(Message_Type::KEEPALIVE, SocketNetwork::Latency_Phase::TOTAL);
+        uint64_t p50 = total.percentile(50.0);
+        uint64_t p99 = total.percentile(99.0);
+        return buckets_ok && total.count() == 1000 && total.peak() == 1000 &&
+               p50 >= 500 && p50 <= 516 && p99 >= 990 && p99 <= 1000 &&
+               snapshot.average_response_time_ms() > 0.49 && snapshot.average_response_time_ms() < 0.51;
+    });
+
+    // Test that the worker queue serves higher priorities first and refuses work when full
+    TestUtils::run_test("Worker Pool - Priority and Backpressure", [&]() {
+        SocketNetwork::Worker_Pool::Options options;
+        options.thread_count = 1;
+        options.capacity = 4;
+        options.high_priority_reserve = 1;
+        SocketNetwork::Worker_Pool pool(options);
+        pool.start();
+
+        // Hold the only worker so the next tasks queue up behind it
+        std::mutex mutex;
+        std::condition_variable released;
+        bool is_released = false;
+        std::vector<int> order;
+        pool.try_submit(SocketNetwork::Request_Priority::LOW, [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&]() { return is_released; });
+        });
+        while (pool.get_stats().queued > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        auto record = [&](int value) { return [&, value]() { std::lock_guard<std::mutex> lock(mutex); order.push_back(value); }; };
+        bool queued_ok = pool.try_submit(SocketNetwork::Request_Priority::LOW, record(3)) &&
+                         pool.try_submit(SocketNetwork::Request_Priority::NORMAL, record(2)) &&
+                         pool.try_submit(SocketNetwork::Request_Priority::LOW, record(4));
+        bool low_refused = !pool.try_submit(SocketNetwork::Request_Priority::LOW, record(5));
+        bool high_reserved = pool.try_submit(SocketNetwork::Request_Priority::HIGH, record(1));
+        bool high_refused = !pool.try_submit(SocketNetwork::Request_Priority::HIGH, record(6));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_released = true;
+        }
+        released.notify_all();
+        while (pool.get_stats().queued > 0 || pool.get_stats().completed < 5) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        pool.stop();
+
+        return queued_ok && low_refused && high_reserved && high_refused &&
+               order == std::vector<int>({ 1, 2, 3, 4 }) && pool.get_stats().rejected == 2;
+    });
+
+    // Test that every connection of a user is found and that removed ones drop out of the index
+    TestUtils::run_test("Client Registry - User Index", [&]() {
+        SocketNetwork::Client_Registry registry(4);
+        auto make_client = [](int user_id) {
+            SocketNetwork::Client_Info info(INVALID_SOCKET, "127.0.0.1", 0);
+            auto client = std::make_shared<SocketNetwork::Client_Handler>(INVALID_SOCKET, info, nullptr, nullptr, nullptr);
+            client->set_authenticated(user_id, "user");
+            return client;
+        };
+
+        registry.add(4, make_client(7));
+        registry.add(8, make_client(7));
+        registry.add(12, make_client(9));
+        registry.bind_user(4, 7, 0);
+        registry.bind_user(8, 7, 0);
+        registry.bind_user(12, 9, 0);
+        bool both_found = registry.find_by_user(7).size() == 2 && registry.find_by_user(9).size() == 1;
+
+        bool removed = registry.remove(8) != nullptr && registry.remove(8) == nullptr;
+        bool one_left = registry.find_by_user(7).size() == 1 && registry.size() == 2;
+
+        registry.remove_if([](const SocketNetwork::Client_Registry::Client_Ptr&) { return true; });
+        return both_found && removed && one_left && registry.size() == 0 && registry.find_by_user(9).empty();
+    });
+
+    // Test that a burst of changes to the same offers goes out as one push with one entry per offer
+    TestUtils::run_test("Offer Notifier - Coalesced Push", [&]() {
+        SocketNetwork::Socket_Server server;
+        auto db = std::make_shared<Database::Database_Manager>();
+        SocketNetwork::Offer_Notifier notifier(&server, db, std::chrono::milliseconds(50));
+        notifier.start();
+
+        // Deletions need no seat query, so this runs without a database
+        for (int i = 0; i < 3; i++) {
+            db->notify_offer_changed(5, Database::Offer_Change::DELETED);
+        }
+        db->notify_offer_changed(6, Database::Offer_Change::DELETED);
+        for (int i = 0; i < 100 && notifier.get_stats().pushes == 0; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        notifier.stop();
+
+        auto stats = notifier.get_stats();
+        std::string message = SocketNetwork::Offer_Notifier::build_update_message({ { 5, 0, "deleted" } });
+        return stats.changes == 4 && stats.pushes == 1 && stats.offers_pushed == 2 &&
+               message == R"({"data":[{"available_seats":0,"offer_id":5,"status":"deleted"}],"type":"OFFER_UPDATE"})";
+    });
+
+    // Test that a broadcast payload is queued by reference and small messages share one segment
+    TestUtils::run_test("Send Queue - Shared Payloads and Framing Bytes", [&]() {
+        SocketNetwork::Send_Queue queue;
+        auto large = std::make_shared<const std::string>(Config::Server::SEND_COALESCE_BYTES + 1, 'x');
+        auto small = std::make_shared<const std::string>("{}");
+
+        queue.push_frame(SocketNetwork::Framing_Mode::BINARY, SocketNetwork::Frame_Header(), large);
+        queue.push_frame(SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header(), small);
+        queue.push_frame(SocketNetwork::Framing_Mode::TEXT_LINES, SocketNetwork::Frame_Header(), small);
+        bool is_shared = large.use_count() == 2 && small.use_count() == 1;
+        size_t expected = SocketNetwork::FRAME_HEADER_SIZE + large->size() + 2 * (small->size() + 2);
+
+        // Nothing is dropped when the socket fails, the connection is closed instead
+        bool is_kept = queue.flush(INVALID_SOCKET) == SocketNetwork::Send_Queue::Flush_Result::FAILED &&
+                       queue.size() == expected;
+        queue.clear();
+        return is_shared && is_kept && queue.empty() && large.use_count() == 1;
+    });
+
+    // Test response compression: small payloads stay plain, a 20-offer reply round-trips and the dictionary helps it
+    TestUtils::run_test("Payload Compressor - Round Trip With Dictionary", [&]() {
+        std::string offers = "[";
+        for (int i = 1; i <= 20; i++) {
+            offers += (i > 1 ? "," : "") + std::string("{\"Offer_ID\":\"") + std::to_string(i) +
+                      "\",\"Name\":\"Offer " + std::to_string(i) + "\",\"Available_Seats\":\"" + std::to_string(i % 40) + "\"}";
+        }
+        offers += "]";
+
+        SocketNetwork::Payload_Compressor plain(false);
+        SocketNetwork::Payload_Compressor primed(true);
+        bool is_small_skipped = plain.compress("{\"success\":true}", 16) == nullptr;
+
+        std::string packed_plain = *plain.compress(offers.data(), offers.size());
+        std::string packed_primed = *primed.compress(offers.data(), offers.size());
+        std::string inflated_plain;
+        std::string inflated_primed;
+        std::string rejected;
+        return is_small_skipped && packed_plain.size() < offers.size() && packed_primed.size() < packed_plain.size() &&
+               SocketNetwork::Payload_Compressor::decompress(packed_plain.data(), packed_plain.size(), false, offers.size(), inflated_plain) &&
+               SocketNetwork::Payload_Compressor::decompress(packed_primed.data(), packed_primed.size(), true, offers.size(), inflated_primed) &&
+               inflated_plain == offers && inflated_primed == offers &&
+               // A frame that would inflate past the limit is refused
+               !SocketNetwork::Payload_Compressor::decompress(packed_plain.data(), packed_plain.size(), false, offers.size() - 1, rejected);
+    });
+
+    TestUtils::run_test("Book Offer - Traveler List Checked Before Database", [&]() {
+        Database::Database_Manager db;
+        Reservation_Person_Data person;
+        person.full_name = "Ana Popescu";
+        person.cnp = "2900101123456";
+        person.birth_date = "1990-01-01";
+        person.person_type = "adult";
+
+        // Both are rejected before a connection is needed
+        auto mismatch = db.book_offer(1, 1, 2, { person });
+        auto invalid = db.book_offer(1, 1, 0);
+        return mismatch.type == Database::Result_Type::ERROR_CONSTRAINT &&
+               invalid.type == Database::Result_Type::ERROR_CONSTRAINT;
+    });
+
+    TestUtils::run_test("Seat Counters - Concurrent Holds Never Oversell", [&]() {
+        Database::Seat_Counters counters(nullptr);
+        counters.set_available(7, 100);
+
+        std::atomic<int> held(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; t++) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 50; i++) {
+                    if (counters.try_hold(7, 1) == Database::Seat_Hold::HELD) {
+                        held++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        bool is_sold_out = counters.try_hold(7, 1) == Database::Seat_Hold::SOLD_OUT;
+        counters.release(7, 2);
+        bool is_released = counters.try_hold(7, 2) == Database::Seat_Hold::HELD;
+        return held == 100 && is_sold_out && is_released &&
+               counters.try_hold(8, 1) == Database::Seat_Hold::UNKNOWN;
+    });
+
+    TestUtils::run_test("Credentials - Digest and Unknown User Cache", [&]() {
+        // SHA-256("abc"), the salt is hashed right after the password
+        const std::string expected = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+        bool is_digest_ok = Utils::Crypto::hash_password("ab", "c") == expected &&
+                            Utils::Crypto::verify_password("ab", expected, "c") &&
+                            !Utils::Crypto::verify_password("ab", expected, "d") &&
+                            !Utils::Crypto::constant_time_equals(expected, expected.substr(1));
+
+        Database::Unknown_User_Cache cache(std::chrono::milliseconds(50), 4);
+        cache.add("Mallory");
+        bool is_cached = cache.contains("mallory");
+        cache.remove("MALLORY");
+        bool is_removed = !cache.contains("mallory");
+        cache.add("eve");
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        return is_digest_ok && is_cached && is_removed && !cache.contains("eve");
+    });
+
+    TestUtils::run_test("Session Store - Resume and Expiry", [&]() {
+        SocketNetwork::Session_Store store(std::chrono::milliseconds(50), 4);
+        std::string token = store.create(7, "demo");
+        SocketNetwork::Session session;
+        bool is_resumed = token.size() == 64 && store.resume(token, session) &&
+                          session.user_id == 7 && session.username == "demo";
+        bool is_unknown_refused = !store.resume(token + "0", session) && !store.resume("", session);
+
+        std::string revoked = store.create(8, "other");
+        store.revoke(revoked);
+        bool is_revoked = !store.resume(revoked, session) && store.size() == 1;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        return is_resumed && is_unknown_refused && is_revoked && !store.resume(token, session) && store.size() == 0;
+    });
+
+    // Resumes slide the expiry, but never past the maximum lifetime counted from the login
+    TestUtils::run_test("Session Store - Lifetime Caps Resumes", [&]() {
+        SocketNetwork::Session_Store store(std::chrono::milliseconds(60), 4, std::chrono::milliseconds(100));
+        std::string token = store.create(7, "demo");
+        SocketNetwork::Session session;
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        bool is_first_resumed = store.resume(token, session);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        bool is_second_resumed = store.resume(token, session);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40)); // Within the TTL, past the lifetime
+        return is_first_resumed && is_second_resumed && !store.resume(token, session) && store.size() == 0;
+    });
 }
 
 // Performance Tests
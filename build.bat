@@ -43,6 +43,10 @@ msbuild unit_tests.cpp /Fe:unit_tests.exe /std:c++17
 if %errorlevel% neq 0 (
     echo WARNING: Server tests build failed (continuing...)
 )
+msbuild benchmarks.cpp /Fe:benchmarks.exe /std:c++17
+if %errorlevel% neq 0 (
+    echo WARNING: Server benchmarks build failed (continuing...)
+)
 
 cd "..\..\Agentie_de_Voiaj_Client\tests"
 msbuild client_tests.cpp /Fe:client_tests.exe /std:c++17
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Raw content dictionary for zstd, shared by the server (Payload_Compressor) and the client
+// (Payload_Decompressor); both projects have common/include on their include path. zstd
+// matches against it as if it preceded every payload, the most frequent text goes last. A raw
+// dictionary puts no ID in the frame, so NAME is derived from the content: HELLO only agrees
+// on the dictionary when both builds hold the same text.
+namespace Offer_Dictionary
+{
+	inline constexpr char TEXT[] =
+	"{\"type\":\"OFFER_UPDATE\",\"data\":[{\"available_seats\":0,\"offer_id\":0,\"status\":\"active\"}]}{\"data\":{\"v"
+	"ersion\":0,\"not_modified\":true},\"message\":\"Data retrieved successfully\",\"request_id\":0,\"success\":"
+	"true}\"changed\":[],\"removed\":[]All meals, Spa access, Private tours, Transfers, Train tickets, Lo"
+	"cal guide, Metro pass, Theater tickets, Ferry crossing, Shopping tour, Luxury experience with pr"
+	"emium accommodation, Romania Grecia Spania Marea Britanie Avion Tren Autocar Hotel Apartament Re"
+	"sort deleted inactive {\"data\":{\"version\":0,\"offers\":[{\"Accommodation_ID\":\"3\",\"Accommodation_Name"
+	"\":\"Generator Paris\",\"Country\":\"Franta\",\"Date_Created\":\"2025-08-01 10:15:30.123\",\"Date_Modified\":"
+	"\"2025-08-01 10:15:30.123\",\"Departure_Date\":\"2025-09-20\",\"Description\":\"Affordable Paris discover"
+	"y for young travelers\",\"Destination_ID\":\"1\",\"Destination_Name\":\"Paris\",\"Duration_Days\":\"5\",\"Incl"
+	"uded_Services\":\"Bus transfer, Walking tours, Hostel breakfast\",\"Name\":\"Paris Budget Adventure\",\""
+	"Offer_ID\":\"3\",\"Price_per_Person\":\"350.00\",\"Reserved_Seats\":\"8\",\"Return_Date\":\"2025-09-24\",\"Statu"
+	"s\":\"active\",\"Total_Seats\":\"35\",\"Transport_Name\":\"Autocar\",\"Types_of_Transport_ID\":\"3\"},{\"Accommo"
+	"dation_ID\":\"7\",\"Accommodation_Name\":\"Hotel Artemide\",\"Country\":\"Italia\",\"Date_Created\":\"2025-08-"
+	"01 10:15:30.123\",\"Date_Modified\":\"2025-08-14 18:02:11.457\",\"Departure_Date\":\"2025-10-15\",\"Descri"
+	"ption\":\"Essential Rome experience with central accommodation\",\"Destination_ID\":\"2\",\"Destination_"
+	"Name\":\"Roma\",\"Duration_Days\":\"4\",\"Included_Services\":\"Breakfast, City tour, Airport transfer\",\"N"
+	"ame\":\"Rome Classic\",\"Offer_ID\":\"12\",\"Price_per_Person\":\"890.00\",\"Reserved_Seats\":\"7\",\"Return_Dat"
+	"e\":\"2025-10-19\",\"Status\":\"active\",\"Total_Seats\":\"30\",\"Transport_Name\":\"Avion\",\"Types_of_Transpor"
+	"t_ID\":\"1\"}]},\"message\":\"Data retrieved successfully\",\"request_id\":0,\"success\":true}";
+	inline constexpr size_t SIZE = sizeof(TEXT) - 1;
+
+	// FNV-1a over the text
+	constexpr uint32_t content_hash()
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < SIZE; i++)
+		{
+			hash = (hash ^ static_cast<unsigned char>(TEXT[i])) * 16777619u;
+		}
+		return hash;
+	}
+
+	struct Name
+	{
+		char text[16];
+	};
+
+	// "offers-" and the hash in hex
+	constexpr Name make_name()
+	{
+		Name name{};
+		const char prefix[] = "offers-";
+		const char digits[] = "0123456789abcdef";
+		uint32_t hash = content_hash();
+		for (size_t i = 0; i < 7; i++)
+		{
+			name.text[i] = prefix[i];
+		}
+		for (size_t i = 0; i < 8; i++)
+		{
+			name.text[7 + i] = digits[(hash >> (28 - 4 * i)) & 0xF];
+		}
+		return name;
+	}
+
+	inline constexpr Name NAME = make_name();
+}